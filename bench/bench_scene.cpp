@@ -0,0 +1,1047 @@
+// Scene benchmark suite.
+//
+// Times the editor's hot paths on synthetic scenes of 1k, 100k, 1M and 10M
+// elements: bulk insertion, erase-from-middle removal, selection, CPU
+// picking, point level-of-detail selection, half-edge mesh construction
+// and traversal, scene file save and load, point cloud import, and (with
+// --gl) render submission. Everything except the render
+// benchmarks runs without a GL context.
+//
+// Results are printed as a table and can be written as JSON in the same
+// layout as Google Benchmark (--json <file>), so existing comparison
+// tooling can track regressions.
+
+#include "Scene.h"
+#include "HalfEdgeMesh.h"
+#include "SceneFile.h"
+#include "SceneImporter.h"
+#include "AsyncImporter.h"
+#include "Camera.h"
+#include "PointPicker.h"
+#include "LineBVH.h"
+#include "PickRay.h"
+#include "MeshCache.h"
+#include "PointLod.h"
+#include "UploadRing.h"
+#include "Log.h"
+#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float SceneHalfExtent = 5.0f;
+constexpr int ViewportWidth = 1000;
+constexpr int ViewportHeight = 800;
+
+struct BenchOptions {
+    size_t maxSize = 10000000;
+    std::string jsonPath;
+    std::string filter;
+    bool gl = false;
+    int repetitions = 3;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t operations;
+    double seconds;
+    double nsPerOperation;
+};
+
+// Quoted JSON string: quotes, backslashes and control characters escaped,
+// so paths and names from the command line cannot break the output
+std::string JsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+            quoted += escape;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options) : m_options(options) {}
+
+    bool Enabled(const std::string& name) const {
+        return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+    }
+
+    // Runs setup() untimed and body() timed, keeping the fastest repetition.
+    // body() performs `operations` operations; results are per operation.
+    void Run(const std::string& name, uint64_t operations,
+             const std::function<void()>& setup, const std::function<void()>& body,
+             int repetitions = 0) {
+        if (!Enabled(name) || operations == 0) {
+            return;
+        }
+        if (repetitions <= 0) {
+            repetitions = m_options.repetitions;
+        }
+
+        double best = 0.0;
+        for (int repetition = 0; repetition < repetitions; ++repetition) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (repetition == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+
+        BenchResult result{name, operations, best, best * 1e9 / operations};
+        std::printf("%-36s %12llu ops %14.1f ns/op %12.3f ms\n", name.c_str(),
+                    static_cast<unsigned long long>(operations), result.nsPerOperation, best * 1e3);
+        std::fflush(stdout);
+        m_results.push_back(result);
+    }
+
+    bool WriteJson(const std::string& path, const char* executable) const {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Failed to open %s\n", path.c_str());
+            return false;
+        }
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        std::fprintf(file, "{\n  \"context\": {\n");
+        std::fprintf(file, "    \"date\": \"%s\",\n", date);
+        std::fprintf(file, "    \"executable\": %s,\n", JsonString(executable).c_str());
+        std::fprintf(file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+        std::fprintf(file, "    \"library_build_type\": \"release\",\n");
+#else
+        std::fprintf(file, "    \"library_build_type\": \"debug\",\n");
+#endif
+        std::fprintf(file, "    \"max_size\": %zu\n  },\n", m_options.maxSize);
+        std::fprintf(file, "  \"benchmarks\": [\n");
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const BenchResult& result = m_results[i];
+            std::string name = JsonString(result.name);
+            std::fprintf(file,
+                         "    {\"name\": %s, \"run_name\": %s, \"run_type\": \"iteration\", "
+                         "\"iterations\": %llu, \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\", "
+                         "\"items_per_second\": %.1f}%s\n",
+                         name.c_str(), name.c_str(), static_cast<unsigned long long>(result.operations),
+                         result.nsPerOperation, result.nsPerOperation, result.operations / result.seconds,
+                         i + 1 < m_results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+private:
+    BenchOptions m_options;
+    std::vector<BenchResult> m_results;
+};
+
+std::string SizeLabel(size_t size) {
+    if (size >= 1000000 && size % 1000000 == 0) return std::to_string(size / 1000000) + "M";
+    if (size >= 1000 && size % 1000 == 0) return std::to_string(size / 1000) + "k";
+    return std::to_string(size);
+}
+
+std::vector<glm::vec3> RandomPositions(size_t count, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> coordinate(-SceneHalfExtent, SceneHalfExtent);
+    std::vector<glm::vec3> positions(count);
+    for (glm::vec3& p : positions) {
+        p = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+    }
+    return positions;
+}
+
+// Line endpoints in LineStore layout: start at 2i, end at 2i + 1
+std::vector<glm::vec3> RandomSegments(size_t count, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> coordinate(-SceneHalfExtent, SceneHalfExtent);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    std::vector<glm::vec3> vertices(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 start(coordinate(random), coordinate(random), coordinate(random));
+        vertices[i * 2] = start;
+        vertices[i * 2 + 1] = start + glm::vec3(offset(random), offset(random), offset(random));
+    }
+    return vertices;
+}
+
+// Cursor positions for picking: half aimed at projected elements (hits),
+// half uniformly over the viewport (mostly misses)
+std::vector<glm::vec2> PickCursors(const std::vector<glm::vec3>& targets, const glm::mat4& viewProjection,
+                                   size_t count, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> target(0, targets.size() - 1);
+    std::uniform_real_distribution<float> screenX(0.0f, static_cast<float>(ViewportWidth));
+    std::uniform_real_distribution<float> screenY(0.0f, static_cast<float>(ViewportHeight));
+    std::vector<glm::vec2> cursors;
+    cursors.reserve(count);
+    while (cursors.size() < count) {
+        if (cursors.size() % 2 == 0) {
+            glm::vec4 clip = viewProjection * glm::vec4(targets[target(random)], 1.0f);
+            if (clip.w > 0.0f) {
+                cursors.emplace_back((clip.x / clip.w * 0.5f + 0.5f) * ViewportWidth,
+                                     (0.5f - clip.y / clip.w * 0.5f) * ViewportHeight);
+                continue;
+            }
+        }
+        cursors.emplace_back(screenX(random), screenY(random));
+    }
+    return cursors;
+}
+
+Camera BenchCamera() {
+    Camera camera;
+    camera.SetAspectRatio(static_cast<float>(ViewportWidth) / ViewportHeight);
+    camera.LookAt(glm::vec3(9.0f, 6.0f, 12.0f), glm::vec3(0.0f));
+    return camera;
+}
+
+// Cameras on one orbit around the origin at the given height; height 0
+// puts every camera in the y = 0 plane
+std::vector<Camera> OrbitCameras(size_t count, float height) {
+    std::vector<Camera> cameras;
+    for (size_t i = 0; i < count; ++i) {
+        float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(count);
+        Camera camera;
+        camera.SetAspectRatio(static_cast<float>(ViewportWidth) / ViewportHeight);
+        camera.LookAt(glm::vec3(15.0f * std::cos(angle), height, 15.0f * std::sin(angle)), glm::vec3(0.0f));
+        cameras.push_back(camera);
+    }
+    return cameras;
+}
+
+// Points flattened onto the y = 0 plane (a scanned floor, a 2D drawing)
+std::vector<glm::vec3> Flatten(std::vector<glm::vec3> positions) {
+    for (glm::vec3& position : positions) {
+        position.y = 0.0f;
+    }
+    return positions;
+}
+
+// Lines join points, so segment endpoints are added as points first; line i
+// joins ids[2i] and ids[2i + 1]
+std::vector<PointId> AddSegmentPoints(Scene& scene, const std::vector<glm::vec3>& segments, size_t lineCount) {
+    std::vector<PointId> ids;
+    scene.AddPoints(segments.data(), lineCount * 2, &ids);
+    return ids;
+}
+
+// Regular grid of side x side quads split into two triangles each, about
+// triangleCount triangles in all
+void GridMesh(size_t triangleCount, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    uint32_t side = std::max(1u, static_cast<uint32_t>(std::sqrt(triangleCount / 2.0)));
+    uint32_t stride = side + 1;
+    positions.resize(static_cast<size_t>(stride) * stride);
+    for (uint32_t row = 0; row < stride; ++row) {
+        for (uint32_t column = 0; column < stride; ++column) {
+            positions[row * stride + column] = glm::vec3(column, 0.0f, row);
+        }
+    }
+    indices.clear();
+    indices.reserve(static_cast<size_t>(side) * side * 6);
+    for (uint32_t row = 0; row < side; ++row) {
+        for (uint32_t column = 0; column < side; ++column) {
+            uint32_t corner = row * stride + column;
+            for (uint32_t index : {corner, corner + stride, corner + 1, corner + 1, corner + stride, corner + stride + 1}) {
+                indices.push_back(index);
+            }
+        }
+    }
+}
+
+void BenchInsertion(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions,
+                    const std::vector<glm::vec3>& segments) {
+    std::string label = SizeLabel(size);
+    std::unique_ptr<Scene> scene;
+
+    runner.Run("Scene/AddPoint/" + label, size,
+               [&] { scene = std::make_unique<Scene>(); },
+               [&] {
+                   for (size_t i = 0; i < size; ++i) {
+                       scene->AddPoint(positions[i]);
+                   }
+               });
+
+    std::vector<PointId> endpoints;
+    runner.Run("Scene/AddLine/" + label, size,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   endpoints = AddSegmentPoints(*scene, segments, size);
+               },
+               [&] {
+                   for (size_t i = 0; i < size; ++i) {
+                       scene->AddLine(endpoints[i * 2], endpoints[i * 2 + 1]);
+                   }
+               });
+
+    // Bulk variants, handles collected as an importer would
+    std::vector<PointId> pointIds;
+    runner.Run("Scene/AddPoints/" + label, size,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   pointIds.clear();
+               },
+               [&] { scene->AddPoints(positions.data(), size, &pointIds); });
+
+    std::vector<LineId> lineIds;
+    runner.Run("Scene/AddLines/" + label, size,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   endpoints = AddSegmentPoints(*scene, segments, size);
+                   lineIds.clear();
+               },
+               [&] { scene->AddLines(endpoints.data(), size, &lineIds); });
+}
+
+void BenchRemoval(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions,
+                  const std::vector<glm::vec3>& segments) {
+    std::string label = SizeLabel(size);
+    std::unique_ptr<Scene> scene;
+    size_t removals = std::min<size_t>(size / 2, 1000);
+
+    // Always erase from the middle: the worst case for order-preserving removal
+    runner.Run("Scene/RemovePoint/" + label, removals,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   for (size_t i = 0; i < size; ++i) {
+                       scene->AddPoint(positions[i]);
+                   }
+               },
+               [&] {
+                   for (size_t i = 0; i < removals; ++i) {
+                       scene->RemovePoint(static_cast<int>(scene->GetPoints().Size() / 2));
+                   }
+               });
+
+    runner.Run("Scene/RemoveLine/" + label, removals,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   std::vector<PointId> endpoints = AddSegmentPoints(*scene, segments, size);
+                   for (size_t i = 0; i < size; ++i) {
+                       scene->AddLine(endpoints[i * 2], endpoints[i * 2 + 1]);
+                   }
+               },
+               [&] {
+                   for (size_t i = 0; i < removals; ++i) {
+                       scene->RemoveLine(static_cast<int>(scene->GetLines().Size() / 2));
+                   }
+               });
+
+    // Deleting every point through handles in random order, one at a time
+    // and as a single batch
+    std::vector<PointId> ids;
+    runner.Run("Scene/RemoveAllPoints/" + label, size,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   ids.clear();
+                   ids.reserve(size);
+                   for (size_t i = 0; i < size; ++i) {
+                       ids.push_back(scene->AddPoint(positions[i]));
+                   }
+                   std::shuffle(ids.begin(), ids.end(), std::mt19937(size));
+               },
+               [&] {
+                   for (PointId id : ids) {
+                       scene->RemovePoint(id);
+                   }
+               });
+
+    runner.Run("Scene/RemovePoints/" + label, size,
+               [&] {
+                   scene = std::make_unique<Scene>();
+                   ids.clear();
+                   ids.reserve(size);
+                   for (size_t i = 0; i < size; ++i) {
+                       ids.push_back(scene->AddPoint(positions[i]));
+                   }
+                   std::shuffle(ids.begin(), ids.end(), std::mt19937(size));
+               },
+               [&] { scene->RemovePoints(ids); });
+}
+
+void BenchSelection(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions) {
+    std::string label = SizeLabel(size);
+    if (!runner.Enabled("Scene/SelectPoint/" + label) && !runner.Enabled("Scene/DeselectAll/" + label) &&
+        !runner.Enabled("Scene/IteratePositions/" + label) && !runner.Enabled("Scene/IterateSelected/" + label)) {
+        return;
+    }
+
+    Scene scene;
+    for (size_t i = 0; i < size; ++i) {
+        scene.AddPoint(positions[i]);
+    }
+
+    const size_t operations = 1000;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> index(0, static_cast<int>(size) - 1);
+    std::vector<int> indices(operations);
+    for (int& i : indices) {
+        i = index(random);
+    }
+
+    runner.Run("Scene/SelectPoint/" + label, operations, [] {},
+               [&] {
+                   for (int i : indices) {
+                       scene.SelectPoint(i);
+                   }
+               });
+
+    runner.Run("Scene/DeselectAll/" + label, operations, [] {},
+               [&] {
+                   for (size_t i = 0; i < operations; ++i) {
+                       scene.SelectPoint(indices[i]);
+                       scene.DeselectAll();
+                   }
+               });
+
+    // Whole-store sweeps: positions are one contiguous array, selection a
+    // bitset walked a word at a time. Every 100th point is selected.
+    PointStore store;
+    store.Add(positions.data(), size);
+    for (size_t i = 0; i < size; i += 100) {
+        store.SetSelected(i, true);
+    }
+
+    volatile float positionSink = 0.0f;
+    runner.Run("Scene/IteratePositions/" + label, size, [] {},
+               [&] {
+                   glm::vec3 sum(0.0f);
+                   for (const glm::vec3& position : store.GetPositions()) {
+                       sum = sum + position;
+                   }
+                   positionSink = sum.x + sum.y + sum.z;
+               });
+
+    // Per selected point; the empty words in between are part of the cost
+    volatile size_t selectedSink = 0;
+    runner.Run("Scene/IterateSelected/" + label, (size + 99) / 100, [] {},
+               [&] {
+                   size_t sum = 0;
+                   store.ForEachSelected([&](size_t index) { sum += index; });
+                   selectedSink = sum;
+               });
+}
+
+void BenchPicking(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions,
+                  const std::vector<glm::vec3>& segments) {
+    std::string label = SizeLabel(size);
+    Camera camera = BenchCamera();
+    glm::mat4 view = camera.GetViewMatrix();
+    glm::mat4 projection = camera.GetProjectionMatrix();
+    glm::vec2 viewport(static_cast<float>(ViewportWidth), static_cast<float>(ViewportHeight));
+    const size_t picks = 1000;
+
+    // The stores hold exactly the first `size` elements of the shared arrays
+    std::vector<glm::vec3> points(positions.begin(), positions.begin() + size);
+    std::vector<glm::vec3> vertices(segments.begin(), segments.begin() + size * 2);
+    std::vector<uint32_t> indices(size * 2);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint32_t>(i);
+    }
+
+    PointPicker pointPicker;
+    runner.Run("Pick/PointBuild/" + label, size, [] {}, [&] { pointPicker.Build(points); });
+    if (runner.Enabled("Pick/Point/" + label)) {
+        pointPicker.Build(points);
+        std::vector<glm::vec2> cursors = PickCursors(points, projection * view, picks, 11);
+        volatile int sink = 0;
+        runner.Run("Pick/Point/" + label, picks, [] {},
+                   [&] {
+                       for (const glm::vec2& cursor : cursors) {
+                           sink = pointPicker.Pick(points, view, projection, cursor, viewport, 6.0f, MeshCache::SphereRadius);
+                       }
+                   });
+    }
+
+    LineBVH lineBVH;
+    runner.Run("Pick/LineBuild/" + label, size, [] {}, [&] { lineBVH.Build(vertices, indices); }, size >= 1000000 ? 1 : 0);
+    if (runner.Enabled("Pick/Line/" + label)) {
+        if (lineBVH.GetNodeCount() == 0) {
+            lineBVH.Build(vertices, indices);
+        }
+        std::vector<glm::vec2> cursors = PickCursors(vertices, projection * view, picks, 13);
+        volatile int sink = 0;
+        runner.Run("Pick/Line/" + label, picks, [] {},
+                   [&] {
+                       for (const glm::vec2& cursor : cursors) {
+                           PickRay ray;
+                           if (PickRay::FromScreen(view, projection, cursor, viewport, ray)) {
+                               sink = lineBVH.Pick(vertices, indices, ray, 5.0f);
+                           }
+                       }
+                   });
+    }
+
+    // Each op edits one point or line and then picks, as dragging or
+    // deleting under the cursor does; the picker or BVH is patched rather
+    // than rebuilt, and only rebuilt when NeedsRebuild() says so, as Scene
+    // does
+    const size_t edits = std::min<size_t>(size / 2, picks);
+    std::vector<glm::vec3> edited;
+    std::vector<glm::vec2> editCursors = PickCursors(points, projection * view, edits, 17);
+    std::mt19937 editRandom(static_cast<unsigned int>(size));
+    volatile int editSink = 0;
+    runner.Run("Pick/PointAfterRemove/" + label, edits,
+               [&] {
+                   edited = points;
+                   pointPicker.Build(edited);
+               },
+               [&] {
+                   for (size_t i = 0; i < edits; ++i) {
+                       uint32_t index = static_cast<uint32_t>(editRandom() % edited.size());
+                       edited[index] = edited.back();
+                       edited.pop_back();
+                       pointPicker.PointRemoved(index, edited.size());
+                       if (pointPicker.NeedsRebuild(edited.size())) {
+                           pointPicker.Build(edited);
+                       }
+                       editSink = pointPicker.Pick(edited, view, projection, editCursors[i], viewport, 6.0f,
+                                                   MeshCache::SphereRadius);
+                   }
+               },
+               size >= 1000000 ? 1 : 0);
+    runner.Run("Pick/PointAfterMove/" + label, edits,
+               [&] {
+                   edited = points;
+                   pointPicker.Build(edited);
+               },
+               [&] {
+                   for (size_t i = 0; i < edits; ++i) {
+                       uint32_t index = static_cast<uint32_t>(editRandom() % edited.size());
+                       edited[index] += glm::vec3(0.0f, 0.1f, 0.0f);
+                       pointPicker.PointMoved(index);
+                       if (pointPicker.NeedsRebuild(edited.size())) {
+                           pointPicker.Build(edited);
+                       }
+                       editSink = pointPicker.Pick(edited, view, projection, editCursors[i], viewport, 6.0f,
+                                                   MeshCache::SphereRadius);
+                   }
+               },
+               size >= 1000000 ? 1 : 0);
+
+    if (runner.Enabled("Pick/LineAfterRemove/" + label)) {
+        std::vector<uint32_t> editedIndices;
+        std::vector<glm::vec2> lineCursors = PickCursors(vertices, projection * view, edits, 19);
+        runner.Run("Pick/LineAfterRemove/" + label, edits,
+                   [&] {
+                       editedIndices = indices;
+                       lineBVH.Build(vertices, editedIndices);
+                   },
+                   [&] {
+                       for (size_t i = 0; i < edits; ++i) {
+                           // Swap-and-pop, as LineStore::Remove(index) does
+                           size_t last = editedIndices.size() / 2 - 1;
+                           size_t index = editRandom() % (last + 1);
+                           editedIndices[index * 2] = editedIndices[last * 2];
+                           editedIndices[index * 2 + 1] = editedIndices[last * 2 + 1];
+                           editedIndices.resize(last * 2);
+                           lineBVH.LineRemoved(index, last, vertices, editedIndices);
+                           if (lineBVH.NeedsRebuild(last)) {
+                               lineBVH.Build(vertices, editedIndices);
+                           }
+                           PickRay ray;
+                           if (PickRay::FromScreen(view, projection, lineCursors[i], viewport, ray)) {
+                               editSink = lineBVH.Pick(vertices, editedIndices, ray, 5.0f);
+                           }
+                       }
+                   },
+                   size >= 1000000 ? 1 : 0);
+    }
+}
+
+void BenchPointLod(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions) {
+    std::string label = SizeLabel(size);
+    std::vector<glm::vec3> points(positions.begin(), positions.begin() + size);
+
+    PointLod lod;
+    runner.Run("PointLod/Build/" + label, size, [] {}, [&] { lod.Build(points); }, size >= 1000000 ? 1 : 0);
+    if (!runner.Enabled("PointLod/Select/" + label)) {
+        return;
+    }
+    if (lod.GetSlots().size() != size) {
+        lod.Build(points);
+    }
+
+    // One selection per frame of the benchmark camera's view
+    Camera camera = BenchCamera();
+    glm::mat4 projection = camera.GetProjectionMatrix();
+    PointLodView view;
+    view.viewProjection = projection * camera.GetViewMatrix();
+    view.eye = camera.GetPosition();
+    view.pixelsPerUnit = 0.5f * projection[1][1] * ViewportHeight;
+    view.viewportPixels = static_cast<float>(ViewportWidth) * ViewportHeight;
+    view.pointRadius = MeshCache::SphereRadius;
+    PointLodSelection selection;
+    const size_t selections = 20;
+    runner.Run("PointLod/Select/" + label, selections, [] {},
+               [&] {
+                   for (size_t i = 0; i < selections; ++i) {
+                       lod.Select(points, view, selection);
+                   }
+               });
+    const PointLodStats& stats = selection.stats;
+    std::printf("    %zu spheres, %zu impostors, %zu dots, %zu skipped; %zu of %zu chunks culled\n",
+                stats.geometryPoints, stats.impostorPoints, stats.dotPoints, stats.skippedPoints,
+                stats.culledChunks, stats.chunks);
+}
+
+// Picking over a set of orbiting cameras rather than one viewpoint: random
+// 3D clouds seen from around and above, coplanar clouds seen from above,
+// and coplanar clouds seen from inside their plane, where every pick ray
+// grazes the plane and crosses the most cells
+void BenchPickingOrbit(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions,
+                       const std::vector<glm::vec3>& segments) {
+    std::string label = SizeLabel(size);
+    glm::vec2 viewport(static_cast<float>(ViewportWidth), static_cast<float>(ViewportHeight));
+    const size_t cameraCount = 8;
+    const size_t picksPerCamera = 125;
+
+    struct OrbitCase {
+        const char* name;
+        bool planar;
+        float height;
+    };
+    const OrbitCase cases[] = {
+        {"Orbit", false, 6.0f},
+        {"PlanarOrbit", true, 6.0f},
+        {"InPlane", true, 0.0f},
+    };
+
+    std::vector<glm::vec3> points(positions.begin(), positions.begin() + size);
+    std::vector<glm::vec3> vertices(segments.begin(), segments.begin() + size * 2);
+    std::vector<uint32_t> indices(size * 2);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint32_t>(i);
+    }
+
+    for (const OrbitCase& orbit : cases) {
+        std::string pointName = std::string("Pick/Point") + orbit.name + "/" + label;
+        std::string lineName = std::string("Pick/Line") + orbit.name + "/" + label;
+        if (!runner.Enabled(pointName) && !runner.Enabled(lineName)) {
+            continue;
+        }
+        std::vector<Camera> cameras = OrbitCameras(cameraCount, orbit.height);
+        std::vector<glm::vec3> cloud = orbit.planar ? Flatten(points) : points;
+        std::vector<glm::vec3> lineVertices = orbit.planar ? Flatten(vertices) : vertices;
+
+        if (runner.Enabled(pointName)) {
+            PointPicker pointPicker;
+            pointPicker.Build(cloud);
+            std::vector<std::vector<glm::vec2>> cursors;
+            for (size_t c = 0; c < cameras.size(); ++c) {
+                glm::mat4 viewProjection = cameras[c].GetProjectionMatrix() * cameras[c].GetViewMatrix();
+                cursors.push_back(PickCursors(cloud, viewProjection, picksPerCamera, 17 + static_cast<unsigned int>(c)));
+            }
+            volatile int sink = 0;
+            runner.Run(pointName, cameraCount * picksPerCamera, [] {},
+                       [&] {
+                           for (size_t c = 0; c < cameras.size(); ++c) {
+                               glm::mat4 view = cameras[c].GetViewMatrix();
+                               glm::mat4 projection = cameras[c].GetProjectionMatrix();
+                               for (const glm::vec2& cursor : cursors[c]) {
+                                   sink = pointPicker.Pick(cloud, view, projection, cursor, viewport, 6.0f,
+                                                           MeshCache::SphereRadius);
+                               }
+                           }
+                       });
+        }
+
+        if (runner.Enabled(lineName)) {
+            LineBVH lineBVH;
+            lineBVH.Build(lineVertices, indices);
+            std::vector<std::vector<glm::vec2>> cursors;
+            for (size_t c = 0; c < cameras.size(); ++c) {
+                glm::mat4 viewProjection = cameras[c].GetProjectionMatrix() * cameras[c].GetViewMatrix();
+                cursors.push_back(PickCursors(lineVertices, viewProjection, picksPerCamera, 31 + static_cast<unsigned int>(c)));
+            }
+            volatile int sink = 0;
+            runner.Run(lineName, cameraCount * picksPerCamera, [] {},
+                       [&] {
+                           for (size_t c = 0; c < cameras.size(); ++c) {
+                               glm::mat4 view = cameras[c].GetViewMatrix();
+                               glm::mat4 projection = cameras[c].GetProjectionMatrix();
+                               for (const glm::vec2& cursor : cursors[c]) {
+                                   PickRay ray;
+                                   if (PickRay::FromScreen(view, projection, cursor, viewport, ray)) {
+                                       sink = lineBVH.Pick(lineVertices, indices, ray, 5.0f);
+                                   }
+                               }
+                           }
+                       },
+                       size >= 1000000 ? 1 : 0);
+        }
+    }
+}
+
+// Render benchmarks need a context: an invisible window, never presented
+GLFWwindow* CreateBenchContext() {
+    if (!glfwInit()) {
+        return nullptr;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(ViewportWidth, ViewportHeight, "bench_scene", nullptr, nullptr);
+    if (!window) {
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGL((void* (*)(const char*))glfwGetProcAddress)) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return nullptr;
+    }
+    glEnable(GL_DEPTH_TEST);
+    return window;
+}
+
+void BenchMesh(BenchRunner& runner, size_t size) {
+    std::string label = SizeLabel(size);
+    if (!runner.Enabled("Mesh/Build/" + label) && !runner.Enabled("Mesh/VertexFan/" + label)) {
+        return;
+    }
+
+    std::vector<glm::vec3> gridPositions;
+    std::vector<uint32_t> gridIndices;
+    GridMesh(size, gridPositions, gridIndices);
+
+    // Build takes the arrays over, so each repetition gets fresh copies
+    HalfEdgeMesh mesh;
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    runner.Run("Mesh/Build/" + label, gridIndices.size() / 3,
+               [&] {
+                   mesh.Clear();
+                   positions = gridPositions;
+                   indices = gridIndices;
+               },
+               [&] { mesh.Build(std::move(positions), std::move(indices)); });
+    if (mesh.Empty()) {
+        mesh.Build(gridPositions, gridIndices);
+    }
+    std::printf("    %zu vertices, %zu triangles: %.1f MB\n", mesh.VertexCount(), mesh.FaceCount(),
+                mesh.GetMemoryUsage() / (1024.0 * 1024.0));
+
+    // One-ring of every vertex: the adjacency query smoothing and
+    // simplification are built on
+    volatile size_t sink = 0;
+    runner.Run("Mesh/VertexFan/" + label, mesh.VertexCount(), [] {},
+               [&] {
+                   size_t valence = 0;
+                   for (uint32_t vertex = 0; vertex < mesh.VertexCount(); ++vertex) {
+                       mesh.ForEachOutgoing(vertex, [&](uint32_t) { ++valence; });
+                   }
+                   sink = valence;
+               });
+}
+
+// Scene files of size lines between 2 x size points, written to the working
+// directory. Open is the mapping alone; Load also verifies and copies
+// into a scene.
+void BenchFile(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& segments) {
+    std::string label = SizeLabel(size);
+    if (!runner.Enabled("File/Save/" + label) && !runner.Enabled("File/Open/" + label) &&
+        !runner.Enabled("File/Verify/" + label) && !runner.Enabled("File/Load/" + label)) {
+        return;
+    }
+
+    const std::string path = "bench_scene_file.tmp";
+    Scene scene;
+    std::vector<PointId> endpoints = AddSegmentPoints(scene, segments, size);
+    scene.AddLines(endpoints);
+    runner.Run("File/Save/" + label, size, [] {}, [&] { SaveSceneFile(scene, path); });
+
+    MappedSceneFile file;
+    if (!file.Open(path)) {
+        return;
+    }
+    std::printf("    %.1f MB file\n", file.GetFileSize() / (1024.0 * 1024.0));
+    file.Close();
+
+    runner.Run("File/Open/" + label, 1, [&] { file.Close(); }, [&] { file.Open(path); });
+    file.Open(path);
+    volatile bool sink = false;
+    runner.Run("File/Verify/" + label, size, [] {}, [&] { sink = file.VerifyChecksum(); });
+    file.Close();
+
+    Scene loaded;
+    runner.Run("File/Load/" + label, size, [] {}, [&] { LoadSceneFile(loaded, path); });
+    std::remove(path.c_str());
+}
+
+void BenchImport(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions) {
+    std::string label = SizeLabel(size);
+    if (!runner.Enabled("Import/Xyz/" + label) && !runner.Enabled("Import/XyzSerial/" + label) &&
+        !runner.Enabled("Import/PlyBinary/" + label) && !runner.Enabled("Import/Async/" + label)) {
+        return;
+    }
+
+    const std::string xyzPath = "bench_import.xyz";
+    const std::string plyPath = "bench_import.ply";
+    FILE* xyz = std::fopen(xyzPath.c_str(), "w");
+    FILE* ply = std::fopen(plyPath.c_str(), "wb");
+    if (!xyz || !ply) {
+        if (xyz) std::fclose(xyz);
+        if (ply) std::fclose(ply);
+        return;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        std::fprintf(xyz, "%.6f %.6f %.6f\n", positions[i].x, positions[i].y, positions[i].z);
+    }
+    std::fprintf(ply, "ply\nformat binary_little_endian 1.0\nelement vertex %zu\n"
+                      "property float x\nproperty float y\nproperty float z\nend_header\n", size);
+    std::fwrite(positions.data(), sizeof(glm::vec3), size, ply);
+    std::printf("    %.1f MB XYZ, %.1f MB PLY\n", std::ftell(xyz) / (1024.0 * 1024.0), std::ftell(ply) / (1024.0 * 1024.0));
+    std::fclose(xyz);
+    std::fclose(ply);
+
+    // Parsing only: the consumer just counts, so the figure is the importer's throughput
+    size_t imported = 0;
+    auto count = [&](ImportChunk& chunk) {
+        imported += chunk.points.size();
+        return true;
+    };
+    ImportOptions parallel;
+    ImportOptions serial;
+    serial.threadCount = 1;
+    runner.Run("Import/Xyz/" + label, size, [&] { imported = 0; }, [&] { ImportFile(xyzPath, parallel, count); });
+    runner.Run("Import/XyzSerial/" + label, size, [&] { imported = 0; }, [&] { ImportFile(xyzPath, serial, count); });
+    runner.Run("Import/PlyBinary/" + label, size, [&] { imported = 0; }, [&] { ImportFile(plyPath, parallel, count); });
+
+    // Background import into a scene, applied as a render loop would with
+    // a 4 ms budget per iteration; the longest iteration is what stutters
+    std::unique_ptr<Scene> scene;
+    double worstApply = 0.0;
+    runner.Run("Import/Async/" + label, size, [&] { scene = std::make_unique<Scene>(); },
+               [&] {
+                   AsyncImporter importer;
+                   importer.Start(xyzPath);
+                   while (importer.IsActive()) {
+                       auto start = std::chrono::steady_clock::now();
+                       importer.Apply(*scene, 0.004);
+                       std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                       worstApply = std::max(worstApply, elapsed.count());
+                       std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                   }
+               });
+    if (runner.Enabled("Import/Async/" + label)) {
+        std::printf("    longest Apply() %.2f ms\n", worstApply * 1e3);
+    }
+    std::remove(xyzPath.c_str());
+    std::remove(plyPath.c_str());
+}
+
+void BenchRender(BenchRunner& runner, size_t size, const std::vector<glm::vec3>& positions) {
+    std::string label = SizeLabel(size);
+    if (!runner.Enabled("Render/Submit/" + label) && !runner.Enabled("Render/Frame/" + label) &&
+        !runner.Enabled("Render/FrameNoLod/" + label) && !runner.Enabled("Render/GLCalls/" + label) &&
+        !runner.Enabled("Render/UploadRing/" + label) &&
+        !runner.Enabled("Render/UploadDirect/" + label)) {
+        return;
+    }
+
+    // size points and a chain of size - 1 lines through them
+    Scene scene;
+    scene.Initialize();
+    PointId previous = InvalidPointId;
+    for (size_t i = 0; i < size; ++i) {
+        PointId point = scene.AddPoint(positions[i]);
+        scene.AddLine(previous, point);
+        previous = point;
+    }
+    scene.UpdateViewport(ViewportWidth, ViewportHeight);
+    glViewport(0, 0, ViewportWidth, ViewportHeight);
+
+    auto drawFrame = [&] {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        scene.Render();
+        UploadRing::Instance().EndFrame();
+    };
+
+    // First frames upload the instance and line buffers; keep them out
+    drawFrame();
+    glFinish();
+
+    // GL calls one steady-state frame makes through the loader (counted
+    // only when glad.c is built with MESHENGINE_GL_CALL_COUNTS)
+#ifdef MESHENGINE_GL_CALL_COUNTS
+    if (runner.Enabled("Render/GLCalls/" + label)) {
+        gladResetCallCounts();
+        scene.Render();
+        GladCallCounts calls = gladGetCallCounts();
+        std::printf("%-36s %12llu calls/frame: %llu glUniform*, %llu glGetUniformLocation, %llu draws\n",
+                    ("Render/GLCalls/" + label).c_str(), calls.total, calls.uniformSets, calls.uniformLookups, calls.draws);
+        glFinish();
+    }
+#endif
+
+    // Submission: CPU cost of issuing a frame, GPU work left in flight
+    // (drained untimed between repetitions)
+    const int frames = size >= 1000000 ? 3 : 20;
+    runner.Run("Render/Submit/" + label, frames, [] { glFinish(); },
+               [&] {
+                   for (int i = 0; i < frames; ++i) {
+                       drawFrame();
+                   }
+               });
+
+    // Full frame: submission plus GPU execution
+    runner.Run("Render/Frame/" + label, frames, [] {},
+               [&] {
+                   for (int i = 0; i < frames; ++i) {
+                       drawFrame();
+                       glFinish();
+                   }
+               });
+
+    // The same frame with every point drawn as a sphere mesh
+    if (runner.Enabled("Render/FrameNoLod/" + label)) {
+        scene.SetPointLod(false);
+        runner.Run("Render/FrameNoLod/" + label, frames, [] {},
+                   [&] {
+                       for (int i = 0; i < frames; ++i) {
+                           drawFrame();
+                           glFinish();
+                       }
+                   });
+        scene.SetPointLod(true);
+    }
+
+    // Dynamic uploads: a block of 1% of the points moves every frame, sent
+    // through the upload ring and then straight with glBufferSubData
+    size_t moved = std::max(size / 100, size_t(1));
+    int frame = 0;
+    auto churnFrame = [&] {
+        size_t first = (frame * moved) % (size - moved + 1);
+        float lift = (frame & 1) ? 0.01f : -0.01f;
+        for (size_t i = first; i < first + moved; ++i) {
+            scene.SetPointPosition(static_cast<int>(i), scene.GetPoints().GetPositions()[i] + glm::vec3(0.0f, lift, 0.0f));
+        }
+        ++frame;
+        drawFrame();
+    };
+    for (bool ring : {true, false}) {
+        UploadRing::Instance().SetEnabled(ring);
+        UploadRing::Instance().ResetStats();
+        runner.Run(std::string(ring ? "Render/UploadRing/" : "Render/UploadDirect/") + label, frames, [] { glFinish(); },
+                   [&] {
+                       for (int i = 0; i < frames; ++i) {
+                           churnFrame();
+                       }
+                   });
+        const UploadStats& stats = UploadRing::Instance().GetStats();
+        if (stats.uploads > 0) {
+            std::printf("    %s uploads: %.0f MB/s, %.2f stalls/frame, %llu orphans\n", ring ? "ring" : "direct",
+                        stats.GetMegabytesPerSecond(), static_cast<double>(stats.stalls) / std::max<uint64_t>(stats.frames, 1),
+                        static_cast<unsigned long long>(stats.orphans));
+        }
+    }
+    UploadRing::Instance().SetEnabled(true);
+}
+
+void PrintUsage(const char* program) {
+    std::printf("Usage: %s [options]\n", program);
+    std::printf("  --json <file>      write results as Google Benchmark-style JSON\n");
+    std::printf("  --max-size <n>     largest scene size to run (default 10000000)\n");
+    std::printf("  --filter <text>    only run benchmarks whose name contains text\n");
+    std::printf("  --repetitions <n>  repetitions per benchmark; the fastest is kept (default 3)\n");
+    std::printf("  --gl               also run render benchmarks (needs a display or xvfb-run)\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            options.maxSize = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--gl") == 0) {
+            options.gl = true;
+        } else {
+            PrintUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    std::vector<size_t> sizes;
+    for (size_t size : {size_t(1000), size_t(100000), size_t(1000000), size_t(10000000)}) {
+        if (size <= options.maxSize) {
+            sizes.push_back(size);
+        }
+    }
+    if (sizes.empty()) {
+        std::fprintf(stderr, "--max-size is below the smallest benchmark size (1000)\n");
+        return 1;
+    }
+
+    // One shared synthetic data set; each size uses a prefix of it
+    std::vector<glm::vec3> positions = RandomPositions(sizes.back(), 1);
+    std::vector<glm::vec3> segments = RandomSegments(sizes.back(), 2);
+
+    BenchRunner runner(options);
+    for (size_t size : sizes) {
+        BenchInsertion(runner, size, positions, segments);
+        BenchRemoval(runner, size, positions, segments);
+        BenchSelection(runner, size, positions);
+        BenchPicking(runner, size, positions, segments);
+        BenchPickingOrbit(runner, size, positions, segments);
+        BenchPointLod(runner, size, positions);
+        BenchMesh(runner, size);
+        BenchFile(runner, size, segments);
+        BenchImport(runner, size, positions);
+    }
+
+    if (options.gl) {
+        GLFWwindow* window = CreateBenchContext();
+        if (!window) {
+            std::fprintf(stderr, "Failed to create a GL context; skipping render benchmarks\n");
+        } else {
+            for (size_t size : sizes) {
+                BenchRender(runner, size, positions);
+            }
+            MeshCache::Instance().Release();
+            UploadRing::Instance().Release();
+            glfwDestroyWindow(window);
+            glfwTerminate();
+        }
+    }
+
+    Logger::Flush();
+    if (!options.jsonPath.empty() && !runner.WriteJson(options.jsonPath, argv[0])) {
+        return 1;
+    }
+    return 0;
+}
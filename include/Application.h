@@ -8,6 +8,9 @@
 #include <glad/gl.h>
 #include "Scene.h"
 #include "UIComponent.h"
+#include "OverlayRenderer.h"
+#include "FrameScheduler.h"
+#include "AsyncImporter.h"
 
 // Version information
 #define MESHENGINE_VERSION "v1.0.0"
@@ -21,6 +24,22 @@ public:
     void Run();
     void Shutdown();
     
+    // Select how the main loop paces frames; call before Initialize()
+    void SetFramePacing(FramePacing pacing, int targetFps = 60);
+    
+    // Select CPU or GPU hover picking
+    void SetHoverPicking(HoverPicking mode);
+    
+    // Write the profiler's Chrome trace to this file on shutdown
+    void SetTraceOutput(const std::string& path);
+    
+    // Scene file opened on startup (if it exists) and written by Ctrl+S
+    void SetScenePath(const std::string& path);
+    
+    // PLY, OBJ or XYZ file loaded into the scene in the background on
+    // startup; Escape cancels it
+    void SetImportPath(const std::string& path);
+    
 private:
     void ProcessInput();
     void HandleForwardBackward(double yoffset);
@@ -29,6 +48,7 @@ private:
     void RenderGraphics();
     void RenderVersionNumber();
     void RenderUI();
+    void UpdateImport();
     
     // Window properties
     int m_width, m_height;
@@ -38,10 +58,23 @@ private:
     // Scene and UI
     std::unique_ptr<Scene> m_scene;
     std::unique_ptr<UIComponent> m_ui;
+    std::unique_ptr<OverlayRenderer> m_overlay;
+    
+    // Frame pacing
+    FrameScheduler m_frameScheduler;
     
     // Input state
     double m_lastMouseX, m_lastMouseY;
     bool m_firstMouse;
+    double m_lastHoverX, m_lastHoverY;  // cursor position hover was last updated for
+    HoverPicking m_hoverPicking;
+    std::string m_traceOutputPath;
+    std::string m_scenePath;
+    std::string m_importPath;
+    
+    // Background import; applied for at most this long per loop iteration
+    static constexpr double ImportBudgetSeconds = 0.004;
+    AsyncImporter m_importer;
     
     // Zoom state
     float m_zoomLevel;
@@ -0,0 +1,124 @@
+#ifndef ASYNCIMPORTER_H
+#define ASYNCIMPORTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SceneImporter.h"
+#include "SpscQueue.h"
+#include "HalfEdgeMesh.h"
+#include "PointStore.h"
+
+class Scene;
+
+enum class ImportState {
+    Idle,       // nothing started
+    Running,    // loading, or chunks still waiting to be applied
+    Finished,
+    Failed,     // unreadable or malformed file; what arrived before stays
+    Cancelled
+};
+
+struct ImportProgress {
+    ImportState state = ImportState::Idle;
+    size_t bytesRead = 0;       // input parsed so far
+    size_t bytesTotal = 0;      // file size, once known
+    size_t pointsApplied = 0;   // points added to the scene so far
+    size_t linesApplied = 0;
+    size_t queuedChunks = 0;    // parsed chunks waiting for Apply()
+
+    float GetFraction() const { return bytesTotal > 0 ? static_cast<float>(bytesRead) / bytesTotal : 0.0f; }
+};
+
+// Loads a PLY, OBJ or XYZ file in the background while the render loop
+// keeps running.
+//
+// A loader thread runs ImportFile() (which parses on its own thread pool)
+// and posts each finished chunk through a single-producer single-consumer
+// queue. The render thread calls Apply() once per frame, which moves
+// chunks into the scene until a time budget is spent, so a large scan
+// shows up a slice at a time and each frame uploads only what that slice
+// added. Faces never touch the render thread until the end: the loader
+// keeps its own copy of the vertices and triangles, builds the half-edge
+// mesh itself and hands it over finished.
+//
+// Imported points are referenced by handle, so lines still connect the
+// right points if the user edits the scene during the import; lines to a
+// point that was deleted meanwhile are dropped.
+class AsyncImporter {
+public:
+    AsyncImporter();
+    ~AsyncImporter();
+
+    AsyncImporter(const AsyncImporter&) = delete;
+    AsyncImporter& operator=(const AsyncImporter&) = delete;
+
+    // Start loading path; false if an import is already in progress
+    bool Start(const std::string& path, const ImportOptions& options = ImportOptions());
+
+    // Stop the loader and drop chunks not yet applied. Points already in
+    // the scene stay. Blocks until the loader thread exits, which takes at
+    // most the parse of the chunks in flight.
+    void Cancel();
+
+    // Render thread: apply queued chunks to scene for up to budgetSeconds
+    // (at least one slice, so the import always advances). Returns true if
+    // the scene changed.
+    bool Apply(Scene& scene, double budgetSeconds);
+
+    // True from Start() until the last chunk and the mesh are applied
+    bool IsActive() const { return m_state == ImportState::Running; }
+
+    ImportProgress GetProgress() const;
+    const std::string& GetPath() const { return m_path; }
+
+private:
+    // Points and lines are applied in slices of at most this many, which
+    // bounds how far one step can overshoot the budget
+    static constexpr size_t SliceSize = 65536;
+
+    static constexpr size_t QueueCapacity = 16;
+
+    void Load(ImportOptions options);
+    bool Post(ImportChunk& chunk);
+    bool ApplySlice(Scene& scene);
+    void Reserve(Scene& scene);
+    void Finish(Scene& scene);
+    void JoinLoader();
+
+    std::string m_path;
+    ImportState m_state;
+    std::thread m_loader;
+    SpscQueue<ImportChunk> m_queue;
+
+    // Written by the loader, read by the render thread
+    std::atomic<bool> m_cancel;
+    std::atomic<bool> m_loaderDone;
+    std::atomic<size_t> m_bytesRead;
+    std::atomic<size_t> m_bytesTotal;
+
+    // Loader results, read only after m_loaderDone
+    bool m_loaded;
+    ImportStats m_stats;
+    HalfEdgeMesh m_mesh;
+
+    // Loader thread: the mesh being gathered
+    std::vector<glm::vec3> m_meshPositions;
+    std::vector<uint32_t> m_meshIndices;
+
+    // Render thread: the chunk being applied and how far it got
+    ImportChunk m_current;
+    bool m_hasCurrent;
+    size_t m_currentPoint;
+    size_t m_currentLine;
+    bool m_reserved;
+    std::vector<PointId> m_pointIds;        // import index -> scene handle; only kept if the file has lines
+    std::vector<PointId> m_sliceIds;
+    std::vector<PointId> m_lineEndpoints;
+    size_t m_pointsApplied;
+    size_t m_linesApplied;
+};
+
+#endif
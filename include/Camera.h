@@ -26,6 +26,13 @@ public:
     
     // Setters
     void SetAspectRatio(float aspectRatio);
+    
+    // Place the camera at position facing target (pitch limited to +-89 degrees)
+    void LookAt(const glm::vec3& position, const glm::vec3& target);
+    
+    // Set whenever the view or projection changes; cleared by the renderer
+    bool IsDirty() const { return m_dirty; }
+    void ClearDirty() { m_dirty = false; }
 
 private:
     void UpdateCameraVectors();
@@ -46,4 +53,6 @@ private:
     float m_mouseSensitivity;
     float m_zoom;
     float m_aspectRatio;
+    
+    bool m_dirty;
 }; 
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef DYNAMICBITSET_H
+#define DYNAMICBITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Growable packed bit array used for per-element flags (selected, hovered, ...)
+// in the structure-of-arrays scene stores. One bit per element, 64 per word.
+class DynamicBitset {
+public:
+    size_t Size() const { return m_size; }
+    
+    bool Test(size_t index) const {
+        return (m_words[index >> 6] >> (index & 63)) & 1u;
+    }
+    
+    void Set(size_t index, bool value) {
+        uint64_t mask = uint64_t(1) << (index & 63);
+        if (value) {
+            m_words[index >> 6] |= mask;
+        } else {
+            m_words[index >> 6] &= ~mask;
+        }
+    }
+    
+    void PushBack(bool value) {
+        if ((m_size & 63) == 0) {
+            m_words.push_back(0);
+        }
+        ++m_size;
+        Set(m_size - 1, value);
+    }
+    
+    void Reserve(size_t count) { m_words.reserve((count + 63) >> 6); }
+    
+    // Clear every bit without changing the size
+    void ResetAll() {
+        for (uint64_t& word : m_words) {
+            word = 0;
+        }
+    }
+    
+    bool Any() const {
+        for (uint64_t word : m_words) {
+            if (word) return true;
+        }
+        return false;
+    }
+    
+    // Calls visit(index) for every set bit in ascending order; empty words
+    // are skipped 64 bits at a time
+    template <typename Visitor>
+    void ForEachSet(Visitor visit) const {
+        for (size_t w = 0; w < m_words.size(); ++w) {
+            for (uint64_t word = m_words[w]; word; word &= word - 1) {
+                visit((w << 6) + static_cast<size_t>(__builtin_ctzll(word)));
+            }
+        }
+    }
+    
+    void Clear() {
+        m_words.clear();
+        m_size = 0;
+    }
+    
+    // Grow with cleared bits or drop every bit from count onwards
+    void Resize(size_t count) {
+        m_size = count;
+        m_words.resize((m_size + 63) >> 6, 0);
+        if (m_size & 63) {
+            m_words.back() &= (uint64_t(1) << (m_size & 63)) - 1;
+        }
+    }
+    
+    // Remove the last bit
+    void PopBack() {
+        --m_size;
+        Set(m_size, false);
+        m_words.resize((m_size + 63) >> 6);
+    }
+    
+private:
+    std::vector<uint64_t> m_words;
+    size_t m_size = 0;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <GLFW/glfw3.h>
+#include <chrono>
+
+enum class FramePacing {
+    VSync,      // Render every iteration, swap paced by the display
+    FixedFps,   // Render every iteration, sleep to hold a target frame rate
+    OnDemand    // Block on input and render only when something changed
+};
+
+// Decides when the main loop waits, polls and renders.
+//
+// In OnDemand mode the loop blocks in glfwWaitEventsTimeout until input
+// arrives, and a frame is drawn only after RequestRedraw(). While frames
+// keep being requested (camera drags, held keys) events are polled instead,
+// so continuous interaction stays smooth and an idle editor sleeps.
+class FrameScheduler {
+public:
+    FrameScheduler();
+
+    void SetPacing(FramePacing pacing, int targetFps = 60);
+    FramePacing GetPacing() const { return m_pacing; }
+    int GetTargetFps() const { return m_targetFps; }
+
+    // Apply the swap interval for the current pacing; needs a current context
+    void Apply();
+
+    // Process pending window events, blocking when idle in OnDemand mode
+    void WaitForEvents();
+
+    // Ask for a frame to be drawn on the next iteration
+    void RequestRedraw() { m_redrawRequested = true; }
+
+    // Keep the next wait short without drawing a frame, for work that
+    // completes asynchronously (e.g. a GPU readback being polled)
+    void RequestWakeup() { m_wakeupRequested = true; }
+
+    // Whether to render this iteration; consumes a pending redraw request
+    bool BeginFrame();
+
+    // Called after a rendered frame has been swapped
+    void EndFrame();
+
+private:
+    // Upper bound on how long OnDemand mode sleeps without any events
+    static constexpr double IdleTimeoutSeconds = 0.5;
+
+    // Wait used while asynchronous work is being polled
+    static constexpr double WakeupTimeoutSeconds = 0.001;
+
+    FramePacing m_pacing;
+    int m_targetFps;
+    bool m_redrawRequested;
+    bool m_wakeupRequested;
+    bool m_renderedLastIteration;
+    std::chrono::steady_clock::time_point m_nextFrameTime;
+};
+
+#endif
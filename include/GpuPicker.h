@@ -0,0 +1,114 @@
+#ifndef GPUPICKER_H
+#define GPUPICKER_H
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Shader.h"
+
+// GPU ID-buffer picking with asynchronous readback.
+//
+// A picking pass renders point and line IDs into an unsigned integer
+// framebuffer instead of colors: points write instance index + 1, lines
+// write (primitive index + 1) tagged with LineTag, and 0 means background.
+// Only a small scissor box around the cursor is rasterised, and only the
+// points the caller found near the cursor are drawn, each with its own ID.
+//
+// EndPass() copies that box into a pixel pack buffer and inserts a fence,
+// so nothing waits on the GPU. PollResult() checks the fence without
+// blocking and, once the copy has landed, decodes the box in O(box area):
+// points win over lines, and nearer pixels to the cursor win among equals.
+class GpuPicker {
+public:
+    GpuPicker();
+    ~GpuPicker();
+
+    // Create shaders and readback buffers; needs a current context. The
+    // shaders read view/projection from the "Camera" block at cameraBlockBinding.
+    bool Initialize(GLuint cameraBlockBinding);
+
+    // Begin a picking pass around a cursor position in viewport pixels
+    // (top-left origin). Binds the ID framebuffer and sizes it to the
+    // viewport. Returns false if no readback slot is free or the cursor is
+    // outside the viewport; skip the draws.
+    bool BeginPass(double screenX, double screenY, int viewportWidth, int viewportHeight);
+
+    // Draw calls for the pass. DrawPoints() draws a sphere for each point
+    // in indices (e.g. from PointPicker::Collect()) and writes its index;
+    // DrawLines() uses the scene's line VAO.
+    void DrawPoints(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+    void DrawLines(GLuint vao, GLsizei indexCount);
+
+    // Queue the readback, fence it and restore the framebuffers and viewport
+    // bound at BeginPass()
+    void EndPass();
+
+    // Non-blocking. Returns true when a pass has completed, with the point
+    // and line under the cursor (-1 for none; at most one is set). Older
+    // completed passes are superseded by the newest one.
+    bool PollResult(int& pointIndex, int& lineIndex);
+
+    // Drop every in-flight readback without reading it
+    void DiscardPending();
+
+    bool IsReadbackPending() const { return m_pendingCount > 0; }
+    bool CanBeginPass() const { return m_pendingCount < ReadbackSlots; }
+
+    static constexpr GLuint LineTag = 0x80000000u;
+
+    // Pixels either side of the cursor searched for an ID
+    static constexpr int PickRadius = 5;
+    static constexpr int PickBoxSize = 2 * PickRadius + 1;
+
+private:
+    // Per-instance data of the point draw: sphere center and point index
+    struct PointInstance {
+        glm::vec3 position;
+        uint32_t index;
+    };
+
+    // Readbacks that may be in flight at once
+    static constexpr int ReadbackSlots = 3;
+
+    struct Readback {
+        GLuint pbo;
+        GLsync fence;
+        int centerX, centerY;  // cursor within the read box
+        int width, height;     // read box, clipped to the framebuffer
+    };
+
+    void ResizeTarget(int width, int height);
+    void ReleaseTarget();
+    void ReleaseFence(Readback& readback);
+
+    std::unique_ptr<Shader> m_pointShader;
+    std::unique_ptr<Shader> m_lineShader;
+
+    // Shared sphere mesh instanced over the points being picked
+    GLuint m_pointVAO;
+    GLuint m_pointInstanceVBO;
+    size_t m_pointInstanceCapacity;
+    std::vector<PointInstance> m_pointInstances;
+
+    // ID framebuffer: R32UI color plus depth, sized to the scene viewport
+    GLuint m_framebuffer;
+    GLuint m_idBuffer;
+    GLuint m_depthBuffer;
+    int m_width, m_height;
+
+    // Ring of readbacks; m_firstPending is the oldest in flight
+    Readback m_readbacks[ReadbackSlots];
+    int m_firstPending;
+    int m_pendingCount;
+
+    // State saved by BeginPass() and restored by EndPass()
+    GLint m_savedViewport[4];
+    GLint m_savedDrawFramebuffer;
+    GLint m_savedReadFramebuffer;
+    int m_boxX, m_boxY, m_boxWidth, m_boxHeight;
+    int m_centerX, m_centerY;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef HALFEDGEMESH_H
+#define HALFEDGEMESH_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Triangle mesh with half-edge connectivity in the compact directed-edge
+// form: no pointers and no half-edge records. Half-edge h is side h % 3 of
+// triangle h / 3, running from vertex m_indices[h] to the next corner, so
+// face, next and previous are arithmetic and the index array doubles as the
+// GL_TRIANGLES element buffer. Only the opposite half-edge is stored, plus
+// one outgoing half-edge per vertex.
+//
+// Memory is 24 bytes per triangle and 16 per vertex; a 10M-triangle mesh
+// with 5M vertices needs about 320 MB, and building it about 140 MB more.
+class HalfEdgeMesh {
+public:
+    static constexpr uint32_t NoHalfEdge = 0xFFFFFFFFu;
+
+    // Bulk construction from an indexed triangle list (three vertex indices
+    // per triangle). Pass the arrays with std::move to avoid copying them.
+    // Returns false and leaves the mesh empty if an index is out of range.
+    bool Build(std::vector<glm::vec3> positions, std::vector<uint32_t> indices);
+    void Clear();
+
+    size_t VertexCount() const { return m_positions.size(); }
+    size_t FaceCount() const { return m_indices.size() / 3; }
+    size_t HalfEdgeCount() const { return m_indices.size(); }
+    bool Empty() const { return m_indices.empty(); }
+
+    // Vertices
+    const glm::vec3& GetPosition(uint32_t vertex) const { return m_positions[vertex]; }
+    void SetPosition(uint32_t vertex, const glm::vec3& position) { m_positions[vertex] = position; }
+    const std::vector<glm::vec3>& GetPositions() const { return m_positions; }
+    const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+
+    // Connectivity, all O(1)
+    static uint32_t Face(uint32_t halfEdge) { return halfEdge / 3; }
+    static uint32_t FaceHalfEdge(uint32_t face) { return face * 3; }
+    static uint32_t Next(uint32_t halfEdge) { return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1; }
+    static uint32_t Prev(uint32_t halfEdge) { return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1; }
+    uint32_t Twin(uint32_t halfEdge) const { return m_twins[halfEdge]; }
+    uint32_t Origin(uint32_t halfEdge) const { return m_indices[halfEdge]; }
+    uint32_t Target(uint32_t halfEdge) const { return m_indices[Next(halfEdge)]; }
+    bool IsBoundary(uint32_t halfEdge) const { return m_twins[halfEdge] == NoHalfEdge; }
+
+    // An outgoing half-edge of vertex, or NoHalfEdge if no face uses it.
+    // On the border this is the one a fan walk must start from.
+    uint32_t VertexHalfEdge(uint32_t vertex) const { return m_vertexHalfEdge[vertex]; }
+
+    // Calls visit(halfEdge) for every half-edge leaving vertex, turning
+    // around it; Target() gives the neighbor and Face() the face. At a
+    // non-manifold vertex only the fan holding VertexHalfEdge() is visited.
+    template <typename Visitor>
+    void ForEachOutgoing(uint32_t vertex, Visitor visit) const {
+        uint32_t first = m_vertexHalfEdge[vertex];
+        uint32_t halfEdge = first;
+        while (halfEdge != NoHalfEdge) {
+            visit(halfEdge);
+            uint32_t twin = m_twins[halfEdge];
+            if (twin == NoHalfEdge) {
+                break;
+            }
+            halfEdge = Next(twin);
+            if (halfEdge == first) {
+                break;
+            }
+        }
+    }
+
+    // Half-edges on edges shared by more than two triangles or by two of
+    // the same orientation; they are left unpaired, as boundary
+    size_t GetNonManifoldHalfEdgeCount() const { return m_nonManifoldHalfEdges; }
+
+    // Bytes held by the mesh arrays
+    size_t GetMemoryUsage() const;
+
+private:
+    void BuildTwins();
+
+    std::vector<glm::vec3> m_positions;
+    std::vector<uint32_t> m_indices;          // half-edge -> origin vertex
+    std::vector<uint32_t> m_twins;            // half-edge -> opposite half-edge
+    std::vector<uint32_t> m_vertexHalfEdge;   // vertex -> outgoing half-edge
+    size_t m_nonManifoldHalfEdges = 0;
+};
+
+#endif
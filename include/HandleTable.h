@@ -0,0 +1,124 @@
+#ifndef HANDLETABLE_H
+#define HANDLETABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DynamicBitset.h"
+
+constexpr uint32_t InvalidHandleSlot = 0xFFFFFFFFu;
+
+// Generational handle: the slot an element was given plus that slot's
+// generation at the time. Removing the element bumps the generation, so a
+// stale handle stops resolving instead of aliasing whatever reuses the slot.
+// Tag keeps point and line handles from being mixed up.
+template <typename Tag>
+struct Handle {
+    uint32_t slot = InvalidHandleSlot;
+    uint32_t generation = 0;
+    
+    bool IsValid() const { return slot != InvalidHandleSlot; }
+    bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+// Slot map indirection for the structure-of-arrays stores. The store keeps
+// its elements densely packed and mirrors every Push() and SwapRemove() in
+// its own arrays; this table maps handles to the current dense index.
+// Every operation is O(1) and no handle is ever invalidated except by the
+// removal of its own element.
+template <typename HandleType>
+class HandleTable {
+public:
+    size_t Size() const { return m_slotByIndex.size(); }
+    
+    // Handle for a new element appended at index Size()
+    HandleType Push() {
+        uint32_t slot;
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(m_generations.size());
+            m_generations.push_back(0);
+            m_indexBySlot.push_back(InvalidHandleSlot);
+        }
+        m_indexBySlot[slot] = static_cast<uint32_t>(m_slotByIndex.size());
+        m_slotByIndex.push_back(slot);
+    
+        HandleType handle;
+        handle.slot = slot;
+        handle.generation = m_generations[slot];
+        return handle;
+    }
+    
+    // Retire the element at index; the last element takes its place, just
+    // as the store moves it with swap-and-pop
+    void SwapRemove(size_t index) {
+        uint32_t slot = m_slotByIndex[index];
+        uint32_t lastSlot = m_slotByIndex.back();
+        m_slotByIndex[index] = lastSlot;
+        m_indexBySlot[lastSlot] = static_cast<uint32_t>(index);
+        m_slotByIndex.pop_back();
+        Release(slot);
+    }
+    
+    // Retire every element whose bit is set and close the gaps in one pass,
+    // keeping the survivors in order, as the store does with its arrays
+    void RemoveMarked(const DynamicBitset& removed) {
+        size_t kept = 0;
+        for (size_t index = 0; index < m_slotByIndex.size(); ++index) {
+            uint32_t slot = m_slotByIndex[index];
+            if (removed.Test(index)) {
+                Release(slot);
+                continue;
+            }
+            m_slotByIndex[kept] = slot;
+            m_indexBySlot[slot] = static_cast<uint32_t>(kept);
+            ++kept;
+        }
+        m_slotByIndex.resize(kept);
+    }
+    
+    void Clear() {
+        for (uint32_t slot : m_slotByIndex) {
+            Release(slot);
+        }
+        m_slotByIndex.clear();
+    }
+    
+    void Reserve(size_t count) {
+        m_slotByIndex.reserve(count);
+        m_indexBySlot.reserve(count);
+        m_generations.reserve(count);
+    }
+    
+    HandleType GetHandle(size_t index) const {
+        HandleType handle;
+        handle.slot = m_slotByIndex[index];
+        handle.generation = m_generations[handle.slot];
+        return handle;
+    }
+    
+    // Current index of a live element, or -1 for stale and invalid handles
+    int IndexOf(HandleType handle) const {
+        if (handle.slot >= m_generations.size() || m_generations[handle.slot] != handle.generation) {
+            return -1;
+        }
+        return static_cast<int>(m_indexBySlot[handle.slot]);
+    }
+    
+private:
+    void Release(uint32_t slot) {
+        ++m_generations[slot];
+        m_indexBySlot[slot] = InvalidHandleSlot;
+        m_freeSlots.push_back(slot);
+    }
+    
+    std::vector<uint32_t> m_slotByIndex;   // dense index -> slot
+    std::vector<uint32_t> m_indexBySlot;   // slot -> dense index, InvalidHandleSlot when free
+    std::vector<uint32_t> m_generations;   // slot -> current generation
+    std::vector<uint32_t> m_freeSlots;
+};
+
+#endif
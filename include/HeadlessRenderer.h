@@ -0,0 +1,82 @@
+#ifndef HEADLESSRENDERER_H
+#define HEADLESSRENDERER_H
+
+#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Scene.h"
+
+struct HeadlessOptions {
+    int width = 1280;
+    int height = 720;
+    int frames = 600;           // measured frames: one full orbit
+    int warmupFrames = 30;      // rendered first and not measured
+    size_t pointCount = 10000;
+    size_t lineCount = 10000;
+    size_t triangleCount = 0;   // synthetic terrain mesh, about this many triangles
+    std::string scenePath;      // scene file rendered instead of the synthetic scene
+    std::string importPath;     // PLY, OBJ or XYZ file added to it (or rendered alone)
+    unsigned int seed = 1;      // synthetic scene layout
+    size_t churnPoints = 0;     // points moved every frame, to measure dynamic uploads
+    bool uploadRing = true;     // stream uploads through UploadRing; false for plain glBufferSubData
+    bool pointLod = true;       // level-of-detail point rendering; false draws every point as a sphere
+    bool pickCheck = false;     // verify GPU hover picking on a fixed scene instead of benchmarking
+    std::string statsPath;      // JSON summary; empty to only log it
+    std::string pngDirectory;   // frame dumps; empty to disable
+    int pngInterval = 60;       // dump every Nth measured frame
+    std::string tracePath;      // profiler Chrome trace; empty to disable
+};
+
+// Renders the scene offscreen for batch and CI benchmarking.
+//
+// The context comes from an invisible GLFW window; frames are drawn into
+// an FBO sized to the options, never to the window, so results do not
+// depend on a compositor or display refresh. A synthetic scene is rendered
+// while the camera follows a scripted orbit, and each frame is timed from
+// submission to glFinish() so the figure covers GPU work as well.
+//
+// Runs on software GL (e.g. Mesa llvmpipe with LIBGL_ALWAYS_SOFTWARE=1
+// under xvfb-run) on machines without a GPU.
+//
+// With pickCheck set, Run() instead hovers known points and lines of a
+// small fixed scene through the GPU picker and fails on a wrong answer.
+class HeadlessRenderer {
+public:
+    explicit HeadlessRenderer(const HeadlessOptions& options);
+    ~HeadlessRenderer();
+    
+    bool Initialize();
+    
+    // Render every frame and report statistics; false on a write failure
+    bool Run();
+    
+    void Shutdown();
+    
+private:
+    bool CreateTarget();
+    void PopulateScene();
+    void PopulatePickScene();
+    bool CheckPicking();
+    bool ProbeHover(const char* label, const glm::vec3& target, int expectedPoint, int expectedLine);
+    void PlaceCamera(int frame, int frameCount);
+    void ChurnPoints(int frame);
+    double RenderFrame();
+    bool DumpFrame(int frame);
+    bool ReportStats(std::vector<double> frameTimesMs);
+    
+    HeadlessOptions m_options;
+    GLFWwindow* m_window;
+    std::unique_ptr<Scene> m_scene;
+    
+    // Offscreen target: RGBA8 color plus depth
+    GLuint m_framebuffer;
+    GLuint m_colorBuffer;
+    GLuint m_depthBuffer;
+    
+    std::vector<uint8_t> m_pixels;  // readback storage for PNG dumps
+    PointLodStats m_pointLodTotals; // summed over the measured frames
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef LINEBVH_H
+#define LINEBVH_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "PickRay.h"
+
+// Bounding volume hierarchy over line segments for cursor picking.
+//
+// Segments are indexed like the LineStore: segment i runs from
+// positions[indices[2i]] to positions[indices[2i + 1]]. Build() uses a
+// binned SAH split on segment centroids; Refit() updates the bounds on the
+// path from one segment's leaf to the root after its endpoints move,
+// without changing the tree topology.
+//
+// Pick() returns the front-most segment within half a pixel of the cursor,
+// or failing that the segment closest to the ray in screen pixels, within a
+// pixel tolerance. Segments appended after Build() are tested linearly until
+// NeedsRebuild() asks for a rebuild. Removals are patched in place: the
+// removed segments' leaf entries are blanked and renumbered segments are
+// relabelled, until enough entries are blank to be worth a rebuild.
+class LineBVH {
+public:
+    LineBVH();
+
+    // Rebuild the tree over all segments. O(N log N).
+    void Build(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+    // True if the segment set shrank other than through LineRemoved() or
+    // LinesRemoved() (indices are stale), or too many segments are appended
+    // or blanked out to keep patching
+    bool NeedsRebuild(size_t lineCount) const;
+
+    // Re-fit bounds after the endpoints of one indexed segment changed. O(depth).
+    void Refit(size_t lineIndex, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+    // The segment at lineIndex was removed and the one at lastIndex moved
+    // into its index, as LineStore::Remove(index) does; positions and
+    // indices are the state after the removal. A moved segment that was not
+    // indexed yet takes over the freed leaf entry. O(depth).
+    void LineRemoved(size_t lineIndex, size_t lastIndex,
+                     const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+    // Segments were removed by LineStore::Remove(ids); newIndexOfLine maps
+    // each old index to its new one, or InvalidHandleSlot. Relabels the
+    // entries without re-sorting. O(N).
+    void LinesRemoved(const std::vector<uint32_t>& newIndexOfLine);
+
+    // Index of the front-most segment under the cursor, else of the one
+    // nearest to the ray on screen, or -1 if none is within tolerancePixels
+    int Pick(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+             const PickRay& ray, float tolerancePixels) const;
+
+    size_t GetNodeCount() const { return m_nodes.size(); }
+
+private:
+    // Interior nodes have count == 0 and children at first and first + 1;
+    // leaves cover m_lineIndices[first .. first + count)
+    struct Node {
+        glm::vec3 boundsMin;
+        uint32_t first;
+        glm::vec3 boundsMax;
+        uint32_t count;
+    };
+
+    static constexpr uint32_t InvalidNode = 0xFFFFFFFF;
+
+    void Subdivide(uint32_t nodeIndex, const std::vector<glm::vec3>& centroids,
+                   const std::vector<glm::vec3>& boundsMin, const std::vector<glm::vec3>& boundsMax);
+    void FitLeaf(Node& node, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) const;
+
+    // Position of an indexed segment in m_lineIndices
+    uint32_t EntryOf(uint32_t lineIndex) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_lineIndices;  // leaf-ordered segment indices
+    std::vector<uint32_t> m_parents;      // per node; InvalidNode for the root
+    std::vector<uint32_t> m_leafOfLine;   // per indexed segment
+    size_t m_removedEntries;              // blanked m_lineIndices entries
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef LINESTORE_H
+#define LINESTORE_H
+
+#include <cstdint>
+#include <vector>
+#include "DynamicBitset.h"
+#include "HandleTable.h"
+
+// Stable handle of a line; survives removal of other lines and never
+// resolves again once its own line is removed
+using LineId = Handle<struct LineTag>;
+constexpr LineId InvalidLineId{};
+
+// Structure-of-arrays line storage. Lines are edges between points: each
+// stores the indices of its two points in the PointStore (start at 2*i, end
+// at 2*i+1), which is exactly the GL_LINES element buffer layout. Positions
+// live only in the PointStore, so a moved point drags its lines along and
+// shared endpoints are stored once.
+//
+// Every point heads a list of its incident line ends, threaded through the
+// lines themselves, so adjacency costs one index per point plus one per
+// line end. Removal is O(1) plus the endpoints' degree: the last line is
+// moved into the freed index.
+class LineStore {
+public:
+    LineId Add(uint32_t startPoint, uint32_t endPoint);
+    
+    // Bulk append of count lines from point index pairs (start at 2*i, end
+    // at 2*i+1). ids, if given, receives the new handles in order.
+    void Add(const uint32_t* endpoints, size_t count, std::vector<LineId>* ids = nullptr);
+    
+    // Swap-and-pop: the last line moves to index, every handle stays valid
+    void Remove(size_t index);
+    
+    // Bulk removal: one compacting pass over the store, survivors keep
+    // their order. Stale handles are ignored. newIndexOfLine, if given,
+    // receives each old index's new index (InvalidHandleSlot if removed).
+    void Remove(const std::vector<LineId>& ids, std::vector<uint32_t>* newIndexOfLine = nullptr);
+    void Clear();
+    void Reserve(size_t count);
+    
+    size_t Size() const { return m_handles.Size(); }
+    bool Empty() const { return m_handles.Size() == 0; }
+    
+    // Endpoints as point indices
+    uint32_t GetStartPoint(size_t index) const { return m_indices[index * 2]; }
+    uint32_t GetEndPoint(size_t index) const { return m_indices[index * 2 + 1]; }
+    const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+    
+    // Adjacency: calls visit(lineIndex) for every line touching a point
+    template <typename Visitor>
+    void ForEachLineAt(uint32_t point, Visitor visit) const {
+        if (point >= m_firstEndAtPoint.size()) {
+            return;
+        }
+        for (uint32_t end = m_firstEndAtPoint[point]; end != NoEnd; end = m_nextEnd[end]) {
+            visit(static_cast<size_t>(end >> 1));
+        }
+    }
+    
+    // Keep endpoint indices in step with the PointStore: the point at index
+    // from now lives at index to (which must have no lines left), or every
+    // point moved to newIndexOfPoint[old] in a bulk compaction
+    void MovePoint(uint32_t from, uint32_t to);
+    void RemapPoints(const std::vector<uint32_t>& newIndexOfPoint);
+    
+    // Flags
+    bool IsSelected(size_t index) const { return m_selected.Test(index); }
+    void SetSelected(size_t index, bool selected) { m_selected.Set(index, selected); }
+    bool IsHovered(size_t index) const { return m_hovered.Test(index); }
+    void SetHovered(size_t index, bool hovered) { m_hovered.Set(index, hovered); }
+    void ClearSelection() { m_selected.ResetAll(); }
+    void ClearHover() { m_hovered.ResetAll(); }
+    
+    // Stable handles
+    LineId GetId(size_t index) const { return m_handles.GetHandle(index); }
+    int IndexOf(LineId id) const { return m_handles.IndexOf(id); }
+    
+private:
+    static constexpr uint32_t NoEnd = 0xFFFFFFFFu;
+    
+    void LinkEnd(uint32_t end);
+    void UnlinkEnd(uint32_t end);
+    void RelinkEnd(uint32_t from, uint32_t to);
+    void RebuildAdjacency();
+    
+    std::vector<uint32_t> m_indices;
+    DynamicBitset m_selected;
+    DynamicBitset m_hovered;
+    HandleTable<LineId> m_handles;
+    
+    // Line end e is end (e & 1) of line (e >> 1). Each point heads a singly
+    // linked list of its ends; m_nextEnd is parallel to m_indices.
+    std::vector<uint32_t> m_firstEndAtPoint;
+    std::vector<uint32_t> m_nextEnd;
+};
+
+#endif
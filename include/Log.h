@@ -0,0 +1,76 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <cstdint>
+
+// Compile-time log levels. Statements below MESHENGINE_LOG_LEVEL expand to
+// nothing (arguments are not evaluated). Override with -DMESHENGINE_LOG_LEVEL=...
+#define MESHENGINE_LOG_LEVEL_TRACE 0
+#define MESHENGINE_LOG_LEVEL_DEBUG 1
+#define MESHENGINE_LOG_LEVEL_INFO  2
+#define MESHENGINE_LOG_LEVEL_WARN  3
+#define MESHENGINE_LOG_LEVEL_ERROR 4
+#define MESHENGINE_LOG_LEVEL_OFF   5
+
+#ifndef MESHENGINE_LOG_LEVEL
+#define MESHENGINE_LOG_LEVEL MESHENGINE_LOG_LEVEL_INFO
+#endif
+
+enum class LogLevel {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+// Asynchronous logger. Write() formats into a fixed-size slot of a lock-free
+// ring buffer and returns immediately; a background thread drains the ring to
+// stdout/stderr. When the ring is full the message is dropped (and counted)
+// rather than blocking the caller.
+class Logger {
+public:
+    static void Write(LogLevel level, const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+    
+    // Block until every queued message has been written
+    static void Flush();
+    
+    // Number of messages dropped because the ring buffer was full
+    static uint64_t GetDroppedCount();
+};
+
+#if MESHENGINE_LOG_LEVEL <= MESHENGINE_LOG_LEVEL_TRACE
+#define LOG_TRACE(...) Logger::Write(LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if MESHENGINE_LOG_LEVEL <= MESHENGINE_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::Write(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if MESHENGINE_LOG_LEVEL <= MESHENGINE_LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::Write(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if MESHENGINE_LOG_LEVEL <= MESHENGINE_LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::Write(LogLevel::Warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if MESHENGINE_LOG_LEVEL <= MESHENGINE_LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::Write(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#endif
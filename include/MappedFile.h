@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap, or a file mapping view on
+// Windows). Opening costs the same for any size; pages are read from disk
+// when first touched.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Logs and returns false if the file is missing or cannot be mapped. An
+    // empty file opens without a mapping: GetSize() is 0 and GetData() null.
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+
+    const uint8_t* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+    // Paging hints, ignored where unsupported: read ahead aggressively, or
+    // drop the pages of a range that has been consumed
+    void AdviseSequential() const;
+    void Release(size_t offset, size_t size) const;
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include <glad/gl.h>
+#include <map>
+
+// Primitives shared by every instance that draws them
+enum class Primitive {
+    Sphere
+};
+
+// Indexed GPU mesh: positions (x, y, z) in vbo, triangle indices in ebo
+struct Mesh {
+    GLuint vbo;
+    GLuint ebo;
+    GLsizei vertexCount;
+    GLsizei indexCount;
+};
+
+// Process-wide cache that builds each primitive mesh once, on first use.
+// Requires a current GL context for Get() and Release().
+class MeshCache {
+public:
+    // World-space radius of the shared point sphere
+    static constexpr float SphereRadius = 0.1f;
+    
+    static MeshCache& Instance();
+    
+    const Mesh& Get(Primitive primitive);
+    
+    // Delete all cached GL objects (call before the context is destroyed)
+    void Release();
+    
+private:
+    MeshCache() = default;
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+    
+    Mesh BuildSphere();
+    
+    std::map<Primitive, Mesh> m_meshes;
+};
+
+#endif
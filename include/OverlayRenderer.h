@@ -0,0 +1,75 @@
+#ifndef OVERLAYRENDERER_H
+#define OVERLAYRENDERER_H
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include "Shader.h"
+
+// Core-profile 2D overlay: solid rectangles and bitmap text share one
+// font atlas texture and one vertex stream, so everything queued during a
+// frame is drawn with a single glDrawArrays call in Flush().
+//
+// Coordinates are window pixels with the origin at the bottom-left, the
+// same convention UIComponent uses.
+class OverlayRenderer {
+public:
+    // Baked font metrics, in atlas texels
+    static constexpr int GlyphWidth = 5;
+    static constexpr int GlyphHeight = 7;
+    static constexpr int GlyphAdvance = GlyphWidth + 1;
+
+    OverlayRenderer();
+    ~OverlayRenderer();
+
+    void Initialize();
+
+    // Start a new frame of overlay geometry for a window of the given size
+    void Begin(int windowWidth, int windowHeight);
+
+    // Queue a filled rectangle; (x, y) is the bottom-left corner
+    void AddRect(float x, float y, float width, float height, const glm::vec4& color);
+
+    // Queue a rectangle outline built from four thin filled rectangles
+    void AddRectOutline(float x, float y, float width, float height, float thickness, const glm::vec4& color);
+
+    // Queue a line of text; (x, y) is the bottom-left of the first glyph
+    // and each atlas texel covers scale x scale pixels
+    void AddText(const std::string& text, float x, float y, float scale, const glm::vec4& color);
+
+    // Size in pixels of text queued with the same scale
+    glm::vec2 MeasureText(const std::string& text, float scale) const;
+
+    // Upload (only if changed since the last frame) and draw everything queued
+    void Flush();
+
+private:
+    void InitializeShader();
+    void InitializeAtlas();
+    void InitializeBuffers();
+    void AddQuad(float x0, float y0, float x1, float y1,
+                 float u0, float v0, float u1, float v1, const glm::vec4& color);
+
+    bool m_initialized;
+    std::unique_ptr<Shader> m_shader;
+    GLint m_projectionLoc;
+    GLint m_atlasLoc;
+    GLuint m_atlasTexture;
+    GLuint m_vao;
+    GLuint m_vbo;
+    size_t m_bufferCapacity;  // bytes allocated in m_vbo
+
+    int m_windowWidth;
+    int m_windowHeight;
+    int m_projectionWidth;    // window size the projection uniform was set for
+    int m_projectionHeight;
+
+    // Queued vertices (x, y, u, v, r, g, b, a) and a copy of what the GPU
+    // buffer currently holds, so static overlays skip the upload entirely
+    std::vector<float> m_vertices;
+    std::vector<float> m_uploadedVertices;
+};
+
+#endif
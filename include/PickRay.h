@@ -0,0 +1,61 @@
+#ifndef PICKRAY_H
+#define PICKRAY_H
+
+#include <glm/glm.hpp>
+
+// World-space ray under a cursor position, plus the camera terms needed to
+// convert between world distances and screen pixels along it. Shared by the
+// point and line pickers so both apply the same pixel tolerance.
+struct PickRay {
+    glm::vec3 origin;      // cursor unprojected onto the near plane
+    glm::vec3 direction;   // unit length, towards the far plane
+    float length;          // near plane to far plane along the ray
+    float nearDepth;       // view depth of origin
+    float cosTheta;        // view depth gained per unit along the ray
+    float pixelScale;      // pixels per world unit at view depth 1
+
+    // View depth of the ray point at parameter t
+    float DepthAt(float t) const { return nearDepth + t * cosTheta; }
+
+    // World distance covered by the given number of pixels at parameter t.
+    // Uses nearDepth + t (>= DepthAt(t)) so it is safe as a search bound.
+    float WorldRadiusAt(float t, float pixels) const { return pixels * (nearDepth + t) / pixelScale; }
+
+    // screenPos is in viewport pixels with a top-left origin.
+    // Returns false for a degenerate viewport or projection.
+    static bool FromScreen(const glm::mat4& view, const glm::mat4& projection,
+                           const glm::vec2& screenPos, const glm::vec2& viewportSize,
+                           PickRay& ray) {
+        if (viewportSize.x <= 0.0f || viewportSize.y <= 0.0f) {
+            return false;
+        }
+
+        // Unproject the cursor onto the near and far planes
+        glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+        float ndcX = 2.0f * screenPos.x / viewportSize.x - 1.0f;
+        float ndcY = 1.0f - 2.0f * screenPos.y / viewportSize.y;
+        glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+        glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+        glm::vec3 origin = glm::vec3(nearPoint.x, nearPoint.y, nearPoint.z) / nearPoint.w;
+        glm::vec3 direction = glm::vec3(farPoint.x, farPoint.y, farPoint.z) / farPoint.w - origin;
+        float length = glm::length(direction);
+        if (!(length > 0.0f)) {
+            return false;
+        }
+
+        // Camera frame, used to turn distance along the ray into view depth
+        glm::mat4 inverseView = glm::inverse(view);
+        glm::vec3 eye(inverseView[3].x, inverseView[3].y, inverseView[3].z);
+        glm::vec3 forward(-view[0][2], -view[1][2], -view[2][2]);
+
+        ray.origin = origin;
+        ray.direction = direction / length;
+        ray.length = length;
+        ray.nearDepth = glm::dot(origin - eye, forward);
+        ray.cosTheta = glm::dot(ray.direction, forward);
+        ray.pixelScale = projection[1][1] * viewportSize.y * 0.5f;
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+#include <cstdint>
+#include <string>
+
+// Write 8-bit RGBA pixels to a PNG file. Rows are given bottom-up, as
+// glReadPixels returns them, and written top-down. The image data uses
+// uncompressed deflate blocks: no zlib dependency, and the files are only
+// frame dumps for inspection. Returns false if the file cannot be written.
+bool WritePng(const std::string& path, int width, int height, const uint8_t* rgba);
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef POINTLOD_H
+#define POINTLOD_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// How a chunk of points is drawn this frame
+enum class PointLodLevel : uint8_t {
+    Geometry,   // instanced sphere meshes, up close
+    Impostor,   // point sprites shaded as spheres in the fragment shader
+    Dot,        // flat GL_POINTS a pixel or two wide
+    Culled      // outside the view frustum
+};
+
+// Camera and viewport a selection is made for
+struct PointLodView {
+    glm::mat4 viewProjection;
+    glm::vec3 eye;
+    float pixelsPerUnit;    // projected size in pixels of one world unit at distance 1
+    float viewportPixels;   // viewport area
+    float pointRadius;      // world-space radius of a point
+};
+
+// Contiguous run of slots to draw, in the slot order of GetSlots()
+struct PointLodRange {
+    uint32_t first;
+    uint32_t count;
+};
+
+struct PointLodStats {
+    size_t chunks = 0;
+    size_t culledChunks = 0;
+    size_t geometryPoints = 0;
+    size_t impostorPoints = 0;
+    size_t dotPoints = 0;
+    size_t skippedPoints = 0;   // left out of subsampled chunks
+};
+
+// Output of Select(), reused across frames to keep its storage
+struct PointLodSelection {
+    std::vector<glm::vec3> geometryPositions;   // gathered, one sphere instance each
+    std::vector<PointLodRange> impostors;
+    std::vector<PointLodRange> dots;
+    PointLodStats stats;
+};
+
+// Level-of-detail selection for large point clouds.
+//
+// Points are grouped into spatially compact chunks of ChunkSize: a counting
+// sort over a Morton-ordered grid puts nearby points in neighboring slots,
+// and GetSlots() maps each slot to its point index, ready for an element
+// buffer. Every frame, Select() culls chunks against the frustum and picks
+// a level per chunk from the projected size of a point at the chunk's
+// nearest distance to the camera: real geometry while a point covers more
+// than GeometryPixels, impostors down to ImpostorPixels, then dots.
+//
+// Points within a sorted chunk are shuffled, so any prefix of a chunk is
+// an even sample of it. Impostor and dot chunks draw only the prefix that
+// covers their screen footprint CoverageFactor times over; what is drawn
+// is bounded by the viewport's pixels rather than the cloud's size.
+//
+// Points appended after Build() go into new chunks in store order and are
+// always drawn in full; Update() re-sorts once they outgrow the sorted
+// part. A moved point only grows its chunk's bounds, and a removed point's
+// slot is refilled from the last slot, so edits stay O(1).
+class PointLod {
+public:
+    static constexpr uint32_t ChunkSize = 4096;
+
+    // Projected point radius, in pixels, at which a chunk switches level
+    static constexpr float GeometryPixels = 12.0f;
+    static constexpr float ImpostorPixels = 1.5f;
+
+    // Sphere meshes drawn per frame at most; the nearest chunks get them
+    // and the rest fall back to impostors
+    static constexpr size_t GeometryBudget = 32768;
+
+    static constexpr float CoverageFactor = 2.0f;
+
+    PointLod();
+
+    // Sort every point into chunks. O(N).
+    void Build(const std::vector<glm::vec3>& positions);
+
+    // Bring the chunks up to date with positions: rebuilt after Invalidate()
+    // or when appended points outgrow the sorted part, otherwise appended
+    // points are chunked in store order. Appends dirtySlots with the slot
+    // ranges changed since the last call, which must be re-uploaded.
+    void Update(const std::vector<glm::vec3>& positions, std::vector<PointLodRange>& dirtySlots);
+
+    // Point indices changed wholesale (bulk removal, clear); rebuild on the
+    // next Update()
+    void Invalidate() { m_valid = false; }
+
+    // A point moved; its chunk's bounds grow to include it. O(1).
+    void PointMoved(uint32_t pointIndex, const glm::vec3& position);
+
+    // The point at pointIndex was removed and the last point moved into its
+    // index, as PointStore::Remove() does; positions is the store after the
+    // removal. O(1).
+    void PointRemoved(uint32_t pointIndex, const std::vector<glm::vec3>& positions);
+
+    void Select(const std::vector<glm::vec3>& positions, const PointLodView& view, PointLodSelection& selection) const;
+
+    // Point index for every slot
+    const std::vector<uint32_t>& GetSlots() const { return m_slots; }
+
+private:
+    struct Chunk {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        bool shuffled;      // any prefix is an even sample; false once points are appended
+    };
+
+    void AppendSlots(const std::vector<glm::vec3>& positions, size_t begin, size_t end);
+
+    std::vector<uint32_t> m_slots;          // slot -> point index
+    std::vector<uint32_t> m_slotOfPoint;    // point index -> slot
+    std::vector<Chunk> m_chunks;            // chunk c covers slots [c * ChunkSize, (c + 1) * ChunkSize)
+    size_t m_sortedCount;                   // slots placed by the last Build()
+    size_t m_refilledSlots;                 // removals since, each moving a point between chunks
+    bool m_valid;
+    std::vector<PointLodRange> m_dirtySlots;
+
+    // Select() scratch
+    mutable std::vector<std::pair<float, uint32_t>> m_geometryCandidates;
+};
+
+#endif
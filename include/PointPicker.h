@@ -0,0 +1,104 @@
+#ifndef POINTPICKER_H
+#define POINTPICKER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "PickRay.h"
+
+// Screen-space point picking over a uniform grid.
+//
+// Build() buckets point indices into a grid over the points' bounding box
+// (CSR layout: per-cell offsets into one flat index array). Pick() casts the
+// mouse ray through the view-projection, clips it against the grid bounds
+// and marches along it, visiting only the cells inside the pick cone. Each
+// candidate is projected with the real view-projection matrix and accepted
+// if its projected sphere lies within the pixel tolerance of the cursor.
+// The front-most accepted point wins, which lets the march stop early.
+//
+// Points appended after Build() are tested linearly until NeedsRebuild()
+// says the unindexed tail has grown enough to be worth a rebuild, so adding
+// points one at a time does not cost an O(N) rebuild per pick. Single
+// removals are patched in place the same way: the removed point's grid
+// entry is blanked and the point renumbered into its index is relabelled,
+// or joins a loose list tested linearly if it was not indexed yet. A moved
+// point's entry is blanked and the point joins the loose list.
+class PointPicker {
+public:
+    PointPicker();
+
+    // Rebuild the grid for the given positions. O(N); call after the point
+    // set changes and before the next Pick().
+    void Build(const std::vector<glm::vec3>& positions);
+
+    // True if the point set shrank other than through PointRemoved()
+    // (indices are stale), or too many points are appended, loose or
+    // blanked out to keep patching
+    bool NeedsRebuild(size_t pointCount) const;
+
+    // A point moved; it leaves its cell for the loose list. O(1).
+    void PointMoved(uint32_t pointIndex);
+
+    // The point at pointIndex was removed and the last point moved into its
+    // index, as PointStore::Remove() does; pointCount is the count after the
+    // removal. O(1).
+    void PointRemoved(uint32_t pointIndex, size_t pointCount);
+
+    // Returns the index of the front-most point under the cursor, or -1.
+    // screenPos is in viewport pixels with a top-left origin.
+    int Pick(const std::vector<glm::vec3>& positions,
+             const glm::mat4& view, const glm::mat4& projection,
+             const glm::vec2& screenPos, const glm::vec2& viewportSize,
+             float tolerancePixels, float pointRadius);
+
+    // Every point whose projected sphere reaches within tolerancePixels of
+    // the cursor, in no particular order: the points a GPU pick pass around
+    // the cursor has to draw. Same search as Pick() without its early out.
+    void Collect(const std::vector<glm::vec3>& positions,
+                 const glm::mat4& view, const glm::mat4& projection,
+                 const glm::vec2& screenPos, const glm::vec2& viewportSize,
+                 float tolerancePixels, float pointRadius, std::vector<uint32_t>& indices);
+
+    size_t GetCellCount() const { return m_cellStamps.size(); }
+
+private:
+    // Calls testPoint(index, position) for every point the pick cone may
+    // reach, nearest cells first, until the cone lies entirely behind
+    // cutoffDepth()
+    template <typename Test, typename CutoffDepth>
+    void March(const std::vector<glm::vec3>& positions, const PickRay& ray, float tolerancePixels, float pointRadius,
+               Test testPoint, CutoffDepth cutoffDepth);
+
+    int CellIndex(int x, int y, int z) const { return (z * m_dims[1] + y) * m_dims[0] + x; }
+
+    // Drop an indexed point's grid or loose entry
+    void Unlink(uint32_t pointIndex);
+
+    glm::vec3 m_boundsMin;
+    glm::vec3 m_boundsMax;
+    glm::vec3 m_cellSize;
+    glm::vec3 m_inverseCellSize;
+    int m_dims[3];
+
+    // Points of cell c are m_cellPoints[m_cellStart[c] .. m_cellStart[c + 1]);
+    // entries of moved or removed points are RemovedEntry. m_cellPositions
+    // holds each entry's position as of Build(), so a march reads points
+    // cell by cell instead of scattered across the caller's array.
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_cellPoints;
+    std::vector<glm::vec3> m_cellPositions;
+    size_t m_removedEntries;
+
+    // Points [0, m_indexedCount) are in a cell or in m_loosePoints; later
+    // ones are the unindexed tail. m_pointSlots[i] is point i's position in
+    // m_cellPoints, or LooseSlot | its position in m_loosePoints.
+    size_t m_indexedCount;
+    std::vector<uint32_t> m_pointSlots;
+    std::vector<uint32_t> m_loosePoints;
+
+    // Per-cell visit stamp for the current Pick(); avoids clearing between picks
+    std::vector<uint32_t> m_cellStamps;
+    uint32_t m_currentStamp;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef POINTSTORE_H
+#define POINTSTORE_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "DynamicBitset.h"
+#include "HandleTable.h"
+
+// Stable handle of a point; survives removal of other points and never
+// resolves again once its own point is removed
+using PointId = Handle<struct PointTag>;
+constexpr PointId InvalidPointId{};
+
+// Structure-of-arrays point storage. Positions are contiguous (and laid out
+// exactly as the GPU instance buffer expects), flags are packed bitsets, and
+// every point carries a generational handle that maps back to its current
+// index. Removal is O(1): the last point is moved into the freed index.
+class PointStore {
+public:
+    PointId Add(const glm::vec3& position);
+    
+    // Bulk append: the arrays grow once for the whole batch. ids, if given,
+    // receives the new handles in order.
+    void Add(const glm::vec3* positions, size_t count, std::vector<PointId>* ids = nullptr);
+    
+    // Swap-and-pop: the last point moves to index, every handle stays valid
+    void Remove(size_t index);
+    
+    // Bulk removal: one compacting pass over the store, survivors keep
+    // their order. Stale handles are ignored. newIndexOfPoint, if given,
+    // receives each old index's new index (InvalidHandleSlot if removed).
+    void Remove(const std::vector<PointId>& ids, std::vector<uint32_t>* newIndexOfPoint = nullptr);
+    void Clear();
+    void Reserve(size_t count);
+    
+    size_t Size() const { return m_positions.size(); }
+    bool Empty() const { return m_positions.empty(); }
+    
+    // Positions
+    const glm::vec3& GetPosition(size_t index) const { return m_positions[index]; }
+    void SetPosition(size_t index, const glm::vec3& position) { m_positions[index] = position; }
+    const std::vector<glm::vec3>& GetPositions() const { return m_positions; }
+    
+    // Flags
+    bool IsSelected(size_t index) const { return m_selected.Test(index); }
+    void SetSelected(size_t index, bool selected) { m_selected.Set(index, selected); }
+    bool IsHovered(size_t index) const { return m_hovered.Test(index); }
+    void SetHovered(size_t index, bool hovered) { m_hovered.Set(index, hovered); }
+    void ClearSelection() { m_selected.ResetAll(); }
+    
+    // Calls visit(index) for every selected point, in index order
+    template <typename Visitor>
+    void ForEachSelected(Visitor visit) const { m_selected.ForEachSet(visit); }
+    void ClearHover() { m_hovered.ResetAll(); }
+    
+    // Stable handles
+    PointId GetId(size_t index) const { return m_handles.GetHandle(index); }
+    int IndexOf(PointId id) const { return m_handles.IndexOf(id); }
+    
+private:
+    std::vector<glm::vec3> m_positions;
+    DynamicBitset m_selected;
+    DynamicBitset m_hovered;
+    HandleTable<PointId> m_handles;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Frame profiler. Build with -DMESHENGINE_PROFILER=0 and every PROFILE_*
+// macro expands to nothing and the Profiler class is not declared.
+#ifndef MESHENGINE_PROFILER
+#define MESHENGINE_PROFILER 1
+#endif
+
+#if MESHENGINE_PROFILER
+
+#include <glad/gl.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class OverlayRenderer;
+
+// One closed zone on the profiler timeline (nanoseconds since start-up)
+struct ProfileEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+    uint32_t depth;
+};
+
+// Scoped CPU zones and GPU timer queries, exported as a Chrome trace.
+//
+// CPU zones are written by the thread that closes them into its own ring
+// buffer, so recording takes no lock: two clock reads and one store. When a
+// ring wraps, its oldest zones are overwritten.
+//
+// GPU zones bracket GL work with GL_TIMESTAMP queries from a pool holding
+// a few frames. A frame's queries are read back only after the GPU has
+// finished them, checked without blocking when later frames end. A frame
+// whose results are still missing when its pool slot comes round again
+// is dropped rather than stalling the pipeline.
+class Profiler {
+public:
+    static Profiler& Instance();
+
+    // Nanoseconds since the profiler was first used
+    static uint64_t Now();
+
+    // Used by ProfileScope: open a zone on the calling thread (returns its
+    // nesting depth) and close it again
+    static uint32_t EnterZone();
+    static void LeaveZone(const char* name, uint64_t startNs, uint32_t depth);
+
+    // Used by GpuProfileScope on the GL thread, between BeginFrame() and
+    // EndFrame(). BeginGpuZone() returns -1 when the frame's pool is full.
+    int BeginGpuZone(const char* name);
+    void EndGpuZone(int zone);
+
+    // Bracket the work of one rendered frame (main thread)
+    void BeginFrame();
+    void EndFrame();
+
+    // Rolling frame-time graph, drawn in window pixels with (x, y) at its
+    // bottom-left corner
+    void ToggleOverlay() { m_overlayVisible = !m_overlayVisible; }
+    bool IsOverlayVisible() const { return m_overlayVisible; }
+    void DrawOverlay(OverlayRenderer& overlay, float x, float y) const;
+
+    // Write every recorded zone as Chrome trace JSON (chrome://tracing,
+    // Perfetto). Zones still being written by other threads may be torn.
+    bool ExportChromeTrace(const std::string& path) const;
+
+    // Delete the GL query pool; call while the context is still current
+    void ReleaseGpuQueries();
+
+    static constexpr int HistorySize = 120;
+
+private:
+    Profiler();
+
+    static constexpr size_t ThreadRingSize = size_t(1) << 16;
+    static constexpr int MaxGpuZones = 32;
+    static constexpr int GpuFrameLatency = 4;
+
+    struct ThreadBuffer {
+        uint32_t threadIndex;
+        uint32_t depth;
+        std::unique_ptr<ProfileEvent[]> events;
+        std::atomic<uint64_t> written;
+    };
+
+    struct GpuFrame {
+        GLuint queries[MaxGpuZones * 2];
+        const char* names[MaxGpuZones];
+        uint32_t depths[MaxGpuZones];
+        int zoneCount;
+        GLuint lastQuery;   // completes after every other query of the frame
+        uint64_t frameIndex;
+        bool pending;
+    };
+
+    static ThreadBuffer& CurrentThreadBuffer();
+    static void Record(ThreadBuffer& buffer, const ProfileEvent& event);
+
+    bool InitializeGpuQueries();
+    bool HarvestGpuFrame(GpuFrame& frame);
+
+    // Every thread that ever recorded a zone; buffers outlive their threads
+    mutable std::mutex m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+    // GPU timeline, kept as one more ring on its own trace track
+    ThreadBuffer m_gpuBuffer;
+    GpuFrame m_gpuFrames[GpuFrameLatency];
+    bool m_gpuQueriesReady;
+    bool m_gpuQueriesFailed;
+    int64_t m_gpuClockOffsetNs;   // GL timestamp minus profiler time
+    uint32_t m_gpuDepth;
+    uint64_t m_droppedGpuFrames;
+
+    // Frame history for the overlay, indexed by frame % HistorySize
+    uint64_t m_frameIndex;
+    uint64_t m_frameStartNs;
+    bool m_inFrame;
+    float m_cpuFrameMs[HistorySize];
+    float m_gpuFrameMs[HistorySize];
+    bool m_overlayVisible;
+};
+
+// Times the enclosing scope on the calling thread
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(name), m_depth(Profiler::EnterZone()), m_start(Profiler::Now()) {}
+    ~ProfileScope() { Profiler::LeaveZone(m_name, m_start, m_depth); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    uint32_t m_depth;
+    uint64_t m_start;
+};
+
+// Times the GL commands issued in the enclosing scope
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name) : m_zone(Profiler::Instance().BeginGpuZone(name)) {}
+    ~GpuProfileScope() { Profiler::Instance().EndGpuZone(m_zone); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    int m_zone;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+#define PROFILE_FRAME_BEGIN() Profiler::Instance().BeginFrame()
+#define PROFILE_FRAME_END() Profiler::Instance().EndFrame()
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_GPU_SCOPE(name) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+
+#endif
+
+#endif
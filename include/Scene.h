@@ -3,50 +3,152 @@
 
 #include <vector>
 #include <memory>
-#include "Point.h"
-#include "Line.h"
+#include "PointStore.h"
+#include "LineStore.h"
+#include "HalfEdgeMesh.h"
+#include "PointPicker.h"
+#include "LineBVH.h"
+#include "PointLod.h"
+#include "GpuPicker.h"
 #include "Camera.h"
 #include "Shader.h"
 
+// How UpdateHover() finds the point or line under the cursor
+enum class HoverPicking {
+    Cpu,    // Ray queries against the point grid and line BVH, answered immediately
+    Gpu     // ID-buffer pass with asynchronous readback, applied in Update()
+};
+
 class Scene {
 public:
     Scene();
     ~Scene();
     
     void Initialize();
+    
+    // Applies finished GPU hover readbacks and issues new picking passes
     void Update();
     void Render();
     
-    // Point management
-    void AddPoint(const glm::vec3& position);
+    // Point management. Removal is O(1) and moves the last point into the
+    // freed index; hold a PointId rather than an index across edits.
+    // Removing a point also removes every line that touches it.
+    PointId AddPoint(const glm::vec3& position);
+    
+    // Bulk insertion for imports and generators: storage grows once and the
+    // batch goes to the GPU in one transfer on the next frame. ids, if
+    // given, receives the new handles in order.
+    void AddPoints(const glm::vec3* positions, size_t count, std::vector<PointId>* ids = nullptr);
+    void AddPoints(const std::vector<glm::vec3>& positions, std::vector<PointId>* ids = nullptr) {
+        AddPoints(positions.data(), positions.size(), ids);
+    }
+    
+    // Make room for count points in total ahead of a large import, so
+    // neither the store nor the GPU instance buffer regrows part way
+    void ReservePoints(size_t count);
     void RemovePoint(int index);
+    void RemovePoint(PointId id);
+    void RemovePoints(const std::vector<PointId>& ids);
     void SelectPoint(int index);
     void DeselectAll();
     
-    // Line management
-    void AddLine(const glm::vec3& start, const glm::vec3& end);
+    // Move a point; its lines follow. Only the point's own GPU data, its
+    // picking and level-of-detail entries and the bounds of its incident
+    // lines are updated.
+    void SetPointPosition(int index, const glm::vec3& position);
+    
+    // Line management. Lines connect two existing points; AddLine() returns
+    // InvalidLineId for stale handles or a point joined to itself.
+    LineId AddLine(PointId start, PointId end);
+    
+    // Bulk insertion of lineCount lines from endpoint pairs (start at 2*i,
+    // end at 2*i+1). Pairs AddLine() would reject are skipped and get
+    // InvalidLineId in ids.
+    void AddLines(const PointId* endpoints, size_t lineCount, std::vector<LineId>* ids = nullptr);
+    void AddLines(const std::vector<PointId>& endpoints, std::vector<LineId>* ids = nullptr) {
+        AddLines(endpoints.data(), endpoints.size() / 2, ids);
+    }
+    
+    // Bulk insertion from current point indices (start at 2*i, end at
+    // 2*i+1), as files store them. Out-of-range and degenerate pairs are
+    // skipped.
+    void AddIndexedLines(const uint32_t* pointIndices, size_t lineCount);
     void RemoveLine(int index);
+    void RemoveLine(LineId id);
+    void RemoveLines(const std::vector<LineId>& ids);
     void SelectLine(int index);
     
+    // Triangle mesh drawn beside the points and lines. The arrays are taken
+    // over, so pass them with std::move; returns false for an index that is
+    // out of range, leaving the scene without a mesh.
+    bool SetMesh(std::vector<glm::vec3> positions, std::vector<uint32_t> indices);
+    
+    // Take over a mesh built elsewhere, e.g. on a loader thread
+    void SetMesh(HalfEdgeMesh mesh);
+    void ClearMesh();
+    
+    // Remove every point, line and the mesh; outstanding handles go stale
+    void Clear();
+    
     // Getters
-    const std::vector<std::unique_ptr<Point>>& GetPoints() const { return m_points; }
-    const std::vector<std::unique_ptr<Line>>& GetLines() const { return m_lines; }
+    const PointStore& GetPoints() const { return m_points; }
+    const LineStore& GetLines() const { return m_lines; }
+    const HalfEdgeMesh& GetMesh() const { return m_mesh; }
     Camera& GetCamera() { return *m_camera; }
     
-    // Point selection by screen position
+    // Point selection by screen position (viewport pixels, top-left origin).
+    // Returns the front-most point whose sphere is within a few pixels of the
+    // cursor under the current camera, or -1.
     int GetPointAtScreenPosition(double screenX, double screenY, int viewportWidth, int viewportHeight);
     
+    // Line nearest to the cursor on screen, within a few pixels, or -1
+    int GetLineAtScreenPosition(double screenX, double screenY, int viewportWidth, int viewportHeight);
+    
+    // Track the point or line under the cursor (points take precedence).
+    // In GPU mode this only records the cursor; the result arrives through
+    // Update() a frame or two later.
+    void UpdateHover(double screenX, double screenY, int viewportWidth, int viewportHeight);
+    void ClearHover();
+    
+    // Select the hover picking method; needs a current context. Falls back
+    // to CPU picking if the GPU picker cannot be created.
+    void SetHoverPicking(HoverPicking mode);
+    HoverPicking GetHoverPicking() const { return m_hoverPicking; }
+    
+    // True while a GPU hover pick is queued or its readback is in flight
+    bool IsPickPending() const;
+    
+    // Level-of-detail point rendering (on by default): spheres up close,
+    // impostor sprites further out and dots in the distance, chosen per
+    // chunk every frame. Off draws every point as a sphere mesh.
+    void SetPointLod(bool enabled);
+    bool IsPointLodEnabled() const { return m_pointLodEnabled; }
+    
+    // What the last frame drew at each level
+    const PointLodStats& GetPointLodStats() const { return m_pointLodSelection.stats; }
+    
+    // Current indices of the hovered and selected elements, or -1
+    int GetHoveredPoint() const { return m_points.IndexOf(m_hoveredPoint); }
+    int GetHoveredLine() const { return m_lines.IndexOf(m_hoveredLine); }
+    int GetSelectedPoint() const { return m_points.IndexOf(m_selectedPoint); }
+    int GetSelectedLine() const { return m_lines.IndexOf(m_selectedLine); }
+    
     // Viewport management
     void UpdateViewport(int width, int height);
     
+    // True when scene contents or the camera changed since the last Render()
+    bool NeedsRedraw() const { return m_needsRedraw || (m_camera && m_camera->IsDirty()); }
+    
 private:
-    std::vector<std::unique_ptr<Point>> m_points;
-    std::vector<std::unique_ptr<Line>> m_lines;
+    PointStore m_points;
+    LineStore m_lines;
+    HalfEdgeMesh m_mesh;
     std::unique_ptr<Camera> m_camera;
     
     // Shaders
     std::unique_ptr<Shader> m_pointShader;
     std::unique_ptr<Shader> m_lineShader;
+    std::unique_ptr<Shader> m_meshShader;
     std::unique_ptr<Shader> m_gridShader;
     std::unique_ptr<Shader> m_axesShader;
     
@@ -58,17 +160,112 @@ private:
     GLuint m_axesVAO, m_axesVBO, m_axesColorVBO;
     int m_axesVertexCount;
     
-    // Selection state
-    int m_selectedPoint;
-    int m_selectedLine;
-    int m_hoveredPoint;
-    int m_hoveredLine;
+    // Selection state, held by handle so removals never retarget it
+    PointId m_selectedPoint;
+    LineId m_selectedLine;
+    PointId m_hoveredPoint;
+    LineId m_hoveredLine;
+    
+    // Set by every mutation, cleared once the change has been drawn
+    bool m_needsRedraw;
+    
+    // Instanced point rendering: one shared sphere mesh, one position per instance.
+    // [m_pointDirtyBegin, m_pointDirtyEnd) is the range of points awaiting upload.
+    GLuint m_pointVAO, m_pointInstanceVBO;
+    GLsizei m_pointMeshIndexCount;
+    size_t m_pointInstanceCapacity;
+    size_t m_pointDirtyBegin, m_pointDirtyEnd;
+    
+    // Level-of-detail points. The sprite levels draw GL_POINTS from the point
+    // instance buffer through m_pointLodEBO, which holds PointLod's slot
+    // order; the nearest chunks' positions are gathered into m_pointNearVBO
+    // each frame and drawn as sphere instances.
+    PointLod m_pointLod;
+    PointLodSelection m_pointLodSelection;
+    bool m_pointLodEnabled;
+    std::unique_ptr<Shader> m_pointImpostorShader;
+    std::unique_ptr<Shader> m_pointDotShader;
+    GLuint m_pointSpriteVAO, m_pointLodEBO;
+    size_t m_pointLodCapacity;
+    GLuint m_pointNearVAO, m_pointNearVBO;
+    std::vector<PointLodRange> m_pointLodDirty;
+    std::vector<GLsizei> m_drawCounts;
+    std::vector<const void*> m_drawOffsets;
+    int m_viewportWidth, m_viewportHeight;
+    
+    // Spatial index for screen-space picking; rebuilt lazily before a pick
+    PointPicker m_pointPicker;
+    bool m_pointPickerDirty;
+    std::vector<uint32_t> m_pickCandidates;
+    
+    // Segment hierarchy for line picking; refit in place when endpoints move
+    LineBVH m_lineBVH;
+    bool m_lineBVHDirty;
+    
+    // GPU hover picking: the latest cursor position and whether the ID pass
+    // needs to run again for it
+    HoverPicking m_hoverPicking;
+    GpuPicker m_gpuPicker;
+    bool m_gpuPickerInitialized;
+    bool m_hoverCursorValid;
+    bool m_gpuPickRequested;
+    double m_hoverX, m_hoverY;
+    int m_hoverViewportWidth, m_hoverViewportHeight;
+    
+    // Batched line rendering: one indexed GL_LINES draw whose vertices are the
+    // point instance buffer, so only point indices are stored per line.
+    // [m_lineDirtyBegin, m_lineDirtyEnd) is the range of lines awaiting upload.
+    GLuint m_lineVAO, m_lineEBO;
+    size_t m_lineCapacity;
+    size_t m_lineDirtyBegin, m_lineDirtyEnd;
+    GLint m_lineColorLoc;
+    
+    // Mesh rendering: the mesh's own position and index arrays uploaded
+    // as-is, drawn with one indexed GL_TRIANGLES call
+    GLuint m_meshVAO, m_meshVBO, m_meshEBO;
+    bool m_meshDirty;
+    
+    // Per-frame camera uniform buffer (std140 block "Camera": view, projection)
+    static constexpr GLuint CameraBlockBinding = 0;
+    GLuint m_cameraUBO;
     
     // Grid and axes methods
     void InitializeGrid();
     void InitializeAxes();
     void RenderGrid();
     void RenderAxes();
+    
+    // Point batch methods
+    void InitializePointBatch();
+    void MarkPointsDirty(size_t begin, size_t end);
+    void UploadPointInstances();
+    void RenderPoints();
+    
+    // Level-of-detail point methods
+    void InitializePointLod();
+    void RenderPointLod();
+    void DrawPointSprites(Shader& shader, const std::vector<PointLodRange>& ranges, float pixelsPerUnit);
+    
+    // Line batch methods
+    void InitializeLineBatch();
+    void MarkLinesDirty(size_t begin, size_t end);
+    void UploadLines();
+    void RenderLines();
+    
+    // Mesh methods
+    void InitializeMeshBatch();
+    void UploadMesh();
+    void RenderMesh();
+    
+    // Hover methods
+    void SetHover(int pointIndex, int lineIndex);
+    void UpdateGpuHover();
+    void RenderPickingPass();
+    void UpdatePointPicker();
+    
+    // Camera uniform block methods
+    void InitializeCameraBlock();
+    void UpdateCameraBlock();
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+
+class Scene;
+
+// Binary scene file, version 1. A 64-byte header is followed by one
+// section per array, each starting on a 64-byte boundary and holding the
+// array exactly as it is laid out in memory:
+//
+//   point positions    pointCount x vec3 (3 x float32)
+//   line endpoints     lineCount x 2 x uint32 point index
+//   mesh positions     meshVertexCount x vec3
+//   mesh triangles     meshTriangleCount x 3 x uint32 vertex index
+//
+// Everything is little-endian. The checksum is Fletcher-64 over the 32-bit
+// words after the header, padding included.
+struct SceneFileHeader {
+    char magic[8];                  // "MESHSCN\0"
+    uint32_t version;
+    uint32_t headerSize;            // sizeof(SceneFileHeader)
+    uint64_t pointCount;
+    uint64_t lineCount;
+    uint64_t meshVertexCount;
+    uint64_t meshTriangleCount;
+    uint64_t checksum;
+    uint64_t reserved;
+};
+static_assert(sizeof(SceneFileHeader) == 64, "scene file header must stay 64 bytes");
+
+// Read-only memory mapping of a scene file. Open() validates only the
+// header against the file size, so it takes the same time for any file;
+// section data is paged in when first read.
+class MappedSceneFile {
+public:
+    bool Open(const std::string& path);
+    void Close() { m_file.Close(); }
+    bool IsOpen() const { return m_file.IsOpen(); }
+
+    // Reads the whole file once; false if it does not match the header
+    bool VerifyChecksum() const;
+
+    size_t GetFileSize() const { return m_file.GetSize(); }
+    const SceneFileHeader& GetHeader() const { return *reinterpret_cast<const SceneFileHeader*>(m_file.GetData()); }
+
+    // Sections, pointing into the mapping
+    size_t GetPointCount() const { return static_cast<size_t>(GetHeader().pointCount); }
+    const glm::vec3* GetPointPositions() const { return reinterpret_cast<const glm::vec3*>(Section(m_pointsOffset)); }
+    size_t GetLineCount() const { return static_cast<size_t>(GetHeader().lineCount); }
+    const uint32_t* GetLineIndices() const { return reinterpret_cast<const uint32_t*>(Section(m_linesOffset)); }
+    size_t GetMeshVertexCount() const { return static_cast<size_t>(GetHeader().meshVertexCount); }
+    const glm::vec3* GetMeshPositions() const { return reinterpret_cast<const glm::vec3*>(Section(m_meshPositionsOffset)); }
+    size_t GetMeshTriangleCount() const { return static_cast<size_t>(GetHeader().meshTriangleCount); }
+    const uint32_t* GetMeshIndices() const { return reinterpret_cast<const uint32_t*>(Section(m_meshIndicesOffset)); }
+
+private:
+    const uint8_t* Section(size_t offset) const { return m_file.GetData() + offset; }
+
+    MappedFile m_file;
+    size_t m_pointsOffset = 0;
+    size_t m_linesOffset = 0;
+    size_t m_meshPositionsOffset = 0;
+    size_t m_meshIndicesOffset = 0;
+};
+
+// Write the scene's points, lines and mesh. The file is written next to
+// path, flushed to disk and renamed over path, so a failed save never
+// leaves a truncated scene behind.
+bool SaveSceneFile(const Scene& scene, const std::string& path);
+
+// Replace the scene's contents with a scene file. With verifyChecksum the
+// file is checked before the scene is touched.
+bool LoadSceneFile(Scene& scene, const std::string& path, bool verifyChecksum = true);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SCENEIMPORTER_H
+#define SCENEIMPORTER_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Scene;
+
+enum class ImportFormat {
+    Auto,   // from the file extension
+    Ply,    // ASCII or binary (either byte order): vertex, face and edge elements
+    Obj,    // v, l and f statements; other statements are ignored
+    Xyz     // one "x y z" point per line, extra columns ignored
+};
+
+struct ImportOptions {
+    ImportFormat format = ImportFormat::Auto;
+    size_t threadCount = 0;         // parser threads; 0 for one per hardware thread
+    size_t chunkSize = 4 << 20;     // bytes of input per parse job
+};
+
+// One parsed piece of a file, delivered in file order. Lines and triangles
+// hold point indices counted from the first point of the import;
+// InvalidImportIndex marks a reference to a point that does not exist.
+struct ImportChunk {
+    std::vector<glm::vec3> points;
+    std::vector<uint32_t> lines;        // pairs
+    std::vector<uint32_t> triangles;    // triples; polygons are fanned
+
+    // Progress: the file offset this chunk's input ends at, and the file size
+    size_t inputEnd = 0;
+    size_t inputSize = 0;
+
+    // Whether any chunk of the file can carry lines or triangles (a PLY
+    // header says exactly; an OBJ may have either), so consumers can skip
+    // index bookkeeping for plain point clouds
+    bool mayHaveLines = false;
+    bool mayHaveFaces = false;
+
+    // Points the file declares in total (PLY), or 0 if it does not say
+    size_t pointsDeclared = 0;
+};
+
+constexpr uint32_t InvalidImportIndex = 0xFFFFFFFFu;
+
+struct ImportStats {
+    size_t points = 0;
+    size_t lines = 0;
+    size_t triangles = 0;
+    size_t skippedLines = 0;        // malformed text lines
+    size_t bytes = 0;
+    double seconds = 0.0;
+};
+
+// Format for a path from its extension; Auto if it is not one of the above
+ImportFormat ImportFormatFromPath(const std::string& path);
+
+// Return false to stop the import
+using ImportConsumer = std::function<bool(ImportChunk& chunk)>;
+
+// Streams a point cloud or mesh file through consume. The file is memory
+// mapped and split into newline-aligned chunks (fixed-size records for
+// binary PLY), which are parsed on a thread pool while the calling thread
+// hands finished chunks to consume in order. Only a few chunks are held at
+// a time and consumed pages are released, so memory use does not grow with
+// the file. Returns false if the file cannot be read, is malformed, or
+// consume stopped the import.
+bool ImportFile(const std::string& path, const ImportOptions& options, const ImportConsumer& consume,
+                ImportStats* stats = nullptr);
+
+// Appends the file to the scene: vertices become points, line elements
+// become lines between them, and faces become the scene mesh (over a copy
+// of the imported vertices). Whatever was appended before a failure stays.
+bool ImportFile(Scene& scene, const std::string& path, const ImportOptions& options = ImportOptions(),
+                ImportStats* stats = nullptr);
+
+#endif
@@ -2,6 +2,7 @@
 #define SHADER_H
 
 #include <string>
+#include <map>
 #include <glm/glm.hpp>
 #include <glad/gl.h>
 
@@ -20,23 +21,44 @@ public:
     // Get shader program ID
     GLuint GetID() const { return m_id; }
     
-    // Uniform setters
-    void SetBool(const std::string& name, bool value);
-    void SetInt(const std::string& name, int value);
-    void SetFloat(const std::string& name, float value);
-    void SetVec2(const std::string& name, const glm::vec2& value);
-    void SetVec3(const std::string& name, const glm::vec3& value);
-    void SetVec4(const std::string& name, const glm::vec4& value);
-    void SetMat4(const std::string& name, const glm::mat4& value);
+    // Uniform locations are resolved once when the program links.
+    // Returns -1 for names that are not active uniforms of the program.
+    GLint GetUniformLocation(const char* name) const;
+    
+    // Attach a named uniform block to a buffer binding point.
+    // Returns false if the block is not active in this program.
+    bool BindUniformBlock(const char* blockName, GLuint bindingPoint);
+    
+    // Uniform setters by cached location (hot path: no lookup, no allocation)
+    void SetBool(GLint location, bool value);
+    void SetInt(GLint location, int value);
+    void SetFloat(GLint location, float value);
+    void SetVec2(GLint location, const glm::vec2& value);
+    void SetVec3(GLint location, const glm::vec3& value);
+    void SetVec4(GLint location, const glm::vec4& value);
+    void SetMat4(GLint location, const glm::mat4& value);
+    
+    // Uniform setters by name (looked up in the location cache)
+    void SetBool(const char* name, bool value);
+    void SetInt(const char* name, int value);
+    void SetFloat(const char* name, float value);
+    void SetVec2(const char* name, const glm::vec2& value);
+    void SetVec3(const char* name, const glm::vec3& value);
+    void SetVec4(const char* name, const glm::vec4& value);
+    void SetMat4(const char* name, const glm::mat4& value);
     
 private:
     GLuint m_id;
     std::string m_vertexSource;
     std::string m_fragmentSource;
     
+    // Active uniform name -> location; std::less<> allows lookup by const char*
+    std::map<std::string, GLint, std::less<>> m_uniformLocations;
+    
     bool CompileShader(const std::string& source, GLenum type, GLuint& shader);
     bool LinkProgram();
     void CheckCompileErrors(GLuint shader, const std::string& type);
+    void CacheUniformLocations();
 };
 
 #endif 
\ No newline at end of file
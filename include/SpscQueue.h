@@ -0,0 +1,66 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queue between exactly one producer thread and one
+// consumer thread. Each side owns one index and only reads the other's, so
+// a push or pop is a load, a move and a release store; the indices sit on
+// separate cache lines so the two threads do not contend for one. Both
+// operations fail instead of blocking, leaving the waiting policy to the
+// caller.
+template <typename T>
+class SpscQueue {
+public:
+    // capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity) : m_head(0), m_tail(0) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer: false if the queue is full; value is left untouched then
+    bool TryPush(T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+            return false;
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false if the queue is empty
+    bool TryPop(T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate unless called with the other side idle
+    size_t Size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+    bool Empty() const { return Size() == 0; }
+    size_t Capacity() const { return m_mask + 1; }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head;     // next slot to pop, written by the consumer
+    alignas(64) std::atomic<size_t> m_tail;     // next slot to push, written by the producer
+};
+
+#endif
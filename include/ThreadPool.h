@@ -0,0 +1,41 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running submitted jobs in submission order.
+// A job may wait on a job submitted before it (that one has already been
+// picked up), never on a later one.
+class ThreadPool {
+public:
+    // threadCount 0 means one worker per hardware thread
+    explicit ThreadPool(size_t threadCount = 0);
+
+    // Finishes every queued job, then joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::future<void> Submit(std::function<void()> job);
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::packaged_task<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping;
+};
+
+#endif
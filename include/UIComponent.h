@@ -7,6 +7,9 @@
 #include <string>
 #include <memory>
 #include "Shader.h"
+#include "PointStore.h"
+
+class OverlayRenderer;
 
 // Version information
 #define MESHENGINE_VERSION "v1.0.0"
@@ -39,6 +42,9 @@ public:
     
     void Initialize();
     void Update();
+    
+    // Text labels are queued into the shared overlay rather than drawn here
+    void SetOverlay(OverlayRenderer* overlay) { m_overlay = overlay; }
     void Render();
     
     Tool GetCurrentTool() const { return m_currentTool; }
@@ -49,24 +55,42 @@ public:
     bool HandleMouseClick(float x, float y);
     void UpdateWindowSize(int width, int height);
     
+    // True when tool or window state changed since the last Render()
+    bool NeedsRedraw() const { return m_geometryDirty; }
+    
+    // Progress bar and caption at the bottom of the panel, for long-running
+    // work such as an import; a negative fraction hides it
+    void SetProgress(float fraction, const std::string& label);
+    
     // Line creation state management
     bool IsAddingLine() const { return m_isAddingLine; }
     void SetAddingLine(bool adding) { m_isAddingLine = adding; }
-    int GetFirstPointIndex() const { return m_firstPointIndex; }
-    void SetFirstPointIndex(int index) { m_firstPointIndex = index; }
+    // The line's first point, held by handle so edits in between can't retarget it
+    PointId GetFirstPoint() const { return m_firstPoint; }
+    void SetFirstPoint(PointId point) { m_firstPoint = point; }
     
 private:
     void CreateButtons();
     void InitializeUIShader();
     void InitializeUIBuffers();
-    void RenderPanel();
-    void RenderButtons();
+    void RebuildGeometry();
+    void UploadGeometry();
+    void AppendPanel();
+    void AppendButtons();
+    void AppendDebugInfo();
+    void AppendProgress();
+    void RenderLabels();
     void RenderText(const std::string& text, float x, float y, float scale);
-    void RenderDebugInfo();
+    
+    // Batch builders; triangles and lines are collected separately and
+    // drawn with one call each
+    void AppendRect(float x0, float y0, float x1, float y1, const glm::vec3& color);
+    void AppendRectOutline(float x0, float y0, float x1, float y1, const glm::vec3& color);
+    void AppendLine(float x0, float y0, float x1, float y1, const glm::vec3& color);
     
     Tool m_currentTool;
     bool m_isAddingLine;
-    int m_firstPointIndex;
+    PointId m_firstPoint;
     
     int m_panelWidth;
     int m_windowWidth;
@@ -74,10 +98,25 @@ private:
     
     bool m_initialized;
     std::unique_ptr<Shader> m_uiShader;
+    OverlayRenderer* m_overlay;
+    GLint m_projectionLoc;
     GLuint m_uiVAO;
     GLuint m_uiVBO;
     
+    // Retained UI geometry (x, y, r, g, b per vertex), rebuilt only when dirty
+    std::vector<float> m_triangleVertices;
+    std::vector<float> m_lineVertices;
+    GLsizei m_triangleVertexCount;
+    GLsizei m_lineVertexCount;
+    size_t m_uiBufferCapacity;  // bytes allocated in m_uiVBO
+    bool m_geometryDirty;
+    
     std::vector<Button> m_buttons;
+    
+    // Progress bar state; the bar is rebuilt only when its filled width moves a pixel
+    float m_progress;
+    int m_progressPixels;
+    std::string m_progressLabel;
 };
 
 #endif 
\ No newline at end of file
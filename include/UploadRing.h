@@ -0,0 +1,97 @@
+#ifndef UPLOADRING_H
+#define UPLOADRING_H
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+
+// Counters since the last ResetStats()
+struct UploadStats {
+    uint64_t frames = 0;
+    uint64_t uploads = 0;
+    uint64_t bytes = 0;
+    uint64_t directUploads = 0;     // sent with glBufferSubData: ring disabled, or too big for the region
+    uint64_t stalls = 0;            // frames that waited for the GPU to release a region
+    uint64_t orphans = 0;           // frames that orphaned the ring instead of waiting
+    double stallSeconds = 0.0;
+    double uploadSeconds = 0.0;     // CPU time spent in Upload(), stalls excluded
+
+    double GetMegabytesPerSecond() const {
+        return uploadSeconds > 0.0 ? bytes / (1024.0 * 1024.0) / uploadSeconds : 0.0;
+    }
+};
+
+// Streams dynamic buffer updates through one staging buffer split into
+// FrameCount regions, one per frame in flight.
+//
+// Upload() copies the data into the current frame's region and queues a
+// glCopyBufferSubData into the destination, so the driver never has to
+// hold a copy of the caller's memory or wait for the destination to go
+// idle. EndFrame() fences the region and moves on to the next; by the
+// time the first upload comes back round to it, the GPU has normally
+// finished those copies and the region is reused without blocking.
+//
+// With GL 4.4 or ARB_buffer_storage the staging buffer is immutable and
+// mapped once, persistently and coherently, and a region still in use
+// is waited for. Otherwise each upload maps its range unsynchronized with
+// glMapBufferRange, and a region still in use orphans the whole buffer
+// instead of waiting.
+//
+// SetEnabled(false) sends every upload straight through glBufferSubData,
+// the old path, for comparison. Requires a current GL context; call
+// Release() before it is destroyed.
+class UploadRing {
+public:
+    static constexpr int FrameCount = 3;
+    static constexpr size_t DefaultRegionSize = size_t(8) << 20;
+
+    static UploadRing& Instance();
+
+    // Copy size bytes of data into buffer at offset. Binds GL_COPY_READ_BUFFER
+    // and GL_COPY_WRITE_BUFFER; other bindings are left alone.
+    void Upload(GLuint buffer, GLintptr offset, const void* data, size_t size);
+
+    // Close the frame's region once its uploads are queued (main thread)
+    void EndFrame();
+
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+    bool IsPersistent() const { return m_persistent; }
+
+    // Takes effect the next time the staging buffer is created
+    void SetRegionSize(size_t bytes) { m_requestedRegionSize = bytes; }
+
+    const UploadStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = UploadStats(); }
+
+    // Delete the staging buffer and fences (call before the context is destroyed)
+    void Release();
+
+private:
+    UploadRing();
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+
+    bool Initialize();
+    bool WaitForRegion(int region);
+    void Orphan();
+    void UploadDirect(GLuint buffer, GLintptr offset, const void* data, size_t size);
+
+    GLuint m_buffer;
+    uint8_t* m_mapped;          // persistent mapping, or null
+    bool m_persistent;
+    bool m_initialized;
+    bool m_failed;
+    bool m_enabled;
+    size_t m_requestedRegionSize;
+    size_t m_regionSize;
+
+    // Region being written and how far into it
+    int m_region;
+    size_t m_head;
+    GLsync m_fences[FrameCount];
+
+    UploadStats m_stats;
+};
+
+#endif
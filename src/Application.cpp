@@ -1,10 +1,16 @@
 #include "Application.h"
-#include <iostream>
+#include "MeshCache.h"
+#include "UploadRing.h"
+#include "SceneFile.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <cstdio>
 
 Application::Application(int width, int height, const std::string& title)
     : m_width(width), m_height(height), m_title(title), m_window(nullptr), m_firstMouse(true),
+      m_lastHoverX(-1.0), m_lastHoverY(-1.0), m_hoverPicking(HoverPicking::Cpu),
       m_zoomLevel(1.0f), m_minZoom(0.1f), m_maxZoom(10.0f) {
-    std::cout << "Starting MeshEngine..." << std::endl;
+    LOG_INFO("Starting MeshEngine %s", MESHENGINE_VERSION);
 }
 
 Application::~Application() {
@@ -14,7 +20,7 @@ Application::~Application() {
 bool Application::Initialize() {
     // Initialize GLFW
     if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
+        LOG_ERROR("Failed to initialize GLFW");
         return false;
     }
 
@@ -26,13 +32,20 @@ bool Application::Initialize() {
     // Create window
     m_window = glfwCreateWindow(m_width, m_height, m_title.c_str(), nullptr, nullptr);
     if (!m_window) {
-        std::cerr << "Failed to create window" << std::endl;
+        LOG_ERROR("Failed to create window");
         glfwTerminate();
         return false;
     }
 
     glfwMakeContextCurrent(m_window);
     glfwSetWindowUserPointer(m_window, this);
+    m_frameScheduler.Apply();
+    
+    // Input is polled once per loop iteration, which may block for a while in
+    // on-demand mode; sticky state keeps a press-and-release inside one wait
+    // from being missed
+    glfwSetInputMode(m_window, GLFW_STICKY_KEYS, GLFW_TRUE);
+    glfwSetInputMode(m_window, GLFW_STICKY_MOUSE_BUTTONS, GLFW_TRUE);
 
     // Set up scroll callback for forward/backward movement
     glfwSetScrollCallback(m_window, [](GLFWwindow* window, double xoffset, double yoffset) {
@@ -50,9 +63,17 @@ bool Application::Initialize() {
         }
     });
 
+    // Redraw when the window is exposed or needs repainting
+    glfwSetWindowRefreshCallback(m_window, [](GLFWwindow* window) {
+        Application* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+        if (app) {
+            app->m_frameScheduler.RequestRedraw();
+        }
+    });
+
     // Initialize GLAD
     if (!gladLoadGL((void* (*)(const char*))glfwGetProcAddress)) {
-        std::cerr << "Failed to initialize OpenGL" << std::endl;
+        LOG_ERROR("Failed to initialize OpenGL");
         glfwTerminate();
         return false;
     }
@@ -66,30 +87,119 @@ bool Application::Initialize() {
     // Initialize scene and UI
     m_scene = std::make_unique<Scene>();
     m_scene->Initialize();
+    m_scene->SetHoverPicking(m_hoverPicking);
+    
+    // A path that does not exist yet names a new scene, created on first save
+    if (!m_scenePath.empty()) {
+        FILE* existing = std::fopen(m_scenePath.c_str(), "rb");
+        if (existing) {
+            std::fclose(existing);
+            if (LoadSceneFile(*m_scene, m_scenePath)) {
+                LOG_INFO("Opened %s: %zu points, %zu lines, %zu triangles", m_scenePath.c_str(),
+                         m_scene->GetPoints().Size(), m_scene->GetLines().Size(), m_scene->GetMesh().FaceCount());
+            }
+        } else {
+            LOG_INFO("New scene; Ctrl+S saves it to %s", m_scenePath.c_str());
+        }
+    }
+    if (!m_importPath.empty()) {
+        m_importer.Start(m_importPath);
+    }
+    
+    m_overlay = std::make_unique<OverlayRenderer>();
+    m_overlay->Initialize();
     
     m_ui = std::make_unique<UIComponent>(m_width, m_height);
+    m_ui->SetOverlay(m_overlay.get());
     m_ui->Initialize();
 
     return true;
 }
 
+void Application::SetScenePath(const std::string& path) {
+    m_scenePath = path;
+}
+
+void Application::SetImportPath(const std::string& path) {
+    m_importPath = path;
+}
+
+void Application::SetFramePacing(FramePacing pacing, int targetFps) {
+    m_frameScheduler.SetPacing(pacing, targetFps);
+}
+
+void Application::SetHoverPicking(HoverPicking mode) {
+    m_hoverPicking = mode;
+    if (m_scene) {
+        m_scene->SetHoverPicking(mode);
+    }
+}
+
+void Application::SetTraceOutput(const std::string& path) {
+#if MESHENGINE_PROFILER
+    m_traceOutputPath = path;
+#else
+    LOG_WARN("Profiler compiled out; not writing a trace to %s", path.c_str());
+#endif
+}
+
 void Application::Run() {
     while (!glfwWindowShouldClose(m_window)) {
+        // Blocks in on-demand mode until there is input to handle
+        m_frameScheduler.WaitForEvents();
+        
+        // Frame time runs from here to the end of the swap; idle waits are excluded
+        PROFILE_FRAME_BEGIN();
         ProcessInput();
-        Render();
         m_ui->Update();
-        glfwPollEvents();
+        m_scene->Update();
+        if (m_importer.IsActive()) {
+            UpdateImport();
+        }
+        
+        if (m_scene->NeedsRedraw() || m_ui->NeedsRedraw()) {
+            m_frameScheduler.RequestRedraw();
+        }
+        if (m_scene->IsPickPending()) {
+            // Poll the hover readback again soon instead of idling
+            m_frameScheduler.RequestWakeup();
+        }
+        
+        if (m_frameScheduler.BeginFrame()) {
+            Render();
+            PROFILE_FRAME_END();
+            m_frameScheduler.EndFrame();
+        }
     }
 }
 
 void Application::Shutdown() {
     if (m_window) {
+#if MESHENGINE_PROFILER
+        if (!m_traceOutputPath.empty()) {
+            Profiler::Instance().ExportChromeTrace(m_traceOutputPath);
+        }
+        Profiler::Instance().ReleaseGpuQueries();
+#endif
+        
+        m_importer.Cancel();
+        
+        // Release GL resources while the context is still current
+        m_ui.reset();
+        m_overlay.reset();
+        m_scene.reset();
+        MeshCache::Instance().Release();
+        UploadRing::Instance().Release();
+        
         glfwDestroyWindow(m_window);
         glfwTerminate();
+        m_window = nullptr;
     }
 }
 
 void Application::ProcessInput() {
+    PROFILE_SCOPE("Application::ProcessInput");
+    
     // Handle mouse input for camera
     static bool mousePressed = false;
     static bool rightMousePressed = false;
@@ -116,6 +226,19 @@ void Application::ProcessInput() {
         rightMousePressed = false;
     }
     
+    // Hover highlighting follows the cursor over the graphics area; only
+    // re-query when the cursor actually moved
+    if (mouseX != m_lastHoverX || mouseY != m_lastHoverY) {
+        m_lastHoverX = mouseX;
+        m_lastHoverY = mouseY;
+        int hoverPanelWidth = 200;
+        if (mouseX >= hoverPanelWidth && !rightMousePressed) {
+            m_scene->UpdateHover(mouseX - hoverPanelWidth, mouseY, m_width - hoverPanelWidth, m_height);
+        } else {
+            m_scene->ClearHover();
+        }
+    }
+    
     // Handle keyboard forward/backward as fallback
     if (glfwGetKey(m_window, GLFW_KEY_EQUAL) == GLFW_PRESS) {
         HandleForwardBackward(1.0); // Move forward
@@ -175,24 +298,27 @@ void Application::ProcessInput() {
                     // Handle line creation by selecting points
                     int pointIndex = m_scene->GetPointAtScreenPosition(adjustedMouseX, adjustedMouseY, m_width - panelWidth, m_height);
                     if (pointIndex >= 0) {
+                        const auto& points = m_scene->GetPoints();
                         if (!m_ui->IsAddingLine()) {
                             // Start line creation
                             m_ui->SetAddingLine(true);
-                            m_ui->SetFirstPointIndex(pointIndex);
+                            m_ui->SetFirstPoint(points.GetId(pointIndex));
                         } else {
-                            // Complete line creation
-                            if (m_ui->GetFirstPointIndex() != pointIndex) {
-                                // Create line between the two points
-                                const auto& points = m_scene->GetPoints();
-                                if (m_ui->GetFirstPointIndex() < points.size() && pointIndex < points.size()) {
-                                    const auto& p1 = points[m_ui->GetFirstPointIndex()]->GetPosition();
-                                    const auto& p2 = points[pointIndex]->GetPosition();
-                                    m_scene->AddLine(p1, p2);
-                                }
-                            }
+                            // Complete line creation: connect the two points. AddLine
+                            // ignores a first point removed in the meantime or
+                            // clicking the same point twice.
+                            m_scene->AddLine(m_ui->GetFirstPoint(), points.GetId(pointIndex));
                             // Reset line creation state
                             m_ui->SetAddingLine(false);
-                            m_ui->SetFirstPointIndex(-1);
+                            m_ui->SetFirstPoint(InvalidPointId);
+                        }
+                    } else {
+                        // No point under the cursor: select the nearest line, if any
+                        int lineIndex = m_scene->GetLineAtScreenPosition(adjustedMouseX, adjustedMouseY, m_width - panelWidth, m_height);
+                        if (lineIndex >= 0) {
+                            m_scene->SelectLine(lineIndex);
+                        } else {
+                            m_scene->DeselectAll();
                         }
                     }
                 }
@@ -208,6 +334,59 @@ void Application::ProcessInput() {
     } else if (glfwGetKey(m_window, GLFW_KEY_2) == GLFW_PRESS) {
         m_ui->SetTool(Tool::Line);
     }
+    
+    // Ctrl+S saves the scene, once per key press
+    static bool saveKeyPressed = false;
+    bool saveKeyDown = glfwGetKey(m_window, GLFW_KEY_S) == GLFW_PRESS &&
+                       (glfwGetKey(m_window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ||
+                        glfwGetKey(m_window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS);
+    if (saveKeyDown && !saveKeyPressed) {
+        if (m_scenePath.empty()) {
+            LOG_WARN("No scene file to save to; start with --scene <file>");
+        } else {
+            if (SaveSceneFile(*m_scene, m_scenePath)) {
+                LOG_INFO("Saved %s", m_scenePath.c_str());
+            }
+        }
+    }
+    saveKeyPressed = saveKeyDown;
+    
+    // Escape abandons a running import; what already arrived stays
+    if (m_importer.IsActive() && glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+        m_importer.Cancel();
+        m_ui->SetProgress(-1.0f, "");
+    }
+    
+#if MESHENGINE_PROFILER
+    // F3 toggles the frame-time graph
+    static bool profilerKeyPressed = false;
+    bool profilerKeyDown = glfwGetKey(m_window, GLFW_KEY_F3) == GLFW_PRESS;
+    if (profilerKeyDown && !profilerKeyPressed) {
+        Profiler::Instance().ToggleOverlay();
+        m_frameScheduler.RequestRedraw();
+    }
+    profilerKeyPressed = profilerKeyDown;
+#endif
+}
+
+void Application::UpdateImport() {
+    PROFILE_SCOPE("Application::UpdateImport");
+    
+    m_importer.Apply(*m_scene, ImportBudgetSeconds);
+    if (!m_importer.IsActive()) {
+        m_ui->SetProgress(-1.0f, "");
+        return;
+    }
+    
+    ImportProgress progress = m_importer.GetProgress();
+    char label[64];
+    std::snprintf(label, sizeof(label), "Importing %d%%  %.1fM points", static_cast<int>(progress.GetFraction() * 100.0f),
+                  progress.pointsApplied / 1e6);
+    m_ui->SetProgress(progress.GetFraction(), label);
+    
+    // Chunks arrive from the loader thread, not as window events, so keep
+    // the loop polling until the import is done
+    m_frameScheduler.RequestWakeup();
 }
 
 void Application::HandleForwardBackward(double yoffset) {
@@ -236,22 +415,42 @@ void Application::HandleWindowResize(int width, int height) {
     
     // Update viewport
     glViewport(0, 0, width, height);
+    m_frameScheduler.RequestRedraw();
     
-    std::cout << "Window resized to: " << width << "x" << height << " (Graphics: " << graphicsWidth << "x" << graphicsHeight << ")" << std::endl;
+    LOG_DEBUG("Window resized to: %dx%d (Graphics: %dx%d)", width, height, graphicsWidth, graphicsHeight);
 }
 
 void Application::Render() {
+    PROFILE_SCOPE("Application::Render");
+    
     // Clear the screen
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
+    // Overlay text and labels are queued by the passes below and drawn together
+    m_overlay->Begin(m_width, m_height);
+    
     // Render graphics in the right portion of the window
     RenderGraphics();
     
     // Render UI panel on the left - render this last to ensure it's on top
     m_ui->Render();
     
-    // Swap buffers
+#if MESHENGINE_PROFILER
+    // Frame-time graph in the top left of the graphics area
+    if (Profiler::Instance().IsOverlayVisible()) {
+        Profiler::Instance().DrawOverlay(*m_overlay, 200.0f + 10.0f, m_height - 110.0f);
+    }
+#endif
+    
+    // All overlay text for the frame in one draw, on top of everything else
+    m_overlay->Flush();
+    
+    // Every upload of the frame is queued by now
+    UploadRing::Instance().EndFrame();
+    
+    // Swap buffers (blocks on vsync, so it gets its own zone)
+    PROFILE_SCOPE("SwapBuffers");
     glfwSwapBuffers(m_window);
 }
 
@@ -269,7 +468,7 @@ void Application::RenderGraphics() {
     // Render scene in the graphics area
     m_scene->Render();
     
-    // Render version number in bottom right of graphics area
+    // Queue version number in bottom right of graphics area
     RenderVersionNumber();
     
     // Reset viewport to full window for UI rendering
@@ -277,144 +476,17 @@ void Application::RenderGraphics() {
 }
 
 void Application::RenderVersionNumber() {
-    std::cout << "Rendering version number..." << std::endl;
-    
-    // Save current OpenGL state
-    GLint prevViewport[4];
-    glGetIntegerv(GL_VIEWPORT, prevViewport);
-    
-    // Set up 2D orthographic projection for version text
-    int panelWidth = 200;
-    int graphicsWidth = m_width - panelWidth;
-    int graphicsHeight = m_height;
-    
-    std::cout << "Graphics area: " << graphicsWidth << "x" << graphicsHeight << std::endl;
-    
-    glViewport(panelWidth, 0, graphicsWidth, graphicsHeight);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // Use immediate mode for simple rendering
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, graphicsWidth, graphicsHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // TEST: Draw a large bright green rectangle in the center to verify our changes are working
-    float centerX = graphicsWidth / 2.0f - 100;
-    float centerY = graphicsHeight / 2.0f - 50;
-    float width = 200;
-    float height = 100;
-    
-    std::cout << "Drawing test rectangle at (" << centerX << ", " << centerY << ")" << std::endl;
-    
-    // Draw bright green test rectangle
-    glColor3f(0.0f, 1.0f, 0.0f); // Bright green
-    glBegin(GL_QUADS);
-    glVertex2f(centerX, centerY);
-    glVertex2f(centerX + width, centerY);
-    glVertex2f(centerX + width, centerY + height);
-    glVertex2f(centerX, centerY + height);
-    glEnd();
-    
-    // Draw white border around test rectangle
-    glColor3f(1.0f, 1.0f, 1.0f); // White border
-    glLineWidth(5.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(centerX, centerY);
-    glVertex2f(centerX + width, centerY);
-    glVertex2f(centerX + width, centerY + height);
-    glVertex2f(centerX, centerY + height);
-    glEnd();
-    
-    // Render a very prominent version indicator - make it much larger and more visible
-    float yPos = graphicsHeight - 80;
-    float xPos = graphicsWidth - 200;
-    float versionWidth = 180;
-    float versionHeight = 50;
-    
-    std::cout << "Version position: (" << xPos << ", " << yPos << ")" << std::endl;
-    std::cout << "Version text: " << MESHENGINE_VERSION << std::endl;
-    
-    // Draw bright red background rectangle for maximum visibility
-    glColor3f(1.0f, 0.0f, 0.0f); // Bright red background
-    glBegin(GL_QUADS);
-    glVertex2f(xPos, yPos);
-    glVertex2f(xPos + versionWidth, yPos);
-    glVertex2f(xPos + versionWidth, yPos + versionHeight);
-    glVertex2f(xPos, yPos + versionHeight);
-    glEnd();
-    
-    // Draw thick white border
-    glColor3f(1.0f, 1.0f, 1.0f); // White border
-    glLineWidth(4.0f); // Much thicker lines
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(xPos, yPos);
-    glVertex2f(xPos + versionWidth, yPos);
-    glVertex2f(xPos + versionWidth, yPos + versionHeight);
-    glVertex2f(xPos, yPos + versionHeight);
-    glEnd();
-    
-    // Draw simple version text as lines - make it much larger
-    glColor3f(1.0f, 1.0f, 1.0f); // White text
-    glLineWidth(3.0f); // Thicker text lines
-    
-    // Draw "v1.0.0" as simple lines - make it larger
-    float textX = xPos + 20;
-    float textY = yPos + 15;
-    
-    // Draw "v" - make it larger
-    glBegin(GL_LINES);
-    glVertex2f(textX, textY + 10); glVertex2f(textX + 16, textY + 30);
-    glVertex2f(textX + 16, textY + 30); glVertex2f(textX + 32, textY + 10);
-    glEnd();
-    
-    // Draw "1" - make it larger
-    textX += 40;
-    glBegin(GL_LINES);
-    glVertex2f(textX + 16, textY); glVertex2f(textX + 16, textY + 30);
-    glEnd();
-    
-    // Draw "." - make it larger
-    textX += 24;
-    glBegin(GL_LINES);
-    glVertex2f(textX + 8, textY + 10); glVertex2f(textX + 8, textY + 10);
-    glEnd();
-    
-    // Draw "0" - make it larger
-    textX += 16;
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(textX, textY + 10); glVertex2f(textX + 16, textY + 10);
-    glVertex2f(textX + 16, textY + 30); glVertex2f(textX, textY + 30);
-    glEnd();
-    
-    // Draw "." - make it larger
-    textX += 24;
-    glBegin(GL_LINES);
-    glVertex2f(textX + 8, textY + 10); glVertex2f(textX + 8, textY + 10);
-    glEnd();
-    
-    // Draw "0" - make it larger
-    textX += 16;
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(textX, textY + 10); glVertex2f(textX + 16, textY + 10);
-    glVertex2f(textX + 16, textY + 30); glVertex2f(textX, textY + 30);
-    glEnd();
-    
-    glLineWidth(1.0f);
-    
-    // Restore OpenGL state
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
-    
-    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-    glDisable(GL_BLEND);
-    
-    std::cout << "Version rendering completed" << std::endl;
+    // Version badge in the bottom right of the graphics area, in window
+    // pixels with a bottom-left origin (the overlay's convention)
+    const float scale = 3.0f;
+    glm::vec2 textSize = m_overlay->MeasureText(MESHENGINE_VERSION, scale);
+    float padding = 12.0f;
+    float badgeWidth = textSize.x + 2 * padding;
+    float badgeHeight = textSize.y + 2 * padding;
+    float xPos = m_width - badgeWidth - 20.0f;
+    float yPos = 30.0f;
+    
+    m_overlay->AddRect(xPos, yPos, badgeWidth, badgeHeight, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    m_overlay->AddRectOutline(xPos, yPos, badgeWidth, badgeHeight, 3.0f, glm::vec4(1.0f));
+    m_overlay->AddText(MESHENGINE_VERSION, xPos + padding, yPos + padding, scale, glm::vec4(1.0f));
 } 
\ No newline at end of file
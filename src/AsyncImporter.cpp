@@ -0,0 +1,251 @@
+#include "AsyncImporter.h"
+#include "Scene.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+AsyncImporter::AsyncImporter()
+    : m_state(ImportState::Idle)
+    , m_queue(QueueCapacity)
+    , m_cancel(false)
+    , m_loaderDone(false)
+    , m_bytesRead(0)
+    , m_bytesTotal(0)
+    , m_loaded(false)
+    , m_hasCurrent(false)
+    , m_currentPoint(0)
+    , m_currentLine(0)
+    , m_reserved(false)
+    , m_pointsApplied(0)
+    , m_linesApplied(0) {}
+
+AsyncImporter::~AsyncImporter() {
+    Cancel();
+}
+
+bool AsyncImporter::Start(const std::string& path, const ImportOptions& options) {
+    if (IsActive()) {
+        LOG_WARN("Already importing %s; not starting %s", m_path.c_str(), path.c_str());
+        return false;
+    }
+    JoinLoader();
+
+    m_path = path;
+    m_state = ImportState::Running;
+    m_cancel = false;
+    m_loaderDone = false;
+    m_bytesRead = 0;
+    m_bytesTotal = 0;
+    m_loaded = false;
+    m_stats = ImportStats();
+    m_mesh.Clear();
+    m_hasCurrent = false;
+    m_reserved = false;
+    m_pointIds.clear();
+    m_pointsApplied = 0;
+    m_linesApplied = 0;
+    m_loader = std::thread(&AsyncImporter::Load, this, options);
+    return true;
+}
+
+void AsyncImporter::Cancel() {
+    if (!IsActive()) {
+        return;
+    }
+    m_cancel = true;
+    JoinLoader();
+
+    ImportChunk discarded;
+    while (m_queue.TryPop(discarded)) {
+    }
+    m_current = ImportChunk();
+    m_hasCurrent = false;
+    m_mesh.Clear();
+    m_pointIds = std::vector<PointId>();
+    m_state = ImportState::Cancelled;
+    LOG_INFO("Import of %s cancelled after %zu points", m_path.c_str(), m_pointsApplied);
+}
+
+void AsyncImporter::JoinLoader() {
+    if (m_loader.joinable()) {
+        m_loader.join();
+    }
+}
+
+void AsyncImporter::Load(ImportOptions options) {
+    PROFILE_SCOPE("AsyncImporter::Load");
+
+    m_meshPositions.clear();
+    m_meshIndices.clear();
+    m_loaded = ImportFile(m_path, options, [this](ImportChunk& chunk) { return Post(chunk); }, &m_stats);
+
+    // Faces become the mesh here, off the render thread; triangles that
+    // reference a missing vertex are dropped rather than failing it
+    if (m_loaded && !m_meshIndices.empty()) {
+        PROFILE_SCOPE("AsyncImporter::BuildMesh");
+        uint32_t vertexCount = static_cast<uint32_t>(m_meshPositions.size());
+        size_t kept = 0;
+        for (size_t triangle = 0; triangle < m_meshIndices.size() / 3; ++triangle) {
+            const uint32_t* corner = &m_meshIndices[triangle * 3];
+            if (corner[0] < vertexCount && corner[1] < vertexCount && corner[2] < vertexCount) {
+                std::copy(corner, corner + 3, m_meshIndices.begin() + kept * 3);
+                ++kept;
+            }
+        }
+        if (kept < m_meshIndices.size() / 3) {
+            LOG_WARN("%s: dropped %zu faces with missing vertices", m_path.c_str(), m_meshIndices.size() / 3 - kept);
+        }
+        m_meshIndices.resize(kept * 3);
+        if (!m_mesh.Build(std::move(m_meshPositions), std::move(m_meshIndices))) {
+            LOG_ERROR("%s: invalid mesh", m_path.c_str());
+        }
+    }
+    m_meshPositions = std::vector<glm::vec3>();
+    m_meshIndices = std::vector<uint32_t>();
+    m_loaderDone.store(true, std::memory_order_release);
+}
+
+bool AsyncImporter::Post(ImportChunk& chunk) {
+    // The mesh is built from a copy of the vertices, so plain point
+    // clouds skip it
+    if (chunk.mayHaveFaces) {
+        m_meshPositions.insert(m_meshPositions.end(), chunk.points.begin(), chunk.points.end());
+        m_meshIndices.insert(m_meshIndices.end(), chunk.triangles.begin(), chunk.triangles.end());
+    }
+    chunk.triangles = std::vector<uint32_t>();
+    m_bytesTotal.store(chunk.inputSize, std::memory_order_relaxed);
+    m_bytesRead.store(chunk.inputEnd, std::memory_order_relaxed);
+
+    // A full queue means the render thread is behind; parsing further
+    // ahead would only hold more memory
+    while (!m_queue.TryPush(chunk)) {
+        if (m_cancel.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return !m_cancel.load(std::memory_order_relaxed);
+}
+
+bool AsyncImporter::Apply(Scene& scene, double budgetSeconds) {
+    if (!IsActive()) {
+        return false;
+    }
+    PROFILE_SCOPE("AsyncImporter::Apply");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(budgetSeconds);
+    bool changed = false;
+    do {
+        if (!m_hasCurrent) {
+            if (!m_queue.TryPop(m_current)) {
+                break;
+            }
+            m_hasCurrent = true;
+            m_currentPoint = 0;
+            m_currentLine = 0;
+            if (!m_reserved) {
+                Reserve(scene);
+            }
+        }
+        changed = ApplySlice(scene) || changed;
+    } while (std::chrono::steady_clock::now() < deadline);
+
+    // The flag is read before the queue so a chunk posted just before it
+    // was set is not missed
+    if (!m_hasCurrent && m_loaderDone.load(std::memory_order_acquire) && m_queue.Empty()) {
+        Finish(scene);
+        changed = true;
+    }
+    return changed;
+}
+
+void AsyncImporter::Reserve(Scene& scene) {
+    // Growing a store of millions of points mid-import copies all of it in
+    // one frame, so make room up front: PLY declares its vertex count, and
+    // a plain point cloud is extrapolated from its first chunk
+    size_t expected = m_current.pointsDeclared;
+    if (expected == 0 && !m_current.mayHaveLines && !m_current.mayHaveFaces && m_current.inputEnd > 0) {
+        double pointsPerByte = static_cast<double>(m_current.points.size()) / m_current.inputEnd;
+        expected = static_cast<size_t>(pointsPerByte * m_current.inputSize * 1.05);
+    }
+    if (expected > 0) {
+        scene.ReservePoints(scene.GetPoints().Size() + expected);
+        if (m_current.mayHaveLines) {
+            m_pointIds.reserve(expected);
+        }
+    }
+    m_reserved = true;
+}
+
+bool AsyncImporter::ApplySlice(Scene& scene) {
+    // Points first, so lines in the same chunk find their endpoints
+    size_t pointCount = m_current.points.size();
+    if (m_currentPoint < pointCount) {
+        size_t count = std::min(SliceSize, pointCount - m_currentPoint);
+        const glm::vec3* positions = m_current.points.data() + m_currentPoint;
+        if (m_current.mayHaveLines) {
+            m_sliceIds.clear();
+            scene.AddPoints(positions, count, &m_sliceIds);
+            m_pointIds.insert(m_pointIds.end(), m_sliceIds.begin(), m_sliceIds.end());
+        } else {
+            scene.AddPoints(positions, count);
+        }
+        m_currentPoint += count;
+        m_pointsApplied += count;
+        return true;
+    }
+
+    size_t lineCount = m_current.lines.size() / 2;
+    if (m_currentLine < lineCount) {
+        size_t count = std::min(SliceSize, lineCount - m_currentLine);
+        m_lineEndpoints.resize(count * 2);
+        for (size_t k = 0; k < count * 2; ++k) {
+            uint32_t index = m_current.lines[m_currentLine * 2 + k];
+            m_lineEndpoints[k] = index < m_pointIds.size() ? m_pointIds[index] : InvalidPointId;
+        }
+        size_t before = scene.GetLines().Size();
+        scene.AddLines(m_lineEndpoints.data(), count);
+        m_linesApplied += scene.GetLines().Size() - before;
+        m_currentLine += count;
+        return true;
+    }
+
+    m_current = ImportChunk();
+    m_hasCurrent = false;
+    return false;
+}
+
+void AsyncImporter::Finish(Scene& scene) {
+    JoinLoader();
+    if (!m_mesh.Empty()) {
+        scene.SetMesh(std::move(m_mesh));
+        m_mesh = HalfEdgeMesh();
+    }
+    m_pointIds = std::vector<PointId>();
+
+    if (!m_loaded) {
+        m_state = ImportState::Failed;
+        LOG_ERROR("Import of %s failed after %zu points", m_path.c_str(), m_pointsApplied);
+        return;
+    }
+    m_state = ImportState::Finished;
+    size_t skippedLines = m_stats.lines - m_linesApplied;
+    LOG_INFO("Imported %s: %zu points, %zu lines, %zu triangles in %.2f s (%.0f MB/s parsing)", m_path.c_str(),
+             m_pointsApplied, m_linesApplied, scene.GetMesh().FaceCount(), m_stats.seconds,
+             m_stats.bytes / (1024.0 * 1024.0) / std::max(m_stats.seconds, 1e-9));
+    if (skippedLines > 0) {
+        LOG_WARN("%s: skipped %zu lines with invalid endpoints", m_path.c_str(), skippedLines);
+    }
+}
+
+ImportProgress AsyncImporter::GetProgress() const {
+    ImportProgress progress;
+    progress.state = m_state;
+    progress.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+    progress.bytesTotal = m_bytesTotal.load(std::memory_order_relaxed);
+    progress.pointsApplied = m_pointsApplied;
+    progress.linesApplied = m_linesApplied;
+    progress.queuedChunks = m_queue.Size();
+    return progress;
+}
@@ -11,7 +11,8 @@ Camera::Camera()
     , m_movementSpeed(2.5f)
     , m_mouseSensitivity(0.1f)
     , m_zoom(45.0f)
-    , m_aspectRatio(1200.0f / 800.0f) {
+    , m_aspectRatio(1200.0f / 800.0f)
+    , m_dirty(true) {
     UpdateCameraVectors();
 }
 
@@ -25,7 +26,8 @@ Camera::Camera(const glm::vec3& position)
     , m_movementSpeed(2.5f)
     , m_mouseSensitivity(0.1f)
     , m_zoom(45.0f)
-    , m_aspectRatio(1200.0f / 800.0f) {
+    , m_aspectRatio(1200.0f / 800.0f)
+    , m_dirty(true) {
     UpdateCameraVectors();
 }
 
@@ -34,6 +36,9 @@ void Camera::Update() {
 }
 
 void Camera::ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch) {
+    if (xoffset == 0.0f && yoffset == 0.0f)
+        return;
+    
     xoffset *= m_mouseSensitivity;
     yoffset *= m_mouseSensitivity;
 
@@ -48,6 +53,7 @@ void Camera::ProcessMouseMovement(float xoffset, float yoffset, bool constrainPi
     }
 
     UpdateCameraVectors();
+    m_dirty = true;
 }
 
 void Camera::ProcessMouseScroll(float yoffset) {
@@ -56,6 +62,7 @@ void Camera::ProcessMouseScroll(float yoffset) {
         m_zoom = -45.0f;
     if (m_zoom > 45.0f)
         m_zoom = 45.0f;
+    m_dirty = true;
 }
 
 void Camera::ProcessKeyboard(int direction, float deltaTime) {
@@ -81,6 +88,7 @@ void Camera::ProcessKeyboard(int direction, float deltaTime) {
             m_position -= m_up * velocity;
             break;
     }
+    m_dirty = true;
 }
 
 glm::mat4 Camera::GetViewMatrix() const {
@@ -102,6 +110,27 @@ void Camera::UpdateCameraVectors() {
     m_up = glm::normalize(glm::cross(m_right, m_front));
 }
 
+void Camera::LookAt(const glm::vec3& position, const glm::vec3& target) {
+    glm::vec3 direction = target - position;
+    if (glm::length(direction) <= 0.0f)
+        return;
+    direction = glm::normalize(direction);
+    
+    m_position = position;
+    m_yaw = glm::degrees(atan2(direction.z, direction.x));
+    m_pitch = glm::degrees(asin(direction.y));
+    if (m_pitch > 89.0f)
+        m_pitch = 89.0f;
+    if (m_pitch < -89.0f)
+        m_pitch = -89.0f;
+    
+    UpdateCameraVectors();
+    m_dirty = true;
+}
+
 void Camera::SetAspectRatio(float aspectRatio) {
-    m_aspectRatio = aspectRatio;
+    if (aspectRatio != m_aspectRatio) {
+        m_aspectRatio = aspectRatio;
+        m_dirty = true;
+    }
 } 
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "FrameScheduler.h"
+#include "Log.h"
+#include <thread>
+
+FrameScheduler::FrameScheduler()
+    : m_pacing(FramePacing::OnDemand), m_targetFps(60),
+      m_redrawRequested(true), m_wakeupRequested(false), m_renderedLastIteration(false),
+      m_nextFrameTime(std::chrono::steady_clock::now()) {
+}
+
+void FrameScheduler::SetPacing(FramePacing pacing, int targetFps) {
+    m_pacing = pacing;
+    m_targetFps = targetFps > 0 ? targetFps : 60;
+    m_nextFrameTime = std::chrono::steady_clock::now();
+    m_redrawRequested = true;
+}
+
+void FrameScheduler::Apply() {
+    // Fixed-rate pacing does its own sleeping; the other modes let the
+    // swap block on the display so redraw bursts never exceed refresh rate
+    glfwSwapInterval(m_pacing == FramePacing::FixedFps ? 0 : 1);
+
+    switch (m_pacing) {
+        case FramePacing::VSync:
+            LOG_INFO("Frame pacing: vsync");
+            break;
+        case FramePacing::FixedFps:
+            LOG_INFO("Frame pacing: fixed %d fps", m_targetFps);
+            break;
+        case FramePacing::OnDemand:
+            LOG_INFO("Frame pacing: on demand");
+            break;
+    }
+}
+
+void FrameScheduler::WaitForEvents() {
+    if (m_pacing == FramePacing::OnDemand && !m_redrawRequested && !m_renderedLastIteration) {
+        // Nothing changed last iteration: sleep until input arrives. The
+        // timeout only bounds how stale polled state can get.
+        glfwWaitEventsTimeout(m_wakeupRequested ? WakeupTimeoutSeconds : IdleTimeoutSeconds);
+    } else {
+        glfwPollEvents();
+    }
+    m_wakeupRequested = false;
+}
+
+bool FrameScheduler::BeginFrame() {
+    bool render = (m_pacing != FramePacing::OnDemand) || m_redrawRequested;
+    m_redrawRequested = false;
+    m_renderedLastIteration = render;
+    return render;
+}
+
+void FrameScheduler::EndFrame() {
+    if (m_pacing != FramePacing::FixedFps) {
+        return;
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / m_targetFps));
+    m_nextFrameTime += period;
+
+    auto now = clock::now();
+    if (m_nextFrameTime < now) {
+        // Fell behind (slow frame or a stall); restart the cadence from now
+        // rather than rendering a burst of catch-up frames
+        m_nextFrameTime = now;
+        return;
+    }
+    std::this_thread::sleep_until(m_nextFrameTime);
+}
@@ -0,0 +1,328 @@
+#include "GpuPicker.h"
+#include "Log.h"
+#include "MeshCache.h"
+#include "UploadRing.h"
+#include <algorithm>
+#include <cstddef>
+
+GpuPicker::GpuPicker()
+    : m_pointVAO(0), m_pointInstanceVBO(0), m_pointInstanceCapacity(0), m_framebuffer(0), m_idBuffer(0), m_depthBuffer(0), m_width(0), m_height(0),
+      m_firstPending(0), m_pendingCount(0), m_savedViewport{0, 0, 0, 0},
+      m_savedDrawFramebuffer(0), m_savedReadFramebuffer(0),
+      m_boxX(0), m_boxY(0), m_boxWidth(0), m_boxHeight(0), m_centerX(0), m_centerY(0) {
+    for (Readback& readback : m_readbacks) {
+        readback = Readback{0, nullptr, 0, 0, 0, 0};
+    }
+}
+
+GpuPicker::~GpuPicker() {
+    for (Readback& readback : m_readbacks) {
+        ReleaseFence(readback);
+        if (readback.pbo) glDeleteBuffers(1, &readback.pbo);
+    }
+    if (m_pointVAO) glDeleteVertexArrays(1, &m_pointVAO);
+    if (m_pointInstanceVBO) glDeleteBuffers(1, &m_pointInstanceVBO);
+    ReleaseTarget();
+}
+
+bool GpuPicker::Initialize(GLuint cameraBlockBinding) {
+    // Same geometry as the visible pass; each primitive writes its ID
+    const char* pointVertexSource = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+        layout (location = 1) in vec3 aOffset;
+        layout (location = 2) in uint aIndex;
+
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
+
+        flat out uint pickId;
+
+        void main() {
+            gl_Position = projection * view * vec4(aPos + aOffset, 1.0);
+            pickId = aIndex + 1u;
+        }
+    )";
+    const char* lineVertexSource = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
+
+        void main() {
+            gl_Position = projection * view * vec4(aPos, 1.0);
+        }
+    )";
+    // Lines are drawn indexed, so the vertex ID is a point index; the
+    // primitive ID is the line index
+    const char* lineFragmentSource = R"(
+        #version 330 core
+        layout (location = 0) out uint FragId;
+        void main() {
+            FragId = (uint(gl_PrimitiveID) + 1u) | 0x80000000u;
+        }
+    )";
+    const char* idFragmentSource = R"(
+        #version 330 core
+        flat in uint pickId;
+        layout (location = 0) out uint FragId;
+        void main() {
+            FragId = pickId;
+        }
+    )";
+
+    m_pointShader = std::make_unique<Shader>();
+    m_lineShader = std::make_unique<Shader>();
+    if (!m_pointShader->LoadFromStrings(pointVertexSource, idFragmentSource) ||
+        !m_lineShader->LoadFromStrings(lineVertexSource, lineFragmentSource)) {
+        LOG_ERROR("Failed to load picking shaders");
+        return false;
+    }
+    m_pointShader->BindUniformBlock("Camera", cameraBlockBinding);
+    m_lineShader->BindUniformBlock("Camera", cameraBlockBinding);
+
+    // Sphere mesh plus an instance stream of (center, index) pairs
+    const Mesh& sphere = MeshCache::Instance().Get(Primitive::Sphere);
+    glGenVertexArrays(1, &m_pointVAO);
+    glGenBuffers(1, &m_pointInstanceVBO);
+    glBindVertexArray(m_pointVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, sphere.vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphere.ebo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_pointInstanceVBO);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(PointInstance), (void*)offsetof(PointInstance, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(PointInstance), (void*)offsetof(PointInstance, index));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Readback buffers never grow: each holds one pick box of IDs
+    for (Readback& readback : m_readbacks) {
+        glGenBuffers(1, &readback.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, PickBoxSize * PickBoxSize * sizeof(GLuint), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+bool GpuPicker::BeginPass(double screenX, double screenY, int viewportWidth, int viewportHeight) {
+    if (!m_pointShader || m_pendingCount == ReadbackSlots || viewportWidth <= 0 || viewportHeight <= 0) {
+        return false;
+    }
+    if (viewportWidth != m_width || viewportHeight != m_height) {
+        ResizeTarget(viewportWidth, viewportHeight);
+        if (!m_framebuffer) {
+            return false;
+        }
+    }
+
+    // Framebuffer rows run bottom-up; clip the pick box to the target
+    int cursorX = static_cast<int>(screenX);
+    int cursorY = m_height - 1 - static_cast<int>(screenY);
+    if (cursorX < 0 || cursorX >= m_width || cursorY < 0 || cursorY >= m_height) {
+        return false;
+    }
+    m_boxX = std::max(cursorX - PickRadius, 0);
+    m_boxY = std::max(cursorY - PickRadius, 0);
+    m_boxWidth = std::min(cursorX + PickRadius + 1, m_width) - m_boxX;
+    m_boxHeight = std::min(cursorY + PickRadius + 1, m_height) - m_boxY;
+    m_centerX = cursorX - m_boxX;
+    m_centerY = cursorY - m_boxY;
+
+    glGetIntegerv(GL_VIEWPORT, m_savedViewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_savedDrawFramebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_savedReadFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+
+    // Only the box around the cursor is cleared and rasterised
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(m_boxX, m_boxY, m_boxWidth, m_boxHeight);
+    const GLuint clearId = 0;
+    const GLfloat clearDepth = 1.0f;
+    glClearBufferuiv(GL_COLOR, 0, &clearId);
+    glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+    return true;
+}
+
+void GpuPicker::DrawPoints(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    if (indices.empty()) {
+        return;
+    }
+    m_pointInstances.clear();
+    for (uint32_t index : indices) {
+        m_pointInstances.push_back(PointInstance{positions[index], index});
+    }
+    if (m_pointInstances.size() > m_pointInstanceCapacity) {
+        m_pointInstanceCapacity = std::max(m_pointInstances.size(), m_pointInstanceCapacity * 2);
+        glBindBuffer(GL_ARRAY_BUFFER, m_pointInstanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, m_pointInstanceCapacity * sizeof(PointInstance), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    UploadRing::Instance().Upload(m_pointInstanceVBO, 0, m_pointInstances.data(),
+                                  m_pointInstances.size() * sizeof(PointInstance));
+
+    const Mesh& sphere = MeshCache::Instance().Get(Primitive::Sphere);
+    m_pointShader->Use();
+    glBindVertexArray(m_pointVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, sphere.indexCount, GL_UNSIGNED_INT, (void*)0,
+                            static_cast<GLsizei>(m_pointInstances.size()));
+    glBindVertexArray(0);
+}
+
+void GpuPicker::DrawLines(GLuint vao, GLsizei indexCount) {
+    if (indexCount <= 0) {
+        return;
+    }
+    m_lineShader->Use();
+    glBindVertexArray(vao);
+    glDrawElements(GL_LINES, indexCount, GL_UNSIGNED_INT, (void*)0);
+    glBindVertexArray(0);
+}
+
+void GpuPicker::EndPass() {
+    // The copy lands in the pixel pack buffer asynchronously; the fence tells
+    // PollResult() when it is safe to read without stalling
+    Readback& readback = m_readbacks[(m_firstPending + m_pendingCount) % ReadbackSlots];
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    glReadPixels(m_boxX, m_boxY, m_boxWidth, m_boxHeight, GL_RED_INTEGER, GL_UNSIGNED_INT, (void*)0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.centerX = m_centerX;
+    readback.centerY = m_centerY;
+    readback.width = m_boxWidth;
+    readback.height = m_boxHeight;
+    ++m_pendingCount;
+
+    // Make sure the fence reaches the GPU even if nothing else is submitted
+    glFlush();
+
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(m_savedDrawFramebuffer));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(m_savedReadFramebuffer));
+    glViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+    glUseProgram(0);
+}
+
+bool GpuPicker::PollResult(int& pointIndex, int& lineIndex) {
+    // Fences signal in submission order, so stop at the first unsignalled
+    // one and keep only the newest completed readback
+    int completed = -1;
+    while (m_pendingCount > 0) {
+        Readback& readback = m_readbacks[m_firstPending];
+        GLenum status = glClientWaitSync(readback.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        ReleaseFence(readback);
+        completed = m_firstPending;
+        m_firstPending = (m_firstPending + 1) % ReadbackSlots;
+        --m_pendingCount;
+    }
+    if (completed < 0) {
+        return false;
+    }
+
+    const Readback& readback = m_readbacks[completed];
+    GLuint ids[PickBoxSize * PickBoxSize];
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, readback.width * readback.height * sizeof(GLuint), ids);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // Points win over lines, as in CPU picking; then the pixel nearest the cursor
+    GLuint bestId = 0;
+    int bestRank = 0;
+    for (int y = 0; y < readback.height; ++y) {
+        for (int x = 0; x < readback.width; ++x) {
+            GLuint id = ids[y * readback.width + x];
+            if (id == 0) {
+                continue;
+            }
+            int dx = x - readback.centerX;
+            int dy = y - readback.centerY;
+            int distanceSq = dx * dx + dy * dy;
+            if (distanceSq > PickRadius * PickRadius) {
+                continue;
+            }
+            // Lower rank is better; lines rank after every point
+            int rank = distanceSq + 1 + ((id & LineTag) ? PickBoxSize * PickBoxSize : 0);
+            if (bestId == 0 || rank < bestRank) {
+                bestId = id;
+                bestRank = rank;
+            }
+        }
+    }
+
+    pointIndex = -1;
+    lineIndex = -1;
+    if (bestId & LineTag) {
+        lineIndex = static_cast<int>((bestId & ~LineTag) - 1);
+    } else if (bestId != 0) {
+        pointIndex = static_cast<int>(bestId - 1);
+    }
+    return true;
+}
+
+void GpuPicker::DiscardPending() {
+    while (m_pendingCount > 0) {
+        ReleaseFence(m_readbacks[m_firstPending]);
+        m_firstPending = (m_firstPending + 1) % ReadbackSlots;
+        --m_pendingCount;
+    }
+}
+
+void GpuPicker::ResizeTarget(int width, int height) {
+    ReleaseTarget();
+
+    glGenRenderbuffers(1, &m_idBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_idBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, width, height);
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_idBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Picking framebuffer incomplete (status 0x%x)", status);
+        ReleaseTarget();
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    LOG_DEBUG("Picking framebuffer resized to %dx%d", width, height);
+}
+
+void GpuPicker::ReleaseTarget() {
+    if (m_framebuffer) glDeleteFramebuffers(1, &m_framebuffer);
+    if (m_idBuffer) glDeleteRenderbuffers(1, &m_idBuffer);
+    if (m_depthBuffer) glDeleteRenderbuffers(1, &m_depthBuffer);
+    m_framebuffer = 0;
+    m_idBuffer = 0;
+    m_depthBuffer = 0;
+    m_width = 0;
+    m_height = 0;
+}
+
+void GpuPicker::ReleaseFence(Readback& readback) {
+    if (readback.fence) {
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+    }
+}
@@ -0,0 +1,102 @@
+#include "HalfEdgeMesh.h"
+
+bool HalfEdgeMesh::Build(std::vector<glm::vec3> positions, std::vector<uint32_t> indices) {
+    Clear();
+    if (indices.size() % 3 != 0 || indices.size() >= NoHalfEdge || positions.size() >= NoHalfEdge) {
+        return false;
+    }
+    for (uint32_t index : indices) {
+        if (index >= positions.size()) {
+            return false;
+        }
+    }
+
+    m_positions = std::move(positions);
+    m_indices = std::move(indices);
+    BuildTwins();
+    return true;
+}
+
+void HalfEdgeMesh::Clear() {
+    m_positions.clear();
+    m_indices.clear();
+    m_twins.clear();
+    m_vertexHalfEdge.clear();
+    m_nonManifoldHalfEdges = 0;
+}
+
+size_t HalfEdgeMesh::GetMemoryUsage() const {
+    return m_positions.capacity() * sizeof(glm::vec3) +
+           (m_indices.capacity() + m_twins.capacity() + m_vertexHalfEdge.capacity()) * sizeof(uint32_t);
+}
+
+void HalfEdgeMesh::BuildTwins() {
+    uint32_t vertexCount = static_cast<uint32_t>(m_positions.size());
+    uint32_t halfEdgeCount = static_cast<uint32_t>(m_indices.size());
+    m_twins.assign(halfEdgeCount, NoHalfEdge);
+    m_vertexHalfEdge.assign(vertexCount, NoHalfEdge);
+
+    // Bucket half-edges by origin with a counting sort, so finding a twin
+    // only scans one vertex's outgoing half-edges. Filling from the back
+    // leaves firstOutgoing[v] at the start of v's bucket and keeps each
+    // bucket in half-edge order.
+    std::vector<uint32_t> firstOutgoing(vertexCount + 1, 0);
+    for (uint32_t vertex : m_indices) {
+        ++firstOutgoing[vertex];
+    }
+    for (uint32_t vertex = 1; vertex <= vertexCount; ++vertex) {
+        firstOutgoing[vertex] += firstOutgoing[vertex - 1];
+    }
+    std::vector<uint32_t> outgoing(halfEdgeCount);
+    for (uint32_t halfEdge = halfEdgeCount; halfEdge-- > 0;) {
+        outgoing[--firstOutgoing[m_indices[halfEdge]]] = halfEdge;
+    }
+
+    for (uint32_t halfEdge = 0; halfEdge < halfEdgeCount; ++halfEdge) {
+        if (m_twins[halfEdge] != NoHalfEdge) {
+            continue;
+        }
+        uint32_t from = Origin(halfEdge);
+        uint32_t to = Target(halfEdge);
+        if (from == to) {
+            continue;
+        }
+
+        // The twin runs to -> from; any second candidate, or another
+        // from -> to half-edge, makes the edge non-manifold
+        uint32_t twin = NoHalfEdge;
+        bool shared = false;
+        for (uint32_t k = firstOutgoing[to]; k < firstOutgoing[to + 1]; ++k) {
+            uint32_t candidate = outgoing[k];
+            if (Target(candidate) == from) {
+                shared = shared || twin != NoHalfEdge;
+                twin = candidate;
+            }
+        }
+        for (uint32_t k = firstOutgoing[from]; k < firstOutgoing[from + 1] && !shared; ++k) {
+            uint32_t candidate = outgoing[k];
+            shared = candidate != halfEdge && Target(candidate) == to;
+        }
+
+        if (shared) {
+            ++m_nonManifoldHalfEdges;
+        } else if (twin != NoHalfEdge) {
+            m_twins[halfEdge] = twin;
+            m_twins[twin] = halfEdge;
+        }
+    }
+
+    // A fan walk turns from a half-edge to Next(Twin()), so on the border it
+    // has to start where the incoming half-edge has no twin
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+        for (uint32_t k = firstOutgoing[vertex]; k < firstOutgoing[vertex + 1]; ++k) {
+            uint32_t halfEdge = outgoing[k];
+            if (m_vertexHalfEdge[vertex] == NoHalfEdge || IsBoundary(Prev(halfEdge))) {
+                m_vertexHalfEdge[vertex] = halfEdge;
+            }
+            if (IsBoundary(Prev(halfEdge))) {
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,499 @@
+#include "HeadlessRenderer.h"
+#include "MeshCache.h"
+#include "UploadRing.h"
+#include "PngWriter.h"
+#include "SceneFile.h"
+#include "SceneImporter.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// Synthetic scene extent and the orbit that views it
+constexpr float SceneHalfExtent = 5.0f;
+constexpr float OrbitRadius = 16.0f;
+constexpr float OrbitHeight = 6.0f;
+constexpr float TwoPi = 6.28318530718f;
+
+// Frames a GPU pick may take to come back before the check gives up
+constexpr int MaxPickFrames = 16;
+
+const char* GLString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "unknown";
+}
+
+// Quoted JSON string: quotes, backslashes and control characters escaped,
+// since driver strings such as GL_RENDERER may contain any of them
+std::string JsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+            quoted += escape;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+// Height field over the scene's footprint with about triangleCount
+// triangles: a grid of side x side quads, two triangles each
+void BuildTerrain(size_t triangleCount, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    uint32_t side = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(triangleCount / 2.0))));
+    uint32_t stride = side + 1;
+    float cell = 2.0f * SceneHalfExtent / side;
+
+    positions.resize(static_cast<size_t>(stride) * stride);
+    for (uint32_t row = 0; row < stride; ++row) {
+        for (uint32_t column = 0; column < stride; ++column) {
+            float x = -SceneHalfExtent + column * cell;
+            float z = -SceneHalfExtent + row * cell;
+            positions[row * stride + column] = glm::vec3(x, 0.6f * std::sin(x) * std::cos(z) - 1.0f, z);
+        }
+    }
+
+    indices.resize(static_cast<size_t>(side) * side * 6);
+    size_t next = 0;
+    for (uint32_t row = 0; row < side; ++row) {
+        for (uint32_t column = 0; column < side; ++column) {
+            uint32_t corner = row * stride + column;
+            uint32_t quad[6] = {corner, corner + stride, corner + 1, corner + 1, corner + stride, corner + stride + 1};
+            std::copy(quad, quad + 6, indices.begin() + next);
+            next += 6;
+        }
+    }
+}
+
+// Nearest-rank percentile of a sorted sample
+double Percentile(const std::vector<double>& sorted, double fraction) {
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+}
+
+}
+
+HeadlessRenderer::HeadlessRenderer(const HeadlessOptions& options)
+    : m_options(options), m_window(nullptr), m_framebuffer(0), m_colorBuffer(0), m_depthBuffer(0) {
+}
+
+HeadlessRenderer::~HeadlessRenderer() {
+    Shutdown();
+}
+
+bool HeadlessRenderer::Initialize() {
+    if (m_options.width <= 0 || m_options.height <= 0 || m_options.frames <= 0) {
+        LOG_ERROR("Invalid headless options: %dx%d, %d frames", m_options.width, m_options.height, m_options.frames);
+        return false;
+    }
+
+    if (!glfwInit()) {
+        LOG_ERROR("Failed to initialize GLFW");
+        return false;
+    }
+
+    // The window only provides a context; it is never shown or drawn to
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    m_window = glfwCreateWindow(m_options.width, m_options.height, "MeshEngine (headless)", nullptr, nullptr);
+    if (!m_window) {
+        LOG_ERROR("Failed to create offscreen context");
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(m_window);
+
+    // Swaps never happen, but keep the driver from throttling if one does
+    glfwSwapInterval(0);
+
+    if (!gladLoadGL((void* (*)(const char*))glfwGetProcAddress)) {
+        LOG_ERROR("Failed to initialize OpenGL");
+        Shutdown();
+        return false;
+    }
+    LOG_INFO("Headless renderer: %s (OpenGL %s)", GLString(GL_RENDERER), GLString(GL_VERSION));
+
+    if (!CreateTarget()) {
+        Shutdown();
+        return false;
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    UploadRing::Instance().SetEnabled(m_options.uploadRing);
+
+    m_scene = std::make_unique<Scene>();
+    m_scene->Initialize();
+    m_scene->SetPointLod(m_options.pointLod);
+    if (m_options.pickCheck) {
+        PopulatePickScene();
+        return true;
+    }
+    if (!m_options.scenePath.empty() || !m_options.importPath.empty()) {
+        if (!m_options.scenePath.empty() && !LoadSceneFile(*m_scene, m_options.scenePath)) {
+            return false;
+        }
+        if (!m_options.importPath.empty() && !ImportFile(*m_scene, m_options.importPath)) {
+            return false;
+        }
+        const std::string& source = m_options.importPath.empty() ? m_options.scenePath : m_options.importPath;
+        LOG_INFO("Headless scene: %s, %zu points, %zu lines, %zu triangles, %dx%d", source.c_str(),
+                 m_scene->GetPoints().Size(), m_scene->GetLines().Size(), m_scene->GetMesh().FaceCount(),
+                 m_options.width, m_options.height);
+        return true;
+    }
+    PopulateScene();
+    return true;
+}
+
+bool HeadlessRenderer::Run() {
+    if (!m_scene) {
+        return false;
+    }
+    if (m_options.pickCheck) {
+        return CheckPicking();
+    }
+
+    // Warm-up frames absorb shader compilation and first buffer uploads
+    for (int frame = 0; frame < m_options.warmupFrames; ++frame) {
+        PlaceCamera(frame, m_options.warmupFrames);
+        RenderFrame();
+    }
+
+    // Statistics cover the measured frames only, not the initial upload
+    UploadRing::Instance().ResetStats();
+    std::vector<double> frameTimesMs;
+    frameTimesMs.reserve(m_options.frames);
+    bool dumpsOk = true;
+    for (int frame = 0; frame < m_options.frames; ++frame) {
+        PlaceCamera(frame, m_options.frames);
+        ChurnPoints(frame);
+        frameTimesMs.push_back(RenderFrame());
+
+        const PointLodStats& lod = m_scene->GetPointLodStats();
+        m_pointLodTotals.chunks += lod.chunks;
+        m_pointLodTotals.culledChunks += lod.culledChunks;
+        m_pointLodTotals.geometryPoints += lod.geometryPoints;
+        m_pointLodTotals.impostorPoints += lod.impostorPoints;
+        m_pointLodTotals.dotPoints += lod.dotPoints;
+        m_pointLodTotals.skippedPoints += lod.skippedPoints;
+
+        if (!m_options.pngDirectory.empty() && m_options.pngInterval > 0 && frame % m_options.pngInterval == 0) {
+            dumpsOk = DumpFrame(frame) && dumpsOk;
+        }
+    }
+
+    bool statsOk = ReportStats(std::move(frameTimesMs));
+
+#if MESHENGINE_PROFILER
+    if (!m_options.tracePath.empty() && !Profiler::Instance().ExportChromeTrace(m_options.tracePath)) {
+        statsOk = false;
+    }
+#else
+    if (!m_options.tracePath.empty()) {
+        LOG_WARN("Profiler compiled out; not writing a trace to %s", m_options.tracePath.c_str());
+    }
+#endif
+    return statsOk && dumpsOk;
+}
+
+void HeadlessRenderer::Shutdown() {
+    if (!m_window) {
+        return;
+    }
+
+    // Release GL resources while the context is still current
+#if MESHENGINE_PROFILER
+    Profiler::Instance().ReleaseGpuQueries();
+#endif
+    m_scene.reset();
+    MeshCache::Instance().Release();
+    UploadRing::Instance().Release();
+    if (m_framebuffer) glDeleteFramebuffers(1, &m_framebuffer);
+    if (m_colorBuffer) glDeleteRenderbuffers(1, &m_colorBuffer);
+    if (m_depthBuffer) glDeleteRenderbuffers(1, &m_depthBuffer);
+    m_framebuffer = 0;
+    m_colorBuffer = 0;
+    m_depthBuffer = 0;
+
+    glfwDestroyWindow(m_window);
+    glfwTerminate();
+    m_window = nullptr;
+}
+
+bool HeadlessRenderer::CreateTarget() {
+    glGenRenderbuffers(1, &m_colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_options.width, m_options.height);
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_options.width, m_options.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Offscreen framebuffer incomplete (status 0x%x)", status);
+        return false;
+    }
+
+    // Every frame renders here; nothing is ever presented
+    glViewport(0, 0, m_options.width, m_options.height);
+    return true;
+}
+
+void HeadlessRenderer::PopulateScene() {
+    // Fixed seed so runs are comparable across builds and machines
+    std::mt19937 random(m_options.seed);
+    std::uniform_real_distribution<float> position(-SceneHalfExtent, SceneHalfExtent);
+
+    // Generated up front and added in bulk, as an import would
+    std::vector<glm::vec3> positions(m_options.pointCount);
+    for (glm::vec3& p : positions) {
+        p = glm::vec3(position(random), position(random), position(random));
+    }
+    std::vector<PointId> points;
+    m_scene->AddPoints(positions, &points);
+
+    // Lines join random pairs of the points above
+    if (m_options.lineCount > 0 && points.size() < 2) {
+        LOG_WARN("Headless scene needs at least 2 points for lines; skipping %zu lines", m_options.lineCount);
+    } else if (m_options.lineCount > 0) {
+        std::uniform_int_distribution<size_t> pick(0, points.size() - 1);
+        std::vector<PointId> endpoints;
+        endpoints.reserve(m_options.lineCount * 2);
+        for (size_t i = 0; i < m_options.lineCount; ++i) {
+            size_t start = pick(random);
+            size_t end = pick(random);
+            if (end == start) {
+                end = (start + 1) % points.size();
+            }
+            endpoints.push_back(points[start]);
+            endpoints.push_back(points[end]);
+        }
+        m_scene->AddLines(endpoints);
+    }
+
+    if (m_options.triangleCount > 0) {
+        std::vector<glm::vec3> vertices;
+        std::vector<uint32_t> indices;
+        BuildTerrain(m_options.triangleCount, vertices, indices);
+        m_scene->SetMesh(std::move(vertices), std::move(indices));
+    }
+
+    LOG_INFO("Headless scene: %zu points, %zu lines, %zu triangles, %dx%d", m_options.pointCount, m_options.lineCount,
+             m_scene->GetMesh().FaceCount(), m_options.width, m_options.height);
+}
+
+void HeadlessRenderer::PopulatePickScene() {
+    // 0-1: ends of line 0, below the origin; 2: alone above it; 3: directly
+    // behind 2, so only depth decides; then a row of points near the top
+    // of the view that no probe should hit
+    std::vector<glm::vec3> positions = {
+        glm::vec3(-3.0f, -1.0f, 0.0f), glm::vec3(3.0f, -1.0f, 0.0f),
+        glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0.0f, 1.5f, -5.0f),
+    };
+    for (float x = -6.0f; x <= 6.0f; x += 0.5f) {
+        positions.push_back(glm::vec3(x, 4.0f, -5.0f));
+    }
+    std::vector<PointId> points;
+    m_scene->AddPoints(positions, &points);
+    m_scene->AddLine(points[0], points[1]);
+    m_scene->GetCamera().LookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f));
+
+    LOG_INFO("Headless pick check: %zu points, %zu lines, %dx%d", m_scene->GetPoints().Size(),
+             m_scene->GetLines().Size(), m_options.width, m_options.height);
+}
+
+bool HeadlessRenderer::CheckPicking() {
+    m_scene->SetHoverPicking(HoverPicking::Gpu);
+    if (m_scene->GetHoverPicking() != HoverPicking::Gpu) {
+        LOG_ERROR("Pick check: GPU picking unavailable");
+        return false;
+    }
+
+    // One frame first so the camera has the target's aspect ratio
+    RenderFrame();
+    bool ok = ProbeHover("point", glm::vec3(0.0f, 1.5f, 0.0f), 2, -1);
+    ok = ProbeHover("line", glm::vec3(0.0f, -1.0f, 0.0f), -1, 0) && ok;
+    ok = ProbeHover("line end", glm::vec3(-3.0f, -1.0f, 0.0f), 0, -1) && ok;
+    ok = ProbeHover("background", glm::vec3(0.0f, -3.0f, 0.0f), -1, -1) && ok;
+    LOG_INFO("Pick check %s", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool HeadlessRenderer::ProbeHover(const char* label, const glm::vec3& target, int expectedPoint, int expectedLine) {
+    // Hover the pixel the target projects to; screen rows run top-down
+    Camera& camera = m_scene->GetCamera();
+    glm::vec4 clip = camera.GetProjectionMatrix() * camera.GetViewMatrix() * glm::vec4(target, 1.0f);
+    double x = (clip.x / clip.w * 0.5 + 0.5) * m_options.width;
+    double y = (0.5 - clip.y / clip.w * 0.5) * m_options.height;
+    m_scene->UpdateHover(x, y, m_options.width, m_options.height);
+
+    // Readbacks land a frame or more later, as they would in the app loop
+    for (int frame = 0; m_scene->IsPickPending(); ++frame) {
+        if (frame == MaxPickFrames) {
+            LOG_ERROR("Pick check %s: no result after %d frames", label, MaxPickFrames);
+            return false;
+        }
+        m_scene->Update();
+        RenderFrame();
+    }
+
+    int point = m_scene->GetHoveredPoint();
+    int line = m_scene->GetHoveredLine();
+    bool ok = point == expectedPoint && line == expectedLine;
+    if (ok) {
+        LOG_INFO("Pick check %s at (%.1f, %.1f): point %d, line %d", label, x, y, point, line);
+    } else {
+        LOG_ERROR("Pick check %s at (%.1f, %.1f): point %d, line %d, expected point %d, line %d",
+                  label, x, y, point, line, expectedPoint, expectedLine);
+    }
+    return ok;
+}
+
+void HeadlessRenderer::PlaceCamera(int frame, int frameCount) {
+    // One orbit around the scene per run, bobbing up and down twice
+    float angle = TwoPi * static_cast<float>(frame) / static_cast<float>(std::max(frameCount, 1));
+    glm::vec3 eye(OrbitRadius * std::cos(angle), OrbitHeight * std::sin(2.0f * angle), OrbitRadius * std::sin(angle));
+    m_scene->GetCamera().LookAt(eye, glm::vec3(0.0f));
+}
+
+void HeadlessRenderer::ChurnPoints(int frame) {
+    // A contiguous block, as when a selection is dragged, so each frame
+    // uploads one dirty range of churnPoints positions
+    size_t count = std::min(m_options.churnPoints, m_scene->GetPoints().Size());
+    if (count == 0) {
+        return;
+    }
+    size_t pointCount = m_scene->GetPoints().Size();
+    size_t first = (static_cast<size_t>(frame) * count) % (pointCount - count + 1);
+    float lift = 0.01f * ((frame & 1) ? 1.0f : -1.0f);
+    for (size_t i = first; i < first + count; ++i) {
+        glm::vec3 position = m_scene->GetPoints().GetPositions()[i];
+        m_scene->SetPointPosition(static_cast<int>(i), position + glm::vec3(0.0f, lift, 0.0f));
+    }
+}
+
+double HeadlessRenderer::RenderFrame() {
+    auto start = std::chrono::steady_clock::now();
+    PROFILE_FRAME_BEGIN();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_options.width, m_options.height);
+    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    m_scene->UpdateViewport(m_options.width, m_options.height);
+    m_scene->Render();
+    UploadRing::Instance().EndFrame();
+
+    // Without a swap nothing bounds the queue; finish so the time is real
+    glFinish();
+    PROFILE_FRAME_END();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+bool HeadlessRenderer::DumpFrame(int frame) {
+    m_pixels.resize(static_cast<size_t>(m_options.width) * m_options.height * 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_options.width, m_options.height, GL_RGBA, GL_UNSIGNED_BYTE, m_pixels.data());
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/frame_%05d.png", frame);
+    std::string path = m_options.pngDirectory + name;
+    if (!WritePng(path, m_options.width, m_options.height, m_pixels.data())) {
+        LOG_ERROR("Failed to write %s", path.c_str());
+        return false;
+    }
+    LOG_DEBUG("Wrote %s", path.c_str());
+    return true;
+}
+
+bool HeadlessRenderer::ReportStats(std::vector<double> frameTimesMs) {
+    double total = 0.0;
+    for (double time : frameTimesMs) {
+        total += time;
+    }
+    double mean = total / frameTimesMs.size();
+    std::sort(frameTimesMs.begin(), frameTimesMs.end());
+    double p50 = Percentile(frameTimesMs, 0.50);
+    double p95 = Percentile(frameTimesMs, 0.95);
+    double p99 = Percentile(frameTimesMs, 0.99);
+
+    LOG_INFO("Headless frames: %zu, mean %.3f ms (%.1f fps), min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f ms",
+             frameTimesMs.size(), mean, 1000.0 / mean, frameTimesMs.front(), p50, p95, p99, frameTimesMs.back());
+
+    const UploadStats& uploads = UploadRing::Instance().GetStats();
+    const char* uploadPath = !m_options.uploadRing ? "direct" : UploadRing::Instance().IsPersistent() ? "persistent" : "mapped";
+    double frames = static_cast<double>(frameTimesMs.size());
+    double uploadMegabytes = uploads.bytes / (1024.0 * 1024.0);
+    LOG_INFO("Headless uploads (%s): %.2f MB/frame at %.0f MB/s, %.3f ms/frame, %.2f stalls/frame, %llu orphans, %llu direct",
+             uploadPath, uploadMegabytes / frames, uploads.GetMegabytesPerSecond(), uploads.uploadSeconds * 1000.0 / frames,
+             uploads.stalls / frames, static_cast<unsigned long long>(uploads.orphans),
+             static_cast<unsigned long long>(uploads.directUploads));
+
+    // Per-frame averages of what each level drew
+    const PointLodStats& lod = m_pointLodTotals;
+    const char* lodMode = m_options.pointLod ? "on" : "off";
+    if (m_options.pointLod) {
+        LOG_INFO("Headless point LOD: %.0f spheres, %.0f impostors, %.0f dots, %.0f skipped per frame; %.1f of %.1f chunks culled",
+                 lod.geometryPoints / frames, lod.impostorPoints / frames, lod.dotPoints / frames, lod.skippedPoints / frames,
+                 lod.culledChunks / frames, lod.chunks / frames);
+    }
+
+    if (m_options.statsPath.empty()) {
+        return true;
+    }
+    FILE* file = std::fopen(m_options.statsPath.c_str(), "w");
+    if (!file) {
+        LOG_ERROR("Failed to open %s", m_options.statsPath.c_str());
+        return false;
+    }
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"renderer\": %s,\n", JsonString(GLString(GL_RENDERER)).c_str());
+    std::fprintf(file, "  \"width\": %d,\n", m_options.width);
+    std::fprintf(file, "  \"height\": %d,\n", m_options.height);
+    std::fprintf(file, "  \"points\": %zu,\n", m_scene->GetPoints().Size());
+    std::fprintf(file, "  \"lines\": %zu,\n", m_scene->GetLines().Size());
+    std::fprintf(file, "  \"triangles\": %zu,\n", m_scene->GetMesh().FaceCount());
+    std::fprintf(file, "  \"frames\": %zu,\n", frameTimesMs.size());
+    std::fprintf(file, "  \"fps\": %.3f,\n", 1000.0 / mean);
+    std::fprintf(file, "  \"frame_ms\": {\"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n",
+                 mean, frameTimesMs.front(), p50, p95, p99, frameTimesMs.back());
+    std::fprintf(file, "  \"upload\": {\"path\": \"%s\", \"mb_per_frame\": %.4f, \"mb_per_s\": %.1f, \"ms_per_frame\": %.4f, "
+                 "\"stalls_per_frame\": %.4f, \"stall_ms\": %.4f, \"orphans\": %llu, \"direct\": %llu},\n",
+                 uploadPath, uploadMegabytes / frames, uploads.GetMegabytesPerSecond(), uploads.uploadSeconds * 1000.0 / frames,
+                 uploads.stalls / frames, uploads.stallSeconds * 1000.0, static_cast<unsigned long long>(uploads.orphans),
+                 static_cast<unsigned long long>(uploads.directUploads));
+    std::fprintf(file, "  \"point_lod\": {\"mode\": \"%s\", \"spheres_per_frame\": %.1f, \"impostors_per_frame\": %.1f, "
+                 "\"dots_per_frame\": %.1f, \"skipped_per_frame\": %.1f, \"chunks\": %.1f, \"culled_chunks\": %.1f}\n",
+                 lodMode, lod.geometryPoints / frames, lod.impostorPoints / frames, lod.dotPoints / frames,
+                 lod.skippedPoints / frames, lod.chunks / frames, lod.culledChunks / frames);
+    std::fprintf(file, "}\n");
+    bool written = std::fclose(file) == 0;
+    if (written) {
+        LOG_INFO("Wrote frame statistics to %s", m_options.statsPath.c_str());
+    }
+    return written;
+}
@@ -0,0 +1,490 @@
+#include "LineBVH.h"
+#include "HandleTable.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t MaxLeafSize = 4;
+constexpr int SahBins = 12;
+
+// Appended segments scanned linearly before a rebuild is requested
+constexpr size_t MinPendingLines = 1024;
+
+// Segments within half a pixel of the cursor are under it. The front-most
+// of them wins rather than the closest, which lets the traversal skip
+// whatever lies behind it.
+constexpr float HitPixels = 0.5f;
+
+// m_lineIndices entry of a removed segment
+constexpr uint32_t RemovedEntry = 0xFFFFFFFFu;
+
+float SurfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 e = boundsMax - boundsMin;
+    return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+}
+
+// Closest points between segments p0-p1 and q0-q1 (Ericson, Real-Time
+// Collision Detection 5.1.9). Returns the squared distance; s and t are the
+// parameters along p and q.
+float SegmentSegmentDistanceSq(const glm::vec3& p0, const glm::vec3& p1,
+                               const glm::vec3& q0, const glm::vec3& q1,
+                               float& s, float& t) {
+    const float epsilon = 1e-12f;
+    glm::vec3 d1 = p1 - p0;
+    glm::vec3 d2 = q1 - q0;
+    glm::vec3 r = p0 - q0;
+    float a = glm::dot(d1, d1);
+    float e = glm::dot(d2, d2);
+    float f = glm::dot(d2, r);
+
+    if (a <= epsilon && e <= epsilon) {
+        s = t = 0.0f;
+    } else if (a <= epsilon) {
+        s = 0.0f;
+        t = std::clamp(f / e, 0.0f, 1.0f);
+    } else {
+        float c = glm::dot(d1, r);
+        if (e <= epsilon) {
+            t = 0.0f;
+            s = std::clamp(-c / a, 0.0f, 1.0f);
+        } else {
+            float b = glm::dot(d1, d2);
+            float denom = a * e - b * b;
+            s = denom > epsilon ? std::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            } else if (t > 1.0f) {
+                t = 1.0f;
+                s = std::clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+
+    glm::vec3 diff = (p0 + d1 * s) - (q0 + d2 * t);
+    return glm::dot(diff, diff);
+}
+
+}
+
+LineBVH::LineBVH() : m_removedEntries(0) {
+}
+
+void LineBVH::Build(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    m_nodes.clear();
+    m_lineIndices.clear();
+    m_parents.clear();
+    m_leafOfLine.clear();
+    m_removedEntries = 0;
+
+    size_t lineCount = indices.size() / 2;
+    if (lineCount == 0) {
+        return;
+    }
+
+    std::vector<glm::vec3> centroids(lineCount);
+    std::vector<glm::vec3> boundsMin(lineCount);
+    std::vector<glm::vec3> boundsMax(lineCount);
+    m_lineIndices.resize(lineCount);
+    for (size_t i = 0; i < lineCount; ++i) {
+        const glm::vec3& start = positions[indices[i * 2]];
+        const glm::vec3& end = positions[indices[i * 2 + 1]];
+        boundsMin[i] = glm::min(start, end);
+        boundsMax[i] = glm::max(start, end);
+        centroids[i] = (start + end) * 0.5f;
+        m_lineIndices[i] = static_cast<uint32_t>(i);
+    }
+
+    // A binary tree with leaves of at least one segment has < 2N nodes
+    m_nodes.reserve(lineCount * 2);
+    m_parents.reserve(lineCount * 2);
+
+    Node root;
+    root.first = 0;
+    root.count = static_cast<uint32_t>(lineCount);
+    m_nodes.push_back(root);
+    m_parents.push_back(InvalidNode);
+    Subdivide(0, centroids, boundsMin, boundsMax);
+
+    m_leafOfLine.resize(lineCount);
+    for (uint32_t n = 0; n < m_nodes.size(); ++n) {
+        const Node& node = m_nodes[n];
+        for (uint32_t k = 0; k < node.count; ++k) {
+            m_leafOfLine[m_lineIndices[node.first + k]] = n;
+        }
+    }
+}
+
+void LineBVH::Subdivide(uint32_t rootIndex, const std::vector<glm::vec3>& centroids,
+                        const std::vector<glm::vec3>& boundsMin, const std::vector<glm::vec3>& boundsMax) {
+    // Explicit work list instead of recursion so degenerate inputs cannot
+    // overflow the call stack
+    std::vector<uint32_t> pending;
+    pending.push_back(rootIndex);
+
+    while (!pending.empty()) {
+        uint32_t nodeIndex = pending.back();
+        pending.pop_back();
+
+        uint32_t first = m_nodes[nodeIndex].first;
+        uint32_t count = m_nodes[nodeIndex].count;
+
+        // Node bounds and centroid bounds
+        glm::vec3 nodeMin(std::numeric_limits<float>::max());
+        glm::vec3 nodeMax(-std::numeric_limits<float>::max());
+        glm::vec3 centroidMin = nodeMin;
+        glm::vec3 centroidMax = nodeMax;
+        for (uint32_t k = first; k < first + count; ++k) {
+            uint32_t line = m_lineIndices[k];
+            nodeMin = glm::min(nodeMin, boundsMin[line]);
+            nodeMax = glm::max(nodeMax, boundsMax[line]);
+            centroidMin = glm::min(centroidMin, centroids[line]);
+            centroidMax = glm::max(centroidMax, centroids[line]);
+        }
+        m_nodes[nodeIndex].boundsMin = nodeMin;
+        m_nodes[nodeIndex].boundsMax = nodeMax;
+
+        if (count <= MaxLeafSize) {
+            continue;
+        }
+
+        glm::vec3 centroidExtent = centroidMax - centroidMin;
+        int axis = 0;
+        if (centroidExtent.y > centroidExtent[axis]) axis = 1;
+        if (centroidExtent.z > centroidExtent[axis]) axis = 2;
+
+        uint32_t* begin = m_lineIndices.data() + first;
+        uint32_t* end = begin + count;
+        uint32_t* middle = nullptr;
+
+        if (centroidExtent[axis] > 0.0f) {
+            // Bin centroids along the widest axis and sweep for the cheapest split
+            struct Bin {
+                glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+                glm::vec3 boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+                uint32_t count = 0;
+            };
+            Bin bins[SahBins];
+            float binScale = SahBins / centroidExtent[axis];
+            auto binOf = [&](uint32_t line) {
+                int b = static_cast<int>((centroids[line][axis] - centroidMin[axis]) * binScale);
+                return std::min(b, SahBins - 1);
+            };
+            for (uint32_t* it = begin; it != end; ++it) {
+                Bin& bin = bins[binOf(*it)];
+                bin.boundsMin = glm::min(bin.boundsMin, boundsMin[*it]);
+                bin.boundsMax = glm::max(bin.boundsMax, boundsMax[*it]);
+                ++bin.count;
+            }
+
+            float rightCost[SahBins];
+            glm::vec3 accumMin(std::numeric_limits<float>::max());
+            glm::vec3 accumMax(-std::numeric_limits<float>::max());
+            uint32_t accumCount = 0;
+            for (int b = SahBins - 1; b > 0; --b) {
+                accumMin = glm::min(accumMin, bins[b].boundsMin);
+                accumMax = glm::max(accumMax, bins[b].boundsMax);
+                accumCount += bins[b].count;
+                rightCost[b] = accumCount ? accumCount * SurfaceArea(accumMin, accumMax) : 0.0f;
+            }
+
+            float bestCost = std::numeric_limits<float>::max();
+            int bestSplit = -1;
+            accumMin = glm::vec3(std::numeric_limits<float>::max());
+            accumMax = glm::vec3(-std::numeric_limits<float>::max());
+            accumCount = 0;
+            for (int b = 0; b < SahBins - 1; ++b) {
+                accumMin = glm::min(accumMin, bins[b].boundsMin);
+                accumMax = glm::max(accumMax, bins[b].boundsMax);
+                accumCount += bins[b].count;
+                if (accumCount == 0 || accumCount == count) {
+                    continue;
+                }
+                float cost = accumCount * SurfaceArea(accumMin, accumMax) + rightCost[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = b;
+                }
+            }
+
+            if (bestSplit >= 0) {
+                middle = std::partition(begin, end, [&](uint32_t line) { return binOf(line) <= bestSplit; });
+            }
+        }
+
+        if (middle == nullptr || middle == begin || middle == end) {
+            // Coincident centroids or an unusable split: halve by count
+            middle = begin + count / 2;
+            std::nth_element(begin, middle, end, [&](uint32_t a, uint32_t b) {
+                return centroids[a][axis] < centroids[b][axis];
+            });
+        }
+
+        uint32_t leftCount = static_cast<uint32_t>(middle - begin);
+        uint32_t leftIndex = static_cast<uint32_t>(m_nodes.size());
+
+        Node left;
+        left.first = first;
+        left.count = leftCount;
+        Node right;
+        right.first = first + leftCount;
+        right.count = count - leftCount;
+        m_nodes.push_back(left);
+        m_nodes.push_back(right);
+        m_parents.push_back(nodeIndex);
+        m_parents.push_back(nodeIndex);
+
+        m_nodes[nodeIndex].first = leftIndex;
+        m_nodes[nodeIndex].count = 0;
+
+        pending.push_back(leftIndex);
+        pending.push_back(leftIndex + 1);
+    }
+}
+
+bool LineBVH::NeedsRebuild(size_t lineCount) const {
+    size_t indexed = m_leafOfLine.size();
+    if (lineCount < indexed || (indexed == 0 && lineCount > 0)) {
+        return true;
+    }
+    size_t budget = std::max(MinPendingLines, indexed / 8);
+    return lineCount - indexed > budget || m_removedEntries > budget;
+}
+
+void LineBVH::FitLeaf(Node& node, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) const {
+    node.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    node.boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+    for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+        uint32_t line = m_lineIndices[k];
+        if (line == RemovedEntry) {
+            continue;
+        }
+        const glm::vec3& start = positions[indices[line * 2]];
+        const glm::vec3& end = positions[indices[line * 2 + 1]];
+        node.boundsMin = glm::min(node.boundsMin, glm::min(start, end));
+        node.boundsMax = glm::max(node.boundsMax, glm::max(start, end));
+    }
+}
+
+void LineBVH::Refit(size_t lineIndex, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    if (lineIndex >= m_leafOfLine.size()) {
+        // Not indexed yet; Pick() scans it linearly
+        return;
+    }
+
+    uint32_t nodeIndex = m_leafOfLine[lineIndex];
+    FitLeaf(m_nodes[nodeIndex], positions, indices);
+
+    // Walk to the root, stopping once a parent's bounds no longer change
+    for (uint32_t parent = m_parents[nodeIndex]; parent != InvalidNode; parent = m_parents[parent]) {
+        Node& node = m_nodes[parent];
+        const Node& left = m_nodes[node.first];
+        const Node& right = m_nodes[node.first + 1];
+        glm::vec3 newMin = glm::min(left.boundsMin, right.boundsMin);
+        glm::vec3 newMax = glm::max(left.boundsMax, right.boundsMax);
+        if (newMin == node.boundsMin && newMax == node.boundsMax) {
+            break;
+        }
+        node.boundsMin = newMin;
+        node.boundsMax = newMax;
+    }
+}
+
+uint32_t LineBVH::EntryOf(uint32_t lineIndex) const {
+    const Node& leaf = m_nodes[m_leafOfLine[lineIndex]];
+    uint32_t k = leaf.first;
+    while (m_lineIndices[k] != lineIndex) {
+        ++k;
+    }
+    return k;
+}
+
+void LineBVH::LineRemoved(size_t lineIndex, size_t lastIndex,
+                          const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    size_t indexed = m_leafOfLine.size();
+    if (lineIndex >= indexed) {
+        // Both are in the unindexed tail, which Pick() scans by index
+        return;
+    }
+
+    uint32_t entry = EntryOf(static_cast<uint32_t>(lineIndex));
+    if (lineIndex != lastIndex && lastIndex < indexed) {
+        // Renumber the segment that took over lineIndex
+        m_lineIndices[EntryOf(static_cast<uint32_t>(lastIndex))] = static_cast<uint32_t>(lineIndex);
+        m_leafOfLine[lineIndex] = m_leafOfLine[lastIndex];
+        m_lineIndices[entry] = RemovedEntry;
+        ++m_removedEntries;
+    } else if (lineIndex != lastIndex) {
+        // It came from the unindexed tail: reuse the freed entry and grow
+        // the leaf's bounds to cover it
+        m_lineIndices[entry] = static_cast<uint32_t>(lineIndex);
+        Refit(lineIndex, positions, indices);
+    } else {
+        m_lineIndices[entry] = RemovedEntry;
+        ++m_removedEntries;
+    }
+
+    if (lastIndex < indexed) {
+        m_leafOfLine.pop_back();
+    }
+}
+
+void LineBVH::LinesRemoved(const std::vector<uint32_t>& newIndexOfLine) {
+    size_t kept = 0;
+    for (uint32_t& line : m_lineIndices) {
+        if (line == RemovedEntry) {
+            continue;
+        }
+        uint32_t newIndex = newIndexOfLine[line];
+        if (newIndex == InvalidHandleSlot) {
+            line = RemovedEntry;
+            ++m_removedEntries;
+        } else {
+            line = newIndex;
+            ++kept;
+        }
+    }
+
+    // Survivors keep their order, so the indexed ones still come first
+    std::vector<uint32_t> leafOfLine(kept);
+    for (size_t line = 0; line < m_leafOfLine.size(); ++line) {
+        if (newIndexOfLine[line] != InvalidHandleSlot) {
+            leafOfLine[newIndexOfLine[line]] = m_leafOfLine[line];
+        }
+    }
+    m_leafOfLine.swap(leafOfLine);
+}
+
+int LineBVH::Pick(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+                  const PickRay& ray, float tolerancePixels) const {
+    size_t lineCount = indices.size() / 2;
+    if (lineCount == 0 || lineCount < m_leafOfLine.size()) {
+        return -1;
+    }
+
+    glm::vec3 rayEnd = ray.origin + ray.direction * ray.length;
+
+    int bestIndex = -1;
+    float bestPixels = tolerancePixels;
+    float bestDepth = std::numeric_limits<float>::max();
+    float hitPixels = std::min(HitPixels, tolerancePixels);
+    bool bestIsHit = false;
+
+    auto testLine = [&](uint32_t line) {
+        float s, t;
+        float distanceSq = SegmentSegmentDistanceSq(ray.origin, rayEnd, positions[indices[line * 2]],
+                                                    positions[indices[line * 2 + 1]], s, t);
+        float depth = std::max(ray.DepthAt(s * ray.length), 1e-6f);
+        float pixels = std::sqrt(distanceSq) * ray.pixelScale / depth;
+        bool isHit = pixels <= hitPixels;
+        bool better = bestIsHit
+            ? isHit && depth < bestDepth
+            : isHit || pixels < bestPixels || (pixels == bestPixels && depth < bestDepth);
+        if (better) {
+            bestIndex = static_cast<int>(line);
+            bestPixels = isHit ? hitPixels : pixels;
+            bestDepth = depth;
+            bestIsHit = isHit;
+        }
+    };
+
+    // Segments appended since the last Build()
+    for (size_t i = m_leafOfLine.size(); i < lineCount; ++i) {
+        testLine(static_cast<uint32_t>(i));
+    }
+
+    if (m_nodes.empty()) {
+        return bestIndex;
+    }
+
+    // Entry distance of the ray into a node's bounds, padded by the current
+    // pixel tolerance at the node's far side; negative if missed, or if the
+    // node lies entirely behind a hit
+    auto enterNode = [&](const Node& node) {
+        glm::vec3 center = (node.boundsMin + node.boundsMax) * 0.5f;
+        float halfDiagonal = glm::length(node.boundsMax - node.boundsMin) * 0.5f;
+        float farthest = std::min(glm::length(center - ray.origin) + halfDiagonal, ray.length);
+        float padding = ray.WorldRadiusAt(farthest, bestPixels);
+
+        float tEnter = 0.0f;
+        float tExit = ray.length;
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = node.boundsMin[axis] - padding;
+            float hi = node.boundsMax[axis] + padding;
+            if (std::fabs(ray.direction[axis]) < 1e-12f) {
+                if (ray.origin[axis] < lo || ray.origin[axis] > hi) {
+                    return -1.0f;
+                }
+                continue;
+            }
+            float t0 = (lo - ray.origin[axis]) / ray.direction[axis];
+            float t1 = (hi - ray.origin[axis]) / ray.direction[axis];
+            if (t0 > t1) std::swap(t0, t1);
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+            if (tEnter > tExit) {
+                return -1.0f;
+            }
+        }
+        if (bestIsHit && ray.DepthAt(tEnter) > bestDepth) {
+            return -1.0f;
+        }
+        return tEnter;
+    };
+
+    // Nodes waiting to be visited, with the ray's entry distance into each
+    struct Pending {
+        uint32_t node;
+        float tEnter;
+    };
+    std::vector<Pending> stack;
+    stack.reserve(64);
+    float tRoot = enterNode(m_nodes[0]);
+    if (tRoot >= 0.0f) {
+        stack.push_back({0, tRoot});
+    }
+
+    while (!stack.empty()) {
+        Pending pending = stack.back();
+        stack.pop_back();
+
+        // A hit found since this node was pushed may be in front of it
+        if (bestIsHit && ray.DepthAt(pending.tEnter) > bestDepth) {
+            continue;
+        }
+        const Node& node = m_nodes[pending.node];
+
+        if (node.count > 0) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                if (m_lineIndices[k] != RemovedEntry) {
+                    testLine(m_lineIndices[k]);
+                }
+            }
+            continue;
+        }
+
+        // Children are re-tested here with the tolerance as it stands now,
+        // so hits found meanwhile shrink the padding; nearer child goes last
+        // onto the stack so it is visited first
+        float tLeft = enterNode(m_nodes[node.first]);
+        float tRight = enterNode(m_nodes[node.first + 1]);
+        if (tLeft >= 0.0f && tRight >= 0.0f) {
+            if (tLeft <= tRight) {
+                stack.push_back({node.first + 1, tRight});
+                stack.push_back({node.first, tLeft});
+            } else {
+                stack.push_back({node.first, tLeft});
+                stack.push_back({node.first + 1, tRight});
+            }
+        } else if (tLeft >= 0.0f) {
+            stack.push_back({node.first, tLeft});
+        } else if (tRight >= 0.0f) {
+            stack.push_back({node.first + 1, tRight});
+        }
+    }
+
+    return bestIndex;
+}
@@ -0,0 +1,182 @@
+#include "LineStore.h"
+#include <algorithm>
+
+LineId LineStore::Add(uint32_t startPoint, uint32_t endPoint) {
+    uint32_t end = static_cast<uint32_t>(m_indices.size());
+    m_indices.push_back(startPoint);
+    m_indices.push_back(endPoint);
+    m_nextEnd.push_back(NoEnd);
+    m_nextEnd.push_back(NoEnd);
+    LinkEnd(end);
+    LinkEnd(end + 1);
+    
+    m_selected.PushBack(false);
+    m_hovered.PushBack(false);
+    return m_handles.Push();
+}
+
+void LineStore::Add(const uint32_t* endpoints, size_t count, std::vector<LineId>* ids) {
+    uint32_t firstEnd = static_cast<uint32_t>(m_indices.size());
+    m_indices.insert(m_indices.end(), endpoints, endpoints + count * 2);
+    m_nextEnd.resize(m_indices.size(), NoEnd);
+    for (uint32_t end = firstEnd; end < m_indices.size(); ++end) {
+        LinkEnd(end);
+    }
+    m_selected.Resize(Size() + count);
+    m_hovered.Resize(Size() + count);
+    
+    if (ids) {
+        ids->reserve(ids->size() + count);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        LineId id = m_handles.Push();
+        if (ids) {
+            ids->push_back(id);
+        }
+    }
+}
+
+void LineStore::Remove(size_t index) {
+    if (index >= m_handles.Size()) {
+        return;
+    }
+    
+    uint32_t hole = static_cast<uint32_t>(index * 2);
+    UnlinkEnd(hole);
+    UnlinkEnd(hole + 1);
+    
+    // Move the last line into the hole instead of shifting everything after it
+    size_t last = m_handles.Size() - 1;
+    if (index != last) {
+        uint32_t moved = static_cast<uint32_t>(last * 2);
+        for (uint32_t k = 0; k < 2; ++k) {
+            RelinkEnd(moved + k, hole + k);
+            m_indices[hole + k] = m_indices[moved + k];
+        }
+        m_selected.Set(index, m_selected.Test(last));
+        m_hovered.Set(index, m_hovered.Test(last));
+    }
+    m_indices.resize(last * 2);
+    m_nextEnd.resize(last * 2);
+    m_selected.PopBack();
+    m_hovered.PopBack();
+    m_handles.SwapRemove(index);
+}
+
+void LineStore::Remove(const std::vector<LineId>& ids, std::vector<uint32_t>* newIndexOfLine) {
+    // Mark first so the arrays are walked once however many lines go
+    DynamicBitset removed;
+    removed.Resize(m_handles.Size());
+    for (LineId id : ids) {
+        int index = m_handles.IndexOf(id);
+        if (index >= 0) {
+            removed.Set(index, true);
+        }
+    }
+    
+    if (newIndexOfLine) {
+        newIndexOfLine->assign(m_handles.Size(), InvalidHandleSlot);
+    }
+    
+    size_t kept = 0;
+    for (size_t index = 0; index < m_handles.Size(); ++index) {
+        if (removed.Test(index)) {
+            continue;
+        }
+        if (newIndexOfLine) {
+            (*newIndexOfLine)[index] = static_cast<uint32_t>(kept);
+        }
+        m_indices[kept * 2] = m_indices[index * 2];
+        m_indices[kept * 2 + 1] = m_indices[index * 2 + 1];
+        m_selected.Set(kept, m_selected.Test(index));
+        m_hovered.Set(kept, m_hovered.Test(index));
+        ++kept;
+    }
+    m_indices.resize(kept * 2);
+    m_nextEnd.resize(kept * 2);
+    m_selected.Resize(kept);
+    m_hovered.Resize(kept);
+    m_handles.RemoveMarked(removed);
+    
+    // Nearly every end moved, so relinking from scratch is cheaper than patching
+    RebuildAdjacency();
+}
+
+void LineStore::Clear() {
+    m_indices.clear();
+    m_nextEnd.clear();
+    m_firstEndAtPoint.clear();
+    m_selected.Clear();
+    m_hovered.Clear();
+    m_handles.Clear();
+}
+
+void LineStore::Reserve(size_t count) {
+    m_indices.reserve(count * 2);
+    m_nextEnd.reserve(count * 2);
+    m_selected.Reserve(count);
+    m_hovered.Reserve(count);
+    m_handles.Reserve(count);
+}
+
+void LineStore::MovePoint(uint32_t from, uint32_t to) {
+    if (from == to) {
+        return;
+    }
+    
+    uint32_t first = from < m_firstEndAtPoint.size() ? m_firstEndAtPoint[from] : NoEnd;
+    for (uint32_t end = first; end != NoEnd; end = m_nextEnd[end]) {
+        m_indices[end] = to;
+    }
+    if (first == NoEnd && to >= m_firstEndAtPoint.size()) {
+        return;
+    }
+    if (to >= m_firstEndAtPoint.size()) {
+        m_firstEndAtPoint.resize(to + 1, NoEnd);
+    }
+    m_firstEndAtPoint[to] = first;
+    if (from < m_firstEndAtPoint.size()) {
+        m_firstEndAtPoint[from] = NoEnd;
+    }
+}
+
+void LineStore::RemapPoints(const std::vector<uint32_t>& newIndexOfPoint) {
+    for (uint32_t& point : m_indices) {
+        point = newIndexOfPoint[point];
+    }
+    RebuildAdjacency();
+}
+
+void LineStore::LinkEnd(uint32_t end) {
+    uint32_t point = m_indices[end];
+    if (point >= m_firstEndAtPoint.size()) {
+        m_firstEndAtPoint.resize(point + 1, NoEnd);
+    }
+    m_nextEnd[end] = m_firstEndAtPoint[point];
+    m_firstEndAtPoint[point] = end;
+}
+
+void LineStore::UnlinkEnd(uint32_t end) {
+    uint32_t* link = &m_firstEndAtPoint[m_indices[end]];
+    while (*link != end) {
+        link = &m_nextEnd[*link];
+    }
+    *link = m_nextEnd[end];
+}
+
+void LineStore::RelinkEnd(uint32_t from, uint32_t to) {
+    // Same point, new slot: redirect whatever referenced the old slot
+    uint32_t* link = &m_firstEndAtPoint[m_indices[from]];
+    while (*link != from) {
+        link = &m_nextEnd[*link];
+    }
+    *link = to;
+    m_nextEnd[to] = m_nextEnd[from];
+}
+
+void LineStore::RebuildAdjacency() {
+    std::fill(m_firstEndAtPoint.begin(), m_firstEndAtPoint.end(), NoEnd);
+    for (uint32_t end = 0; end < m_indices.size(); ++end) {
+        LinkEnd(end);
+    }
+}
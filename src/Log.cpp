@@ -0,0 +1,191 @@
+#include "Log.h"
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+const size_t RingCapacity = 1024;      // must be a power of two
+const size_t MessageCapacity = 512;
+
+struct LogSlot {
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    char message[MessageCapacity];
+};
+
+void WriteMessage(LogLevel level, const char* message) {
+    FILE* stream = level >= LogLevel::Warn ? stderr : stdout;
+    std::fputs(message, stream);
+    std::fputc('\n', stream);
+}
+
+// Bounded multi-producer / single-consumer ring (sequence-numbered slots).
+// Producers claim a slot with one CAS; the drain thread is the only consumer.
+//
+// The ring is never destroyed: static destructors may log after it would
+// have been. At exit, Shutdown() stops the drain thread and from then on
+// messages are written straight out.
+class LogRing {
+public:
+    LogRing() : m_enqueuePos(0), m_dequeuePos(0), m_dropped(0), m_running(true), m_direct(false) {
+        for (size_t i = 0; i < RingCapacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_thread = std::thread(&LogRing::DrainLoop, this);
+    }
+    
+    void Shutdown() {
+        m_direct.store(true, std::memory_order_release);
+        m_running.store(false, std::memory_order_release);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        DrainOnce();
+    }
+    
+    bool IsDirect() const { return m_direct.load(std::memory_order_acquire); }
+    
+    // Returns the slot to fill, or nullptr if the ring is full
+    LogSlot* Claim() {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            LogSlot& slot = m_slots[pos & (RingCapacity - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return &slot;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Hand a filled slot over to the drain thread
+    void Publish(LogSlot* slot) {
+        size_t pos = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+    
+    void Flush() {
+        if (IsDirect()) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+            return;
+        }
+        while (m_dequeuePos.load(std::memory_order_acquire) != m_enqueuePos.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    
+    uint64_t GetDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    
+private:
+    // Write out every published message; returns false if the ring was empty
+    bool DrainOnce() {
+        bool wrote = false;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            LogSlot& slot = m_slots[pos & (RingCapacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                break;
+            }
+            
+            WriteMessage(slot.level, slot.message);
+            wrote = true;
+            
+            slot.sequence.store(pos + RingCapacity, std::memory_order_release);
+            ++pos;
+            m_dequeuePos.store(pos, std::memory_order_release);
+        }
+        if (wrote) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+        }
+        return wrote;
+    }
+    
+    void DrainLoop() {
+        while (m_running.load(std::memory_order_acquire)) {
+            if (!DrainOnce()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        DrainOnce();
+    }
+    
+    LogSlot m_slots[RingCapacity];
+    std::atomic<size_t> m_enqueuePos;
+    std::atomic<size_t> m_dequeuePos;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_direct;
+    std::thread m_thread;
+};
+
+LogRing& GetRing() {
+    static LogRing* ring = [] {
+        LogRing* created = new LogRing();
+        std::atexit([] { GetRing().Shutdown(); });
+        return created;
+    }();
+    return *ring;
+}
+
+const char* LevelPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "[trace] ";
+        case LogLevel::Debug: return "[debug] ";
+        case LogLevel::Info:  return "[info] ";
+        case LogLevel::Warn:  return "[warn] ";
+        case LogLevel::Error: return "[error] ";
+    }
+    return "";
+}
+
+} // namespace
+
+void Logger::Write(LogLevel level, const char* format, ...) {
+    LogRing& ring = GetRing();
+    if (ring.IsDirect()) {
+        char message[MessageCapacity];
+        int prefixLength = std::snprintf(message, MessageCapacity, "%s", LevelPrefix(level));
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(message + prefixLength, MessageCapacity - prefixLength, format, args);
+        va_end(args);
+        WriteMessage(level, message);
+        return;
+    }
+    
+    LogSlot* slot = ring.Claim();
+    if (!slot) {
+        return;
+    }
+    
+    slot->level = level;
+    int prefixLength = std::snprintf(slot->message, MessageCapacity, "%s", LevelPrefix(level));
+    
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(slot->message + prefixLength, MessageCapacity - prefixLength, format, args);
+    va_end(args);
+    
+    ring.Publish(slot);
+}
+
+void Logger::Flush() {
+    GetRing().Flush();
+}
+
+uint64_t Logger::GetDroppedCount() {
+    return GetRing().GetDropped();
+}
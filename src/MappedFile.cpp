@@ -0,0 +1,118 @@
+#include "MappedFile.h"
+#include "Log.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("Failed to open %s", path.c_str());
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        LOG_ERROR("Failed to read the size of %s", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+    // Empty files cannot be mapped, and there is nothing to map
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+    // The view keeps the mapping and file alive once both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (!view) {
+        LOG_ERROR("Failed to map %s", path.c_str());
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        LOG_ERROR("Failed to open %s", path.c_str());
+        return false;
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        LOG_ERROR("Failed to read the size of %s", path.c_str());
+        close(file);
+        return false;
+    }
+    // mmap rejects a zero length, and there is nothing to map
+    if (status.st_size == 0) {
+        close(file);
+        return true;
+    }
+    // The mapping stays valid after the descriptor is closed
+    void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        LOG_ERROR("Failed to map %s", path.c_str());
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(status.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+    if (!m_data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+void MappedFile::AdviseSequential() const {
+#ifndef _WIN32
+    if (m_data) {
+        madvise(const_cast<uint8_t*>(m_data), m_size, MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+void MappedFile::Release(size_t offset, size_t size) const {
+#ifndef _WIN32
+    // madvise wants page-aligned ranges; only whole pages inside the range go
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = (offset + pageSize - 1) / pageSize * pageSize;
+    size_t end = (offset + size) / pageSize * pageSize;
+    if (m_data && begin < end && end <= m_size) {
+        madvise(const_cast<uint8_t*>(m_data) + begin, end - begin, MADV_DONTNEED);
+    }
+#else
+    (void)offset;
+    (void)size;
+#endif
+}
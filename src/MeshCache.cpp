@@ -0,0 +1,95 @@
+#include "MeshCache.h"
+#include <cmath>
+#include <vector>
+
+MeshCache& MeshCache::Instance() {
+    static MeshCache instance;
+    return instance;
+}
+
+const Mesh& MeshCache::Get(Primitive primitive) {
+    auto it = m_meshes.find(primitive);
+    if (it != m_meshes.end()) {
+        return it->second;
+    }
+    
+    Mesh mesh = {};
+    switch (primitive) {
+        case Primitive::Sphere:
+            mesh = BuildSphere();
+            break;
+    }
+    return m_meshes.emplace(primitive, mesh).first->second;
+}
+
+void MeshCache::Release() {
+    for (auto& entry : m_meshes) {
+        glDeleteBuffers(1, &entry.second.vbo);
+        glDeleteBuffers(1, &entry.second.ebo);
+    }
+    m_meshes.clear();
+}
+
+Mesh MeshCache::BuildSphere() {
+    // Create a proper sphere
+    const int latitudeSegments = 16;
+    const int longitudeSegments = 16;
+    const float radius = SphereRadius;
+    
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    vertices.reserve((latitudeSegments + 1) * (longitudeSegments + 1) * 3);
+    indices.reserve(latitudeSegments * longitudeSegments * 6);
+    
+    // Generate sphere vertices
+    for (int lat = 0; lat <= latitudeSegments; ++lat) {
+        float theta = M_PI * (float)lat / latitudeSegments;
+        float sinTheta = sin(theta);
+        float cosTheta = cos(theta);
+        
+        for (int lon = 0; lon <= longitudeSegments; ++lon) {
+            float phi = 2.0f * M_PI * (float)lon / longitudeSegments;
+            float sinPhi = sin(phi);
+            float cosPhi = cos(phi);
+            
+            vertices.push_back(radius * cosPhi * sinTheta);
+            vertices.push_back(radius * cosTheta);
+            vertices.push_back(radius * sinPhi * sinTheta);
+        }
+    }
+    
+    // Generate indices for triangles
+    for (int lat = 0; lat < latitudeSegments; ++lat) {
+        for (int lon = 0; lon < longitudeSegments; ++lon) {
+            int current = lat * (longitudeSegments + 1) + lon;
+            int next = current + longitudeSegments + 1;
+            
+            // First triangle
+            indices.push_back(current);
+            indices.push_back(next);
+            indices.push_back(current + 1);
+            
+            // Second triangle
+            indices.push_back(next);
+            indices.push_back(next + 1);
+            indices.push_back(current + 1);
+        }
+    }
+    
+    Mesh mesh;
+    mesh.vertexCount = vertices.size() / 3;
+    mesh.indexCount = indices.size();
+    
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    
+    return mesh;
+}
@@ -0,0 +1,360 @@
+#include "OverlayRenderer.h"
+#include "UploadRing.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// 5x7 bitmap font for printable ASCII (32..126). Each glyph is seven rows,
+// top to bottom; bit 4 of a row is the leftmost column.
+constexpr int FirstGlyph = 32;
+constexpr int GlyphCount = 95;
+const uint8_t FontGlyphs[GlyphCount][OverlayRenderer::GlyphHeight] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // space
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},  // '!'
+    {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00},  // '"'
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A},  // '#'
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04},  // '$'
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},  // '%'
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D},  // '&'
+    {0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00},  // '''
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},  // '('
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},  // ')'
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00},  // '*'
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},  // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},  // ','
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},  // '.'
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // '/'
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // '1'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // '2'
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // '3'
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // '4'
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // '5'
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // '6'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // '7'
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // '8'
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // '9'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // ':'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08},  // ';'
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},  // '<'
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},  // '='
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},  // '>'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},  // '?'
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E},  // '@'
+    {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // 'A'
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // 'B'
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // 'C'
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // 'D'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // 'E'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // 'F'
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // 'G'
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // 'H'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 'I'
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // 'J'
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // 'L'
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // 'M'
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // 'O'
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // 'P'
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // 'Q'
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // 'R'
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // 'U'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // 'V'
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // 'W'
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // 'X'
+    {0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04},  // 'Y'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // 'Z'
+    {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E},  // '['
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},  // 'backslash'
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E},  // ']'
+    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00},  // '^'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},  // '_'
+    {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00},  // '`'
+    {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F},  // 'a'
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E},  // 'b'
+    {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E},  // 'c'
+    {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F},  // 'd'
+    {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E},  // 'e'
+    {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08},  // 'f'
+    {0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E},  // 'g'
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11},  // 'h'
+    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E},  // 'i'
+    {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C},  // 'j'
+    {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12},  // 'k'
+    {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 'l'
+    {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11},  // 'm'
+    {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11},  // 'n'
+    {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E},  // 'o'
+    {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10},  // 'p'
+    {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01},  // 'q'
+    {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10},  // 'r'
+    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E},  // 's'
+    {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06},  // 't'
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D},  // 'u'
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04},  // 'v'
+    {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A},  // 'w'
+    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11},  // 'x'
+    {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E},  // 'y'
+    {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F},  // 'z'
+    {0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02},  // '{'
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // '|'
+    {0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08},  // '}'
+    {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00},  // '~'
+};
+
+// Atlas layout: 16 x 6 cells of 6 x 8 texels (glyph plus one texel of
+// padding). The cell after the last glyph is solid so rectangles can sample
+// the same texture as text.
+constexpr int AtlasColumns = 16;
+constexpr int AtlasRows = 6;
+constexpr int CellWidth = OverlayRenderer::GlyphAdvance;
+constexpr int CellHeight = OverlayRenderer::GlyphHeight + 1;
+constexpr int AtlasWidth = AtlasColumns * CellWidth;
+constexpr int AtlasHeight = AtlasRows * CellHeight;
+constexpr int SolidCell = GlyphCount;
+
+constexpr int FloatsPerVertex = 8;
+
+}
+
+OverlayRenderer::OverlayRenderer()
+    : m_initialized(false), m_shader(nullptr), m_projectionLoc(-1), m_atlasLoc(-1),
+      m_atlasTexture(0), m_vao(0), m_vbo(0), m_bufferCapacity(0),
+      m_windowWidth(0), m_windowHeight(0), m_projectionWidth(0), m_projectionHeight(0) {
+}
+
+OverlayRenderer::~OverlayRenderer() {
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_vbo) glDeleteBuffers(1, &m_vbo);
+    if (m_atlasTexture) glDeleteTextures(1, &m_atlasTexture);
+}
+
+void OverlayRenderer::Initialize() {
+    InitializeShader();
+    InitializeAtlas();
+    InitializeBuffers();
+    m_initialized = true;
+}
+
+void OverlayRenderer::InitializeShader() {
+    const char* vertexSource = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aTexCoord;
+        layout (location = 2) in vec4 aColor;
+        uniform mat4 projection;
+        out vec2 texCoord;
+        out vec4 color;
+        void main() {
+            gl_Position = projection * vec4(aPos, 0.0, 1.0);
+            texCoord = aTexCoord;
+            color = aColor;
+        }
+    )";
+    
+    const char* fragmentSource = R"(
+        #version 330 core
+        in vec2 texCoord;
+        in vec4 color;
+        uniform sampler2D atlas;
+        out vec4 FragColor;
+        void main() {
+            float coverage = texture(atlas, texCoord).r;
+            if (coverage < 0.5) discard;
+            FragColor = color;
+        }
+    )";
+    
+    m_shader = std::make_unique<Shader>(vertexSource, fragmentSource);
+    m_projectionLoc = m_shader->GetUniformLocation("projection");
+    m_atlasLoc = m_shader->GetUniformLocation("atlas");
+    
+    m_shader->Use();
+    m_shader->SetInt(m_atlasLoc, 0);
+}
+
+void OverlayRenderer::InitializeAtlas() {
+    // Bake the glyph table into a single-channel texture once at startup
+    std::vector<uint8_t> texels(AtlasWidth * AtlasHeight, 0);
+    for (int cell = 0; cell <= SolidCell; ++cell) {
+        int originX = (cell % AtlasColumns) * CellWidth;
+        int originY = (cell / AtlasColumns) * CellHeight;
+        for (int row = 0; row < GlyphHeight; ++row) {
+            uint8_t bits = (cell == SolidCell) ? 0x1F : FontGlyphs[cell][row];
+            for (int col = 0; col < GlyphWidth; ++col) {
+                if (bits & (0x10 >> col)) {
+                    texels[(originY + row) * AtlasWidth + originX + col] = 0xFF;
+                }
+            }
+        }
+    }
+    
+    glGenTextures(1, &m_atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, m_atlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, AtlasWidth, AtlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, texels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    LOG_DEBUG("Overlay font atlas baked (%dx%d)", AtlasWidth, AtlasHeight);
+}
+
+void OverlayRenderer::InitializeBuffers() {
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    
+    GLsizei stride = FloatsPerVertex * sizeof(float);
+    
+    // Position attribute
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+    
+    // Texture coordinate attribute
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    
+    // Color attribute
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    
+    glBindVertexArray(0);
+}
+
+void OverlayRenderer::Begin(int windowWidth, int windowHeight) {
+    m_windowWidth = windowWidth;
+    m_windowHeight = windowHeight;
+    m_vertices.clear();
+}
+
+void OverlayRenderer::AddQuad(float x0, float y0, float x1, float y1,
+                              float u0, float v0, float u1, float v1, const glm::vec4& color) {
+    // Two triangles; v0 belongs to the top edge (y1) because atlas rows are
+    // stored top to bottom
+    m_vertices.insert(m_vertices.end(), {
+        x0, y0, u0, v1, color.x, color.y, color.z, color.w,
+        x1, y0, u1, v1, color.x, color.y, color.z, color.w,
+        x1, y1, u1, v0, color.x, color.y, color.z, color.w,
+        x0, y0, u0, v1, color.x, color.y, color.z, color.w,
+        x1, y1, u1, v0, color.x, color.y, color.z, color.w,
+        x0, y1, u0, v0, color.x, color.y, color.z, color.w
+    });
+}
+
+void OverlayRenderer::AddRect(float x, float y, float width, float height, const glm::vec4& color) {
+    // Sample the middle of the solid cell so filtering never reaches padding
+    float u = ((SolidCell % AtlasColumns) * CellWidth + 2.5f) / AtlasWidth;
+    float v = ((SolidCell / AtlasColumns) * CellHeight + 3.5f) / AtlasHeight;
+    AddQuad(x, y, x + width, y + height, u, v, u, v, color);
+}
+
+void OverlayRenderer::AddRectOutline(float x, float y, float width, float height, float thickness, const glm::vec4& color) {
+    AddRect(x, y, width, thickness, color);
+    AddRect(x, y + height - thickness, width, thickness, color);
+    AddRect(x, y + thickness, thickness, height - 2 * thickness, color);
+    AddRect(x + width - thickness, y + thickness, thickness, height - 2 * thickness, color);
+}
+
+void OverlayRenderer::AddText(const std::string& text, float x, float y, float scale, const glm::vec4& color) {
+    float penX = x;
+    for (char c : text) {
+        int code = static_cast<unsigned char>(c);
+        if (code < FirstGlyph || code >= FirstGlyph + GlyphCount) {
+            code = '?';
+        }
+        
+        int cell = code - FirstGlyph;
+        if (code != ' ') {
+            float u0 = static_cast<float>((cell % AtlasColumns) * CellWidth) / AtlasWidth;
+            float v0 = static_cast<float>((cell / AtlasColumns) * CellHeight) / AtlasHeight;
+            float u1 = u0 + static_cast<float>(GlyphWidth) / AtlasWidth;
+            float v1 = v0 + static_cast<float>(GlyphHeight) / AtlasHeight;
+            AddQuad(penX, y, penX + GlyphWidth * scale, y + GlyphHeight * scale, u0, v0, u1, v1, color);
+        }
+        penX += GlyphAdvance * scale;
+    }
+}
+
+glm::vec2 OverlayRenderer::MeasureText(const std::string& text, float scale) const {
+    if (text.empty()) {
+        return glm::vec2(0.0f);
+    }
+    // The trailing padding column of the last glyph is not part of the text
+    float width = (text.length() * GlyphAdvance - 1) * scale;
+    return glm::vec2(width, GlyphHeight * scale);
+}
+
+void OverlayRenderer::Flush() {
+    PROFILE_SCOPE("OverlayRenderer::Flush");
+    PROFILE_GPU_SCOPE("OverlayRenderer::Flush");
+    
+    if (!m_initialized || m_vertices.empty()) {
+        return;
+    }
+    
+    // Labels rarely change between frames; only touch the buffer when they do
+    if (m_vertices != m_uploadedVertices) {
+        size_t bytes = m_vertices.size() * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        if (bytes > m_bufferCapacity) {
+            glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_DYNAMIC_DRAW);
+            m_bufferCapacity = bytes;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        UploadRing::Instance().Upload(m_vbo, 0, m_vertices.data(), bytes);
+        m_uploadedVertices = m_vertices;
+    }
+    
+    // Save current OpenGL state
+    GLint prevViewport[4];
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    GLboolean prevDepthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean prevBlend = glIsEnabled(GL_BLEND);
+    
+    glViewport(0, 0, m_windowWidth, m_windowHeight);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    m_shader->Use();
+    if (m_windowWidth != m_projectionWidth || m_windowHeight != m_projectionHeight) {
+        float right = static_cast<float>(m_windowWidth);
+        float top = static_cast<float>(m_windowHeight);
+        float projection[16] = {
+            2.0f / right, 0.0f, 0.0f, 0.0f,
+            0.0f, 2.0f / top, 0.0f, 0.0f,
+            0.0f, 0.0f, -1.0f, 0.0f,
+            -1.0f, -1.0f, 0.0f, 1.0f
+        };
+        if (m_projectionLoc != -1) {
+            glUniformMatrix4fv(m_projectionLoc, 1, GL_FALSE, projection);
+        }
+        m_projectionWidth = m_windowWidth;
+        m_projectionHeight = m_windowHeight;
+    }
+    
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_atlasTexture);
+    glBindVertexArray(m_vao);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size() / FloatsPerVertex));
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    // Restore OpenGL state
+    if (prevDepthTest) glEnable(GL_DEPTH_TEST);
+    if (!prevBlend) glDisable(GL_BLEND);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+}
@@ -0,0 +1,104 @@
+#include "PngWriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        tableReady = true;
+    }
+    
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void AppendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Length, type, data, then a CRC over type and data
+void AppendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    AppendBigEndian(out, static_cast<uint32_t>(data.size()));
+    size_t typeOffset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    AppendBigEndian(out, Crc32(out.data() + typeOffset, out.size() - typeOffset));
+}
+
+}
+
+bool WritePng(const std::string& path, int width, int height, const uint8_t* rgba) {
+    if (width <= 0 || height <= 0 || !rgba) {
+        return false;
+    }
+    
+    // Filter byte 0 (none) before every row, rows flipped to top-down
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = height - 1; y >= 0; --y) {
+        raw.push_back(0);
+        const uint8_t* row = rgba + static_cast<size_t>(y) * rowBytes;
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+    
+    // zlib stream of stored deflate blocks (at most 65535 bytes each)
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    size_t offset = 0;
+    do {
+        size_t blockSize = std::min<size_t>(raw.size() - offset, 65535);
+        bool last = offset + blockSize == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(blockSize));
+        zlib.push_back(static_cast<uint8_t>(blockSize >> 8));
+        zlib.push_back(static_cast<uint8_t>(~blockSize));
+        zlib.push_back(static_cast<uint8_t>(~blockSize >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+    
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    AppendBigEndian(zlib, (b << 16) | a);
+    
+    std::vector<uint8_t> header;
+    AppendBigEndian(header, static_cast<uint32_t>(width));
+    AppendBigEndian(header, static_cast<uint32_t>(height));
+    header.push_back(8);  // bit depth
+    header.push_back(6);  // color type: RGBA
+    header.push_back(0);  // deflate
+    header.push_back(0);  // adaptive filtering
+    header.push_back(0);  // no interlace
+    
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    AppendChunk(png, "IHDR", header);
+    AppendChunk(png, "IDAT", zlib);
+    AppendChunk(png, "IEND", {});
+    
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = std::fwrite(png.data(), 1, png.size(), file) == png.size();
+    return std::fclose(file) == 0 && written;
+}
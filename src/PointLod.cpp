@@ -0,0 +1,296 @@
+#include "PointLod.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Cells per axis of the sorting grid; cells are visited in Morton order
+constexpr uint32_t GridBits = 6;
+constexpr uint32_t GridSize = 1u << GridBits;
+
+// Spread the low GridBits bits of v so two zero bits follow each one
+uint32_t SpreadBits(uint32_t v) {
+    v = (v | (v << 8)) & 0x0300F00Fu;
+    v = (v | (v << 4)) & 0x030C30C3u;
+    v = (v | (v << 2)) & 0x09249249u;
+    return v;
+}
+
+uint32_t MortonCell(const glm::vec3& p, const glm::vec3& origin, const glm::vec3& scale) {
+    glm::vec3 cell = (p - origin) * scale;
+    uint32_t x = std::min(static_cast<uint32_t>(std::max(cell.x, 0.0f)), GridSize - 1);
+    uint32_t y = std::min(static_cast<uint32_t>(std::max(cell.y, 0.0f)), GridSize - 1);
+    uint32_t z = std::min(static_cast<uint32_t>(std::max(cell.z, 0.0f)), GridSize - 1);
+    return SpreadBits(x) | (SpreadBits(y) << 1) | (SpreadBits(z) << 2);
+}
+
+// Small deterministic generator for the in-chunk shuffle
+uint32_t NextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+void Grow(glm::vec3& boundsMin, glm::vec3& boundsMax, const glm::vec3& p) {
+    boundsMin = glm::min(boundsMin, p);
+    boundsMax = glm::max(boundsMax, p);
+}
+
+void AddRange(std::vector<PointLodRange>& ranges, uint32_t first, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    // Whole neighboring chunks become one draw
+    if (!ranges.empty() && ranges.back().first + ranges.back().count == first) {
+        ranges.back().count += count;
+        return;
+    }
+    ranges.push_back({first, count});
+}
+
+}
+
+PointLod::PointLod() : m_sortedCount(0), m_refilledSlots(0), m_valid(false) {}
+
+void PointLod::Build(const std::vector<glm::vec3>& positions) {
+    PROFILE_SCOPE("PointLod::Build");
+
+    size_t count = positions.size();
+    m_slots.resize(count);
+    m_slotOfPoint.resize(count);
+    m_chunks.clear();
+    m_sortedCount = count;
+    m_refilledSlots = 0;
+    m_valid = true;
+    m_dirtySlots.clear();
+    if (count == 0) {
+        return;
+    }
+
+    glm::vec3 boundsMin = positions[0];
+    glm::vec3 boundsMax = positions[0];
+    for (const glm::vec3& p : positions) {
+        Grow(boundsMin, boundsMax, p);
+    }
+    glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(1e-6f));
+    glm::vec3 scale = glm::vec3(static_cast<float>(GridSize)) / extent;
+
+    // Counting sort by cell: one pass to count, one to place
+    std::vector<uint32_t> cells(count);
+    std::vector<uint32_t> cellStart(GridSize * GridSize * GridSize + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        cells[i] = MortonCell(positions[i], boundsMin, scale);
+        ++cellStart[cells[i] + 1];
+    }
+    for (size_t cell = 1; cell < cellStart.size(); ++cell) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        m_slots[cellStart[cells[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    size_t chunkCount = (count + ChunkSize - 1) / ChunkSize;
+    m_chunks.resize(chunkCount);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        size_t begin = chunk * ChunkSize;
+        size_t end = std::min(begin + ChunkSize, count);
+
+        // Fisher-Yates, so a prefix of any length samples the whole chunk
+        uint32_t state = static_cast<uint32_t>(chunk) * 2654435761u + 1u;
+        for (size_t slot = end - 1; slot > begin; --slot) {
+            size_t other = begin + NextRandom(state) % (slot - begin + 1);
+            std::swap(m_slots[slot], m_slots[other]);
+        }
+
+        Chunk& bounds = m_chunks[chunk];
+        bounds.boundsMin = positions[m_slots[begin]];
+        bounds.boundsMax = bounds.boundsMin;
+        bounds.shuffled = true;
+        for (size_t slot = begin; slot < end; ++slot) {
+            Grow(bounds.boundsMin, bounds.boundsMax, positions[m_slots[slot]]);
+            m_slotOfPoint[m_slots[slot]] = static_cast<uint32_t>(slot);
+        }
+    }
+}
+
+void PointLod::Update(const std::vector<glm::vec3>& positions, std::vector<PointLodRange>& dirtySlots) {
+    size_t count = positions.size();
+    size_t placed = m_slots.size();
+
+    // Appends stay in store order until they would make up a third of the
+    // slots, so a stream of small additions re-sorts only geometrically
+    // often; refilled slots spread chunks out, so many removals re-sort too
+    size_t unsorted = count - std::min(m_sortedCount, count);
+    size_t limit = std::max<size_t>(m_sortedCount / 2, ChunkSize * 16);
+    if (!m_valid || count < placed || unsorted > limit || m_refilledSlots > limit) {
+        Build(positions);
+        dirtySlots.push_back({0, static_cast<uint32_t>(count)});
+        return;
+    }
+    if (count > placed) {
+        AppendSlots(positions, placed, count);
+        m_dirtySlots.push_back({static_cast<uint32_t>(placed), static_cast<uint32_t>(count - placed)});
+    }
+
+    // Slots refilled by a removal may have been popped by a later one
+    for (const PointLodRange& range : m_dirtySlots) {
+        if (range.first < m_slots.size()) {
+            dirtySlots.push_back({range.first, std::min(range.count, static_cast<uint32_t>(m_slots.size()) - range.first)});
+        }
+    }
+    m_dirtySlots.clear();
+}
+
+void PointLod::AppendSlots(const std::vector<glm::vec3>& positions, size_t begin, size_t end) {
+    for (size_t point = begin; point < end; ++point) {
+        size_t slot = m_slots.size();
+        m_slots.push_back(static_cast<uint32_t>(point));
+        m_slotOfPoint.push_back(static_cast<uint32_t>(slot));
+        size_t chunk = slot / ChunkSize;
+        if (chunk == m_chunks.size()) {
+            m_chunks.push_back({positions[point], positions[point], false});
+        } else {
+            Grow(m_chunks[chunk].boundsMin, m_chunks[chunk].boundsMax, positions[point]);
+            m_chunks[chunk].shuffled = false;
+        }
+    }
+}
+
+void PointLod::PointMoved(uint32_t pointIndex, const glm::vec3& position) {
+    if (!m_valid || pointIndex >= m_slotOfPoint.size()) {
+        return;
+    }
+    Chunk& chunk = m_chunks[m_slotOfPoint[pointIndex] / ChunkSize];
+    Grow(chunk.boundsMin, chunk.boundsMax, position);
+}
+
+void PointLod::PointRemoved(uint32_t pointIndex, const std::vector<glm::vec3>& positions) {
+    // With points appended since the last Update() the moved point has no
+    // slot yet; that is rare enough to just rebuild
+    size_t placed = m_slotOfPoint.size();
+    if (!m_valid || positions.size() + 1 != placed || pointIndex >= placed) {
+        m_valid = false;
+        return;
+    }
+    uint32_t last = static_cast<uint32_t>(placed - 1);
+    uint32_t freed = m_slotOfPoint[pointIndex];
+
+    // The last point keeps its slot under its new index
+    if (pointIndex != last) {
+        uint32_t movedSlot = m_slotOfPoint[last];
+        m_slots[movedSlot] = pointIndex;
+        m_slotOfPoint[pointIndex] = movedSlot;
+        m_dirtySlots.push_back({movedSlot, 1});
+    }
+
+    // The point in the final slot fills the freed one, so slots stay dense
+    uint32_t finalSlot = static_cast<uint32_t>(m_slots.size() - 1);
+    if (freed != finalSlot) {
+        uint32_t filler = m_slots[finalSlot];
+        m_slots[freed] = filler;
+        m_slotOfPoint[filler] = freed;
+        Chunk& chunk = m_chunks[freed / ChunkSize];
+        Grow(chunk.boundsMin, chunk.boundsMax, positions[filler]);
+        m_dirtySlots.push_back({freed, 1});
+        ++m_refilledSlots;
+    }
+    m_slots.pop_back();
+    m_slotOfPoint.pop_back();
+    if (m_slots.size() <= (m_chunks.size() - 1) * ChunkSize) {
+        m_chunks.pop_back();
+    }
+    m_sortedCount = std::min(m_sortedCount, m_slots.size());
+}
+
+void PointLod::Select(const std::vector<glm::vec3>& positions, const PointLodView& view,
+                      PointLodSelection& selection) const {
+    PROFILE_SCOPE("PointLod::Select");
+
+    selection.geometryPositions.clear();
+    selection.impostors.clear();
+    selection.dots.clear();
+    selection.stats = PointLodStats();
+    selection.stats.chunks = m_chunks.size();
+
+    // Frustum planes (inside is positive), from the rows of the matrix
+    const glm::mat4& m = view.viewProjection;
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; ++i) {
+        row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    }
+    glm::vec4 planes[6] = {row[3] + row[0], row[3] - row[0], row[3] + row[1],
+                           row[3] - row[1], row[3] + row[2], row[3] - row[2]};
+
+    float radius = view.pointRadius;
+    m_geometryCandidates.clear();
+    for (size_t chunk = 0; chunk < m_chunks.size(); ++chunk) {
+        glm::vec3 boundsMin = m_chunks[chunk].boundsMin - glm::vec3(radius);
+        glm::vec3 boundsMax = m_chunks[chunk].boundsMax + glm::vec3(radius);
+        uint32_t first = static_cast<uint32_t>(chunk * ChunkSize);
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(ChunkSize, m_slots.size() - first));
+
+        // Culled when the corner furthest along a plane's normal is outside it
+        bool visible = true;
+        for (const glm::vec4& plane : planes) {
+            glm::vec3 corner(plane.x > 0.0f ? boundsMax.x : boundsMin.x,
+                             plane.y > 0.0f ? boundsMax.y : boundsMin.y,
+                             plane.z > 0.0f ? boundsMax.z : boundsMin.z);
+            if (plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.0f) {
+                visible = false;
+                break;
+            }
+        }
+        if (!visible) {
+            ++selection.stats.culledChunks;
+            continue;
+        }
+
+        // The chunk's level comes from its largest point on screen
+        float nearest = glm::length(view.eye - glm::clamp(view.eye, boundsMin, boundsMax));
+        float nearestPixels = radius * view.pixelsPerUnit / std::max(nearest, 1e-4f);
+        if (nearestPixels >= GeometryPixels) {
+            m_geometryCandidates.emplace_back(nearest, static_cast<uint32_t>(chunk));
+            continue;
+        }
+
+        // Enough of the shuffled prefix to cover the chunk's screen footprint
+        uint32_t drawn = count;
+        if (m_chunks[chunk].shuffled) {
+            glm::vec3 center = 0.5f * (boundsMin + boundsMax);
+            float halfDiagonal = 0.5f * glm::length(boundsMax - boundsMin);
+            float distance = std::max(glm::length(view.eye - center), halfDiagonal);
+            float spread = halfDiagonal * view.pixelsPerUnit / distance;
+            float footprint = std::min(3.14159265f * spread * spread, view.viewportPixels);
+            float pointPixels = radius * view.pixelsPerUnit / distance;
+            float needed = CoverageFactor * footprint / std::max(4.0f * pointPixels * pointPixels, 1.0f);
+            drawn = static_cast<uint32_t>(std::min(std::ceil(needed), static_cast<float>(count)));
+            drawn = std::max(drawn, 1u);
+        }
+        selection.stats.skippedPoints += count - drawn;
+        if (nearestPixels >= ImpostorPixels) {
+            AddRange(selection.impostors, first, drawn);
+            selection.stats.impostorPoints += drawn;
+        } else {
+            AddRange(selection.dots, first, drawn);
+            selection.stats.dotPoints += drawn;
+        }
+    }
+
+    // Sphere meshes go to the nearest chunks first; the rest are impostors
+    std::sort(m_geometryCandidates.begin(), m_geometryCandidates.end());
+    for (const std::pair<float, uint32_t>& candidate : m_geometryCandidates) {
+        uint32_t first = candidate.second * ChunkSize;
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(ChunkSize, m_slots.size() - first));
+        if (selection.stats.geometryPoints + count <= GeometryBudget) {
+            for (uint32_t slot = first; slot < first + count; ++slot) {
+                selection.geometryPositions.push_back(positions[m_slots[slot]]);
+            }
+            selection.stats.geometryPoints += count;
+        } else {
+            AddRange(selection.impostors, first, count);
+            selection.stats.impostorPoints += count;
+        }
+    }
+}
@@ -0,0 +1,353 @@
+#include "PointPicker.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Aim for a couple of points per cell, but keep the grid bounded so very
+// large clouds do not spend more memory on cells than on points
+constexpr size_t PointsPerCell = 2;
+constexpr size_t MaxCells = size_t(1) << 22;
+constexpr int MaxCellsPerAxis = 1024;
+
+// Appended or loose points scanned linearly before a rebuild is requested
+constexpr size_t MinPendingPoints = 1024;
+
+constexpr uint32_t RemovedEntry = 0xFFFFFFFFu;
+constexpr uint32_t LooseSlot = 0x80000000u;
+
+}
+
+PointPicker::PointPicker()
+    : m_boundsMin(0.0f), m_boundsMax(0.0f), m_cellSize(1.0f), m_inverseCellSize(1.0f),
+      m_dims{0, 0, 0}, m_removedEntries(0), m_indexedCount(0), m_currentStamp(0) {
+}
+
+void PointPicker::Build(const std::vector<glm::vec3>& positions) {
+    m_cellStart.clear();
+    m_cellPoints.clear();
+    m_cellPositions.clear();
+    m_removedEntries = 0;
+    m_indexedCount = 0;
+    m_pointSlots.clear();
+    m_loosePoints.clear();
+    m_cellStamps.clear();
+    m_dims[0] = m_dims[1] = m_dims[2] = 0;
+    if (positions.empty()) {
+        return;
+    }
+
+    m_boundsMin = positions[0];
+    m_boundsMax = positions[0];
+    for (const glm::vec3& p : positions) {
+        m_boundsMin = glm::min(m_boundsMin, p);
+        m_boundsMax = glm::max(m_boundsMax, p);
+    }
+
+    // Choose a cubic cell edge from the axes that actually have extent, so a
+    // planar point set gets a 2D grid instead of collapsing to one cell
+    glm::vec3 extent = m_boundsMax - m_boundsMin;
+    float largest = std::max(extent.x, std::max(extent.y, extent.z));
+    float minimumExtent = std::max(largest * 1e-4f, 1e-6f);
+    size_t targetCells = std::min(std::max(positions.size() / PointsPerCell, size_t(1)), MaxCells);
+
+    double activeVolume = 1.0;
+    int activeAxes = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (extent[axis] > minimumExtent) {
+            activeVolume *= extent[axis];
+            ++activeAxes;
+        }
+    }
+    float cellEdge = activeAxes > 0
+        ? static_cast<float>(std::pow(activeVolume / targetCells, 1.0 / activeAxes))
+        : 1.0f;
+
+    size_t cellCount = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (extent[axis] > minimumExtent) {
+            m_dims[axis] = std::clamp(static_cast<int>(std::ceil(extent[axis] / cellEdge)), 1, MaxCellsPerAxis);
+            m_cellSize[axis] = extent[axis] / m_dims[axis];
+        } else {
+            m_dims[axis] = 1;
+            m_cellSize[axis] = std::max(cellEdge, minimumExtent);
+        }
+        m_inverseCellSize[axis] = 1.0f / m_cellSize[axis];
+        m_boundsMax[axis] = m_boundsMin[axis] + m_cellSize[axis] * m_dims[axis];
+        cellCount *= static_cast<size_t>(m_dims[axis]);
+    }
+
+    // Counting sort of point indices by cell
+    auto cellOf = [this](const glm::vec3& p) {
+        int c[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            c[axis] = std::clamp(static_cast<int>((p[axis] - m_boundsMin[axis]) * m_inverseCellSize[axis]), 0, m_dims[axis] - 1);
+        }
+        return CellIndex(c[0], c[1], c[2]);
+    };
+
+    m_cellStart.assign(cellCount + 1, 0);
+    for (const glm::vec3& p : positions) {
+        ++m_cellStart[cellOf(p) + 1];
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+
+    m_cellPoints.resize(positions.size());
+    m_cellPositions.resize(positions.size());
+    m_pointSlots.resize(positions.size());
+    std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        uint32_t slot = cursor[cellOf(positions[i])]++;
+        m_cellPoints[slot] = static_cast<uint32_t>(i);
+        m_cellPositions[slot] = positions[i];
+        m_pointSlots[i] = slot;
+    }
+    m_indexedCount = positions.size();
+
+    m_cellStamps.assign(cellCount, 0);
+    m_currentStamp = 0;
+}
+
+bool PointPicker::NeedsRebuild(size_t pointCount) const {
+    size_t indexed = m_indexedCount;
+    if (pointCount < indexed || (indexed == 0 && pointCount > 0)) {
+        return true;
+    }
+    size_t budget = std::max(MinPendingPoints, indexed / 8);
+    return pointCount - indexed + m_loosePoints.size() > budget || m_removedEntries > budget;
+}
+
+void PointPicker::PointMoved(uint32_t pointIndex) {
+    // Unindexed and loose points are tested wherever they are
+    if (pointIndex >= m_indexedCount || (m_pointSlots[pointIndex] & LooseSlot)) {
+        return;
+    }
+    Unlink(pointIndex);
+    m_pointSlots[pointIndex] = LooseSlot | static_cast<uint32_t>(m_loosePoints.size());
+    m_loosePoints.push_back(pointIndex);
+}
+
+void PointPicker::PointRemoved(uint32_t pointIndex, size_t pointCount) {
+    uint32_t last = static_cast<uint32_t>(pointCount);
+    if (pointIndex < m_indexedCount) {
+        Unlink(pointIndex);
+    }
+
+    // Renumber the point that took over pointIndex
+    if (pointIndex != last && pointIndex < m_indexedCount) {
+        if (last < m_indexedCount) {
+            uint32_t slot = m_pointSlots[last];
+            if (slot & LooseSlot) {
+                m_loosePoints[slot & ~LooseSlot] = pointIndex;
+            } else {
+                m_cellPoints[slot] = pointIndex;
+            }
+            m_pointSlots[pointIndex] = slot;
+        } else {
+            // It came from the unindexed tail and has no entry yet
+            m_pointSlots[pointIndex] = LooseSlot | static_cast<uint32_t>(m_loosePoints.size());
+            m_loosePoints.push_back(pointIndex);
+        }
+    }
+    if (last < m_indexedCount) {
+        m_indexedCount = pointCount;
+        m_pointSlots.pop_back();
+    }
+}
+
+void PointPicker::Unlink(uint32_t pointIndex) {
+    uint32_t slot = m_pointSlots[pointIndex];
+    if (slot & LooseSlot) {
+        uint32_t moved = m_loosePoints.back();
+        m_loosePoints[slot & ~LooseSlot] = moved;
+        m_pointSlots[moved] = slot;
+        m_loosePoints.pop_back();
+    } else {
+        m_cellPoints[slot] = RemovedEntry;
+        ++m_removedEntries;
+    }
+}
+
+namespace {
+
+// Projects a point and measures it against the cursor. True if its sphere
+// reaches within tolerancePixels; depth is the clip-space w.
+bool ReachesCursor(const glm::mat4& viewProjection, const glm::vec3& position, const glm::vec2& screenPos,
+                   const glm::vec2& viewportSize, float tolerancePixels, float pointRadius, float pixelScale,
+                   float& depth, float& distanceSq) {
+    glm::vec4 clip = viewProjection * glm::vec4(position, 1.0f);
+    if (clip.w <= 0.0f || clip.z < -clip.w || clip.z > clip.w) {
+        return false;
+    }
+    float sx = (clip.x / clip.w * 0.5f + 0.5f) * viewportSize.x;
+    float sy = (0.5f - clip.y / clip.w * 0.5f) * viewportSize.y;
+    float dx = sx - screenPos.x;
+    float dy = sy - screenPos.y;
+    distanceSq = dx * dx + dy * dy;
+    depth = clip.w;
+    float reach = tolerancePixels + pointRadius * pixelScale / clip.w;
+    return distanceSq <= reach * reach;
+}
+
+}
+
+int PointPicker::Pick(const std::vector<glm::vec3>& positions,
+                      const glm::mat4& view, const glm::mat4& projection,
+                      const glm::vec2& screenPos, const glm::vec2& viewportSize,
+                      float tolerancePixels, float pointRadius) {
+    if (positions.empty() || m_cellPoints.empty() || positions.size() < m_indexedCount) {
+        return -1;
+    }
+
+    PickRay ray;
+    if (!PickRay::FromScreen(view, projection, screenPos, viewportSize, ray)) {
+        return -1;
+    }
+    glm::mat4 viewProjection = projection * view;
+
+    int bestIndex = -1;
+    float bestDepth = std::numeric_limits<float>::max();
+    float bestDistanceSq = std::numeric_limits<float>::max();
+    auto testPoint = [&](uint32_t index, const glm::vec3& position) {
+        float depth, distanceSq;
+        if (!ReachesCursor(viewProjection, position, screenPos, viewportSize, tolerancePixels, pointRadius,
+                           ray.pixelScale, depth, distanceSq)) {
+            return;
+        }
+        if (depth < bestDepth || (depth == bestDepth && distanceSq < bestDistanceSq)) {
+            bestIndex = static_cast<int>(index);
+            bestDepth = depth;
+            bestDistanceSq = distanceSq;
+        }
+    };
+
+    // Once something is hit, everything behind it can be skipped
+    March(positions, ray, tolerancePixels, pointRadius, testPoint,
+          [&] { return bestIndex >= 0 ? bestDepth : std::numeric_limits<float>::max(); });
+    return bestIndex;
+}
+
+void PointPicker::Collect(const std::vector<glm::vec3>& positions,
+                          const glm::mat4& view, const glm::mat4& projection,
+                          const glm::vec2& screenPos, const glm::vec2& viewportSize,
+                          float tolerancePixels, float pointRadius, std::vector<uint32_t>& indices) {
+    indices.clear();
+    if (positions.empty() || m_cellPoints.empty() || positions.size() < m_indexedCount) {
+        return;
+    }
+
+    PickRay ray;
+    if (!PickRay::FromScreen(view, projection, screenPos, viewportSize, ray)) {
+        return;
+    }
+    glm::mat4 viewProjection = projection * view;
+
+    auto testPoint = [&](uint32_t index, const glm::vec3& position) {
+        float depth, distanceSq;
+        if (ReachesCursor(viewProjection, position, screenPos, viewportSize, tolerancePixels, pointRadius,
+                          ray.pixelScale, depth, distanceSq)) {
+            indices.push_back(index);
+        }
+    };
+    March(positions, ray, tolerancePixels, pointRadius, testPoint,
+          [] { return std::numeric_limits<float>::max(); });
+}
+
+template <typename Test, typename CutoffDepth>
+void PointPicker::March(const std::vector<glm::vec3>& positions, const PickRay& ray, float tolerancePixels, float pointRadius,
+                        Test testPoint, CutoffDepth cutoffDepth) {
+    const glm::vec3& origin = ray.origin;
+    const glm::vec3& direction = ray.direction;
+    auto coneRadius = [&](float t) {
+        // Upper bound on how far from the ray a pickable point can be
+        return ray.WorldRadiusAt(t, tolerancePixels) + pointRadius;
+    };
+
+    // Points added or moved since the last Build() are not in the grid.
+    // Testing them first also gives the march an earlier cut-off depth.
+    for (uint32_t index : m_loosePoints) {
+        testPoint(index, positions[index]);
+    }
+    for (size_t i = m_indexedCount; i < positions.size(); ++i) {
+        testPoint(static_cast<uint32_t>(i), positions[i]);
+    }
+
+    // Clip the ray to the grid bounds padded by the cone radius. The first
+    // pass pads by the radius at the far plane; the second tightens the
+    // padding to the radius where the ray actually leaves the grid.
+    float tEnter = 0.0f;
+    float tExit = ray.length;
+    for (int pass = 0; pass < 2; ++pass) {
+        float padding = coneRadius(tExit);
+        tEnter = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = m_boundsMin[axis] - padding;
+            float hi = m_boundsMax[axis] + padding;
+            if (std::fabs(direction[axis]) < 1e-12f) {
+                if (origin[axis] < lo || origin[axis] > hi) {
+                    return;
+                }
+                continue;
+            }
+            float t0 = (lo - origin[axis]) / direction[axis];
+            float t1 = (hi - origin[axis]) / direction[axis];
+            if (t0 > t1) std::swap(t0, t1);
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+            if (tEnter > tExit) {
+                return;
+            }
+        }
+    }
+
+    if (++m_currentStamp == 0) {
+        std::fill(m_cellStamps.begin(), m_cellStamps.end(), 0);
+        m_currentStamp = 1;
+    }
+
+    // March the clipped ray, visiting every cell the cone overlaps exactly
+    // once. The step grows with the cone so wide far-field footprints are not
+    // re-scanned every half cell; the search box is widened by the step so
+    // nothing between samples is missed.
+    float minimumStep = 0.5f * std::min(m_cellSize.x, std::min(m_cellSize.y, m_cellSize.z));
+    float step = minimumStep;
+    for (float t = tEnter; ; t += step) {
+        float tc = std::min(t, tExit);
+        step = std::max(minimumStep, 0.5f * coneRadius(tc));
+        float radius = coneRadius(tc + step) + step;
+
+        // Everything left is behind the cut-off
+        if (ray.DepthAt(tc - step) - radius > cutoffDepth()) {
+            break;
+        }
+
+        glm::vec3 center = origin + direction * tc;
+        int lo[3], hi[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = std::clamp(static_cast<int>(std::floor((center[axis] - radius - m_boundsMin[axis]) * m_inverseCellSize[axis])), 0, m_dims[axis] - 1);
+            hi[axis] = std::clamp(static_cast<int>(std::floor((center[axis] + radius - m_boundsMin[axis]) * m_inverseCellSize[axis])), 0, m_dims[axis] - 1);
+        }
+        for (int z = lo[2]; z <= hi[2]; ++z) {
+            for (int y = lo[1]; y <= hi[1]; ++y) {
+                for (int x = lo[0]; x <= hi[0]; ++x) {
+                    int cell = CellIndex(x, y, z);
+                    if (m_cellStamps[cell] != m_currentStamp) {
+                        m_cellStamps[cell] = m_currentStamp;
+                        for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                            if (m_cellPoints[k] != RemovedEntry) {
+                                testPoint(m_cellPoints[k], m_cellPositions[k]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (tc >= tExit) {
+            break;
+        }
+    }
+}
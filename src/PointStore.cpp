@@ -0,0 +1,90 @@
+#include "PointStore.h"
+
+PointId PointStore::Add(const glm::vec3& position) {
+    m_positions.push_back(position);
+    m_selected.PushBack(false);
+    m_hovered.PushBack(false);
+    return m_handles.Push();
+}
+
+void PointStore::Add(const glm::vec3* positions, size_t count, std::vector<PointId>* ids) {
+    m_positions.insert(m_positions.end(), positions, positions + count);
+    m_selected.Resize(m_positions.size());
+    m_hovered.Resize(m_positions.size());
+    
+    if (ids) {
+        ids->reserve(ids->size() + count);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        PointId id = m_handles.Push();
+        if (ids) {
+            ids->push_back(id);
+        }
+    }
+}
+
+void PointStore::Remove(size_t index) {
+    if (index >= m_positions.size()) {
+        return;
+    }
+    
+    // Move the last point into the hole instead of shifting everything after it
+    size_t last = m_positions.size() - 1;
+    if (index != last) {
+        m_positions[index] = m_positions[last];
+        m_selected.Set(index, m_selected.Test(last));
+        m_hovered.Set(index, m_hovered.Test(last));
+    }
+    m_positions.pop_back();
+    m_selected.PopBack();
+    m_hovered.PopBack();
+    m_handles.SwapRemove(index);
+}
+
+void PointStore::Remove(const std::vector<PointId>& ids, std::vector<uint32_t>* newIndexOfPoint) {
+    // Mark first so the arrays are walked once however many points go
+    DynamicBitset removed;
+    removed.Resize(m_positions.size());
+    for (PointId id : ids) {
+        int index = m_handles.IndexOf(id);
+        if (index >= 0) {
+            removed.Set(index, true);
+        }
+    }
+    
+    if (newIndexOfPoint) {
+        newIndexOfPoint->assign(m_positions.size(), InvalidHandleSlot);
+    }
+    
+    size_t kept = 0;
+    for (size_t index = 0; index < m_positions.size(); ++index) {
+        if (removed.Test(index)) {
+            continue;
+        }
+        if (newIndexOfPoint) {
+            (*newIndexOfPoint)[index] = static_cast<uint32_t>(kept);
+        }
+        m_positions[kept] = m_positions[index];
+        m_selected.Set(kept, m_selected.Test(index));
+        m_hovered.Set(kept, m_hovered.Test(index));
+        ++kept;
+    }
+    m_positions.resize(kept);
+    m_selected.Resize(kept);
+    m_hovered.Resize(kept);
+    m_handles.RemoveMarked(removed);
+}
+
+void PointStore::Clear() {
+    m_positions.clear();
+    m_selected.Clear();
+    m_hovered.Clear();
+    m_handles.Clear();
+}
+
+void PointStore::Reserve(size_t count) {
+    m_positions.reserve(count);
+    m_selected.Reserve(count);
+    m_hovered.Reserve(count);
+    m_handles.Reserve(count);
+}
@@ -0,0 +1,310 @@
+#include "Profiler.h"
+
+#if MESHENGINE_PROFILER
+
+#include "OverlayRenderer.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+// Trace track for GPU zones, after any plausible number of CPU threads
+constexpr uint32_t GpuTrackIndex = 1000;
+
+// Overlay graph geometry and scale, in window pixels
+constexpr float GraphBarWidth = 2.0f;
+constexpr float GraphHeight = 80.0f;
+constexpr float GraphFullScaleMs = 33.3f;
+
+std::chrono::steady_clock::time_point ProfilerEpoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+}
+
+Profiler& Profiler::Instance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : m_gpuQueriesReady(false), m_gpuQueriesFailed(false), m_gpuClockOffsetNs(0), m_gpuDepth(0),
+      m_droppedGpuFrames(0), m_frameIndex(0), m_frameStartNs(0), m_inFrame(false), m_overlayVisible(false) {
+    ProfilerEpoch();
+    m_gpuBuffer.threadIndex = GpuTrackIndex;
+    m_gpuBuffer.depth = 0;
+    m_gpuBuffer.events.reset(new ProfileEvent[ThreadRingSize]);
+    m_gpuBuffer.written.store(0, std::memory_order_relaxed);
+    for (GpuFrame& frame : m_gpuFrames) {
+        std::fill(std::begin(frame.queries), std::end(frame.queries), 0u);
+        frame.zoneCount = 0;
+        frame.lastQuery = 0;
+        frame.frameIndex = 0;
+        frame.pending = false;
+    }
+    std::fill(std::begin(m_cpuFrameMs), std::end(m_cpuFrameMs), 0.0f);
+    std::fill(std::begin(m_gpuFrameMs), std::end(m_gpuFrameMs), 0.0f);
+}
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - ProfilerEpoch()).count());
+}
+
+Profiler::ThreadBuffer& Profiler::CurrentThreadBuffer() {
+    // Registered once per thread; afterwards recording never touches the mutex
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Profiler& profiler = Instance();
+        auto created = std::make_unique<ThreadBuffer>();
+        created->depth = 0;
+        created->events.reset(new ProfileEvent[ThreadRingSize]);
+        created->written.store(0, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(profiler.m_threadsMutex);
+        created->threadIndex = static_cast<uint32_t>(profiler.m_threads.size());
+        buffer = created.get();
+        profiler.m_threads.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+void Profiler::Record(ThreadBuffer& buffer, const ProfileEvent& event) {
+    // Single writer per ring; the release store publishes the event to exporters
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index & (ThreadRingSize - 1)] = event;
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+uint32_t Profiler::EnterZone() {
+    return CurrentThreadBuffer().depth++;
+}
+
+void Profiler::LeaveZone(const char* name, uint64_t startNs, uint32_t depth) {
+    uint64_t endNs = Now();
+    ThreadBuffer& buffer = CurrentThreadBuffer();
+    buffer.depth = depth;
+    Record(buffer, ProfileEvent{name, startNs, endNs, depth});
+}
+
+bool Profiler::InitializeGpuQueries() {
+    if (m_gpuQueriesReady || m_gpuQueriesFailed) {
+        return m_gpuQueriesReady;
+    }
+
+    for (GpuFrame& frame : m_gpuFrames) {
+        glGenQueries(MaxGpuZones * 2, frame.queries);
+        if (frame.queries[0] == 0) {
+            // No timer query support (or no context); keep CPU zones only
+            LOG_WARN("GPU timer queries unavailable; profiling CPU only");
+            m_gpuQueriesFailed = true;
+            return false;
+        }
+    }
+
+    // GL timestamps use their own clock; line them up with the CPU timeline
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    m_gpuClockOffsetNs = static_cast<int64_t>(gpuNow) - static_cast<int64_t>(Now());
+    m_gpuQueriesReady = true;
+    return true;
+}
+
+int Profiler::BeginGpuZone(const char* name) {
+    if (!m_inFrame || !InitializeGpuQueries()) {
+        return -1;
+    }
+    GpuFrame& frame = m_gpuFrames[m_frameIndex % GpuFrameLatency];
+    if (frame.zoneCount == MaxGpuZones) {
+        return -1;
+    }
+
+    int zone = frame.zoneCount++;
+    frame.names[zone] = name;
+    frame.depths[zone] = m_gpuDepth++;
+    glQueryCounter(frame.queries[zone * 2], GL_TIMESTAMP);
+    return zone;
+}
+
+void Profiler::EndGpuZone(int zone) {
+    if (zone < 0) {
+        return;
+    }
+    GpuFrame& frame = m_gpuFrames[m_frameIndex % GpuFrameLatency];
+    frame.lastQuery = frame.queries[zone * 2 + 1];
+    glQueryCounter(frame.lastQuery, GL_TIMESTAMP);
+    m_gpuDepth = frame.depths[zone];
+}
+
+void Profiler::BeginFrame() {
+    m_frameStartNs = Now();
+    m_inFrame = true;
+    m_gpuDepth = 0;
+
+    // Reusing this slot's queries: a frame still unread here has been in
+    // flight for GpuFrameLatency frames, so drop it instead of waiting
+    GpuFrame& frame = m_gpuFrames[m_frameIndex % GpuFrameLatency];
+    if (frame.pending && !HarvestGpuFrame(frame)) {
+        ++m_droppedGpuFrames;
+        frame.pending = false;
+    }
+    frame.zoneCount = 0;
+    frame.frameIndex = m_frameIndex;
+}
+
+void Profiler::EndFrame() {
+    if (!m_inFrame) {
+        return;
+    }
+    uint64_t endNs = Now();
+    m_inFrame = false;
+
+    int slot = static_cast<int>(m_frameIndex % HistorySize);
+    m_cpuFrameMs[slot] = static_cast<float>((endNs - m_frameStartNs) * 1e-6);
+    m_gpuFrameMs[slot] = 0.0f;
+    Record(CurrentThreadBuffer(), ProfileEvent{"Frame", m_frameStartNs, endNs, 0});
+
+    GpuFrame& current = m_gpuFrames[m_frameIndex % GpuFrameLatency];
+    current.pending = current.zoneCount > 0;
+    ++m_frameIndex;
+
+    // Read back older frames whose queries have completed, oldest first;
+    // queries finish in order, so stop at the first one still running
+    for (int age = GpuFrameLatency - 1; age >= 1; --age) {
+        if (m_frameIndex < static_cast<uint64_t>(age)) {
+            continue;
+        }
+        GpuFrame& frame = m_gpuFrames[(m_frameIndex - age) % GpuFrameLatency];
+        if (frame.pending && !HarvestGpuFrame(frame)) {
+            break;
+        }
+    }
+}
+
+bool Profiler::HarvestGpuFrame(GpuFrame& frame) {
+    // Queries complete in order, so the last one issued covers the frame
+    GLint available = 0;
+    glGetQueryObjectiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+
+    uint64_t frameStart = UINT64_MAX;
+    uint64_t frameEnd = 0;
+    for (int zone = 0; zone < frame.zoneCount; ++zone) {
+        GLuint64 gpuStart = 0;
+        GLuint64 gpuEnd = 0;
+        glGetQueryObjectui64v(frame.queries[zone * 2], GL_QUERY_RESULT, &gpuStart);
+        glGetQueryObjectui64v(frame.queries[zone * 2 + 1], GL_QUERY_RESULT, &gpuEnd);
+        uint64_t startNs = static_cast<uint64_t>(static_cast<int64_t>(gpuStart) - m_gpuClockOffsetNs);
+        uint64_t endNs = static_cast<uint64_t>(static_cast<int64_t>(gpuEnd) - m_gpuClockOffsetNs);
+        Record(m_gpuBuffer, ProfileEvent{frame.names[zone], startNs, endNs, frame.depths[zone]});
+        frameStart = std::min(frameStart, startNs);
+        frameEnd = std::max(frameEnd, endNs);
+    }
+
+    if (frame.zoneCount > 0 && frame.frameIndex + HistorySize > m_frameIndex) {
+        m_gpuFrameMs[frame.frameIndex % HistorySize] = static_cast<float>((frameEnd - frameStart) * 1e-6);
+    }
+    frame.pending = false;
+    return true;
+}
+
+void Profiler::DrawOverlay(OverlayRenderer& overlay, float x, float y) const {
+    int frameCount = static_cast<int>(std::min<uint64_t>(m_frameIndex, HistorySize));
+    float width = GraphBarWidth * HistorySize;
+    float pixelsPerMs = GraphHeight / GraphFullScaleMs;
+
+    overlay.AddRect(x, y, width, GraphHeight, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+
+    float cpuTotal = 0.0f;
+    float gpuTotal = 0.0f;
+    int gpuCount = 0;
+    for (int i = 0; i < frameCount; ++i) {
+        // Oldest on the left, the frame just finished on the right
+        int slot = static_cast<int>((m_frameIndex - frameCount + i) % HistorySize);
+        float cpuMs = m_cpuFrameMs[slot];
+        float gpuMs = m_gpuFrameMs[slot];
+        float barX = x + width - (frameCount - i) * GraphBarWidth;
+
+        glm::vec4 color = cpuMs < 16.7f ? glm::vec4(0.2f, 0.8f, 0.3f, 1.0f)
+                        : cpuMs < 33.3f ? glm::vec4(0.9f, 0.8f, 0.2f, 1.0f)
+                                        : glm::vec4(0.9f, 0.25f, 0.2f, 1.0f);
+        overlay.AddRect(barX, y, GraphBarWidth, std::min(cpuMs * pixelsPerMs, GraphHeight), color);
+        cpuTotal += cpuMs;
+
+        // GPU time as a tick over the CPU bar (0 until its queries land)
+        if (gpuMs > 0.0f) {
+            float tickY = y + std::min(gpuMs * pixelsPerMs, GraphHeight - 2.0f);
+            overlay.AddRect(barX, tickY, GraphBarWidth, 2.0f, glm::vec4(0.3f, 0.8f, 1.0f, 1.0f));
+            gpuTotal += gpuMs;
+            ++gpuCount;
+        }
+    }
+
+    // 60 fps reference line
+    overlay.AddRect(x, y + 16.7f * pixelsPerMs, width, 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "CPU %.2f ms  GPU %.2f ms",
+                  frameCount > 0 ? cpuTotal / frameCount : 0.0f, gpuCount > 0 ? gpuTotal / gpuCount : 0.0f);
+    overlay.AddText(label, x + 4.0f, y + GraphHeight + 4.0f, 2.0f, glm::vec4(1.0f));
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        LOG_ERROR("Failed to open %s", path.c_str());
+        return false;
+    }
+
+    size_t eventCount = 0;
+    auto writeBuffer = [&](const ThreadBuffer& buffer, const char* trackName) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                     eventCount++ ? ",\n" : "", buffer.threadIndex, trackName);
+        uint64_t written = buffer.written.load(std::memory_order_acquire);
+        uint64_t first = written > ThreadRingSize ? written - ThreadRingSize : 0;
+        for (uint64_t i = first; i < written; ++i) {
+            const ProfileEvent& event = buffer.events[i & (ThreadRingSize - 1)];
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         event.name, buffer.threadIndex, event.startNs * 1e-3, (event.endNs - event.startNs) * 1e-3);
+            ++eventCount;
+        }
+    };
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : m_threads) {
+            char trackName[32];
+            std::snprintf(trackName, sizeof(trackName), buffer->threadIndex == 0 ? "Main" : "Thread %u", buffer->threadIndex);
+            writeBuffer(*buffer, trackName);
+        }
+    }
+    writeBuffer(m_gpuBuffer, "GPU");
+    std::fprintf(file, "\n]}\n");
+
+    bool written = std::fclose(file) == 0;
+    if (written) {
+        LOG_INFO("Wrote %zu trace events to %s (%llu GPU frames dropped)", eventCount, path.c_str(),
+                 static_cast<unsigned long long>(m_droppedGpuFrames));
+    }
+    return written;
+}
+
+void Profiler::ReleaseGpuQueries() {
+    if (!m_gpuQueriesReady) {
+        return;
+    }
+    for (GpuFrame& frame : m_gpuFrames) {
+        glDeleteQueries(MaxGpuZones * 2, frame.queries);
+        std::fill(std::begin(frame.queries), std::end(frame.queries), 0u);
+        frame.pending = false;
+    }
+    m_gpuQueriesReady = false;
+}
+
+#endif
@@ -1,13 +1,13 @@
 #include "Renderer.h"
-#include <iostream>
+#include "Log.h"
 
 Renderer::Renderer()
     : m_viewportX(0), m_viewportY(0), m_viewportWidth(800), m_viewportHeight(600), m_initialized(false) {
-    std::cout << "Renderer constructor called" << std::endl;
+    LOG_DEBUG("Renderer constructor called");
 }
 
 Renderer::~Renderer() {
-    std::cout << "Renderer destructor called" << std::endl;
+    LOG_DEBUG("Renderer destructor called");
 }
 
 void Renderer::SetViewport(int x, int y, int width, int height) {
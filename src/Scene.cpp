@@ -1,47 +1,170 @@
 #include "Scene.h"
-#include <iostream>
+#include "MeshCache.h"
+#include "UploadRing.h"
+#include <algorithm>
+#include "Log.h"
+#include "Profiler.h"
+
+namespace {
+
+// Grow [dirtyBegin, dirtyEnd) to cover [begin, end); an empty range is replaced
+void ExtendDirtyRange(size_t& dirtyBegin, size_t& dirtyEnd, size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    if (dirtyBegin >= dirtyEnd) {
+        dirtyBegin = begin;
+        dirtyEnd = end;
+    } else {
+        dirtyBegin = std::min(dirtyBegin, begin);
+        dirtyEnd = std::max(dirtyEnd, end);
+    }
+}
+
+}
 
 Scene::Scene()
-    : m_selectedPoint(-1)
-    , m_selectedLine(-1)
-    , m_hoveredPoint(-1)
-    , m_hoveredLine(-1) {
+    : m_needsRedraw(true)
+    , m_pointVAO(0)
+    , m_pointInstanceVBO(0)
+    , m_pointMeshIndexCount(0)
+    , m_pointInstanceCapacity(0)
+    , m_pointDirtyBegin(0)
+    , m_pointDirtyEnd(0)
+    , m_pointLodEnabled(true)
+    , m_pointSpriteVAO(0)
+    , m_pointLodEBO(0)
+    , m_pointLodCapacity(0)
+    , m_pointNearVAO(0)
+    , m_pointNearVBO(0)
+    , m_viewportWidth(0)
+    , m_viewportHeight(0)
+    , m_pointPickerDirty(true)
+    , m_lineBVHDirty(true)
+    , m_hoverPicking(HoverPicking::Cpu)
+    , m_gpuPickerInitialized(false)
+    , m_hoverCursorValid(false)
+    , m_gpuPickRequested(false)
+    , m_hoverX(0.0)
+    , m_hoverY(0.0)
+    , m_hoverViewportWidth(0)
+    , m_hoverViewportHeight(0)
+    , m_lineVAO(0)
+    , m_lineEBO(0)
+    , m_lineCapacity(0)
+    , m_lineDirtyBegin(0)
+    , m_lineDirtyEnd(0)
+    , m_lineColorLoc(-1)
+    , m_meshVAO(0)
+    , m_meshVBO(0)
+    , m_meshEBO(0)
+    , m_meshDirty(false)
+    , m_cameraUBO(0) {
 }
 
 Scene::~Scene() {
+    if (m_pointVAO) glDeleteVertexArrays(1, &m_pointVAO);
+    if (m_pointInstanceVBO) glDeleteBuffers(1, &m_pointInstanceVBO);
+    if (m_pointSpriteVAO) glDeleteVertexArrays(1, &m_pointSpriteVAO);
+    if (m_pointLodEBO) glDeleteBuffers(1, &m_pointLodEBO);
+    if (m_pointNearVAO) glDeleteVertexArrays(1, &m_pointNearVAO);
+    if (m_pointNearVBO) glDeleteBuffers(1, &m_pointNearVBO);
+    if (m_lineVAO) glDeleteVertexArrays(1, &m_lineVAO);
+    if (m_lineEBO) glDeleteBuffers(1, &m_lineEBO);
+    if (m_meshVAO) glDeleteVertexArrays(1, &m_meshVAO);
+    if (m_meshVBO) glDeleteBuffers(1, &m_meshVBO);
+    if (m_meshEBO) glDeleteBuffers(1, &m_meshEBO);
+    if (m_cameraUBO) glDeleteBuffers(1, &m_cameraUBO);
 }
 
 void Scene::Initialize() {
     // Initialize shaders
     m_pointShader = std::make_unique<Shader>();
+    m_pointImpostorShader = std::make_unique<Shader>();
+    m_pointDotShader = std::make_unique<Shader>();
     m_lineShader = std::make_unique<Shader>();
+    m_meshShader = std::make_unique<Shader>();
     m_gridShader = std::make_unique<Shader>();
     m_axesShader = std::make_unique<Shader>();
     
     // Shader sources for points with constant screen size
+    // aPos is the shared sphere mesh, aOffset the per-instance point position
     const char* pointVertexSource = R"(
         #version 330 core
         layout (location = 0) in vec3 aPos;
+        layout (location = 1) in vec3 aOffset;
         
-        uniform mat4 model;
-        uniform mat4 view;
-        uniform mat4 projection;
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
         uniform float pointSize;
         
+        out float Light;
+        
         void main() {
-            vec4 worldPos = model * vec4(aPos, 1.0);
+            vec4 worldPos = vec4(aPos + aOffset, 1.0);
             vec4 viewPos = view * worldPos;
             gl_Position = projection * viewPos;
             
             // Use constant point size regardless of distance
             gl_PointSize = pointSize;
+            
+            // Headlight; the sphere mesh is centered, so aPos is its normal
+            vec3 normal = mat3(view) * normalize(aPos);
+            Light = 0.35 + 0.65 * max(dot(normal, normalize(-viewPos.xyz)), 0.0);
         }
     )";
     const char* pointFragmentSource = R"(
+        #version 330 core
+        in float Light;
+        out vec4 FragColor;
+        void main() {
+            FragColor = vec4(vec3(1.0, 0.5, 0.2) * Light, 1.0); // Orange color for points
+        }
+    )";
+    
+    // Point sprites for the far levels of detail, sized to the sphere they
+    // stand in for (at most maxPointSize pixels across)
+    const char* pointSpriteVertexSource = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+        
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
+        uniform float pointRadius;
+        uniform float pixelsPerUnit;
+        uniform float maxPointSize;
+        
+        void main() {
+            vec4 viewPos = view * vec4(aPos, 1.0);
+            gl_Position = projection * viewPos;
+            gl_PointSize = clamp(2.0 * pointRadius * pixelsPerUnit / max(-viewPos.z, 0.0001), 1.0, maxPointSize);
+        }
+    )";
+    
+    // Impostor: the sprite shaded as the sphere it covers. Depth stays at
+    // the sphere's center, which keeps early depth testing.
+    const char* pointImpostorFragmentSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        void main() {
+            vec2 coord = gl_PointCoord * 2.0 - 1.0;
+            float distanceSquared = dot(coord, coord);
+            if (distanceSquared > 1.0) {
+                discard;
+            }
+            float light = 0.35 + 0.65 * sqrt(1.0 - distanceSquared); // Headlight, as on the spheres
+            FragColor = vec4(vec3(1.0, 0.5, 0.2) * light, 1.0);
+        }
+    )";
+    const char* pointDotFragmentSource = R"(
         #version 330 core
         out vec4 FragColor;
         void main() {
-            FragColor = vec4(1.0, 0.5, 0.2, 1.0); // Orange color for points
+            FragColor = vec4(vec3(1.0, 0.5, 0.2) * 0.8, 1.0); // A sphere's average shade
         }
     )";
     
@@ -49,19 +172,51 @@ void Scene::Initialize() {
         #version 330 core
         layout (location = 0) in vec3 aPos;
         
-        uniform mat4 model;
-        uniform mat4 view;
-        uniform mat4 projection;
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
         
         void main() {
-            gl_Position = projection * view * model * vec4(aPos, 1.0);
+            gl_Position = projection * view * vec4(aPos, 1.0);
         }
     )";
     const char* lineFragmentSource = R"(
         #version 330 core
+        uniform vec3 lineColor;
         out vec4 FragColor;
         void main() {
-            FragColor = vec4(0.2, 0.5, 1.0, 1.0); // Blue color for lines
+            FragColor = vec4(lineColor, 1.0);
+        }
+    )";
+    
+    // Mesh shader: flat shading from screen-space derivatives of the view
+    // position, so the mesh needs no normal buffer
+    const char* meshVertexSource = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+        
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
+        
+        out vec3 ViewPos;
+        
+        void main() {
+            vec4 viewPos = view * vec4(aPos, 1.0);
+            ViewPos = viewPos.xyz;
+            gl_Position = projection * viewPos;
+        }
+    )";
+    const char* meshFragmentSource = R"(
+        #version 330 core
+        in vec3 ViewPos;
+        out vec4 FragColor;
+        void main() {
+            vec3 normal = normalize(cross(dFdx(ViewPos), dFdy(ViewPos)));
+            float light = 0.25 + 0.75 * abs(dot(normal, normalize(-ViewPos))); // Headlight
+            FragColor = vec4(vec3(0.7, 0.72, 0.75) * light, 1.0); // Light grey for meshes
         }
     )";
     
@@ -70,12 +225,13 @@ void Scene::Initialize() {
         #version 330 core
         layout (location = 0) in vec3 aPos;
         
-        uniform mat4 model;
-        uniform mat4 view;
-        uniform mat4 projection;
+        layout (std140) uniform Camera {
+            mat4 view;
+            mat4 projection;
+        };
         
         void main() {
-            gl_Position = projection * view * model * vec4(aPos, 1.0);
+            gl_Position = projection * view * vec4(aPos, 1.0);
         }
     )";
     const char* gridFragmentSource = R"(
@@ -113,166 +269,610 @@ void Scene::Initialize() {
     )";
     
     if (!m_pointShader->LoadFromStrings(pointVertexSource, pointFragmentSource)) {
-        std::cerr << "Failed to load point shader" << std::endl;
+        LOG_ERROR("Failed to load point shader");
+    }
+    if (!m_pointImpostorShader->LoadFromStrings(pointSpriteVertexSource, pointImpostorFragmentSource)) {
+        LOG_ERROR("Failed to load point impostor shader");
+    }
+    if (!m_pointDotShader->LoadFromStrings(pointSpriteVertexSource, pointDotFragmentSource)) {
+        LOG_ERROR("Failed to load point dot shader");
     }
     if (!m_lineShader->LoadFromStrings(lineVertexSource, lineFragmentSource)) {
-        std::cerr << "Failed to load line shader" << std::endl;
+        LOG_ERROR("Failed to load line shader");
+    }
+    if (!m_meshShader->LoadFromStrings(meshVertexSource, meshFragmentSource)) {
+        LOG_ERROR("Failed to load mesh shader");
     }
     if (!m_gridShader->LoadFromStrings(gridVertexSource, gridFragmentSource)) {
-        std::cerr << "Failed to load grid shader" << std::endl;
+        LOG_ERROR("Failed to load grid shader");
     }
     if (!m_axesShader->LoadFromStrings(axesVertexSource, axesFragmentSource)) {
-        std::cerr << "Failed to load axes shader" << std::endl;
+        LOG_ERROR("Failed to load axes shader");
     }
     
+    // Per-frame camera matrices live in one uniform buffer shared by every scene shader
+    InitializeCameraBlock();
+    m_gridShader->BindUniformBlock("Camera", CameraBlockBinding);
+    m_pointShader->BindUniformBlock("Camera", CameraBlockBinding);
+    m_pointImpostorShader->BindUniformBlock("Camera", CameraBlockBinding);
+    m_pointDotShader->BindUniformBlock("Camera", CameraBlockBinding);
+    m_lineShader->BindUniformBlock("Camera", CameraBlockBinding);
+    m_meshShader->BindUniformBlock("Camera", CameraBlockBinding);
+    
+    // Uniforms that never change are set once here instead of every frame
+    m_pointShader->Use();
+    m_pointShader->SetFloat("pointSize", 20.0f); // Base point size in pixels
+    
+    // Impostors may stand in for near spheres past the geometry budget;
+    // dots never grow past the impostor threshold
+    m_pointImpostorShader->Use();
+    m_pointImpostorShader->SetFloat("pointRadius", MeshCache::SphereRadius);
+    m_pointImpostorShader->SetFloat("maxPointSize", 64.0f);
+    m_pointDotShader->Use();
+    m_pointDotShader->SetFloat("pointRadius", MeshCache::SphereRadius);
+    m_pointDotShader->SetFloat("maxPointSize", 2.0f * PointLod::ImpostorPixels);
+    
+    m_lineColorLoc = m_lineShader->GetUniformLocation("lineColor");
+    
+    m_axesShader->Use();
+    m_axesShader->SetMat4("projection", glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f));
+    m_axesShader->SetMat4("view", glm::mat4(1.0f));
+    m_axesShader->SetMat4("model", glm::mat4(1.0f));
+    glUseProgram(0);
+    
     m_camera = std::make_unique<Camera>(glm::vec3(0.0f, 0.0f, 3.0f));
     
     // Initialize grid and axes
     InitializeGrid();
     InitializeAxes();
+    
+    // Initialize the shared point mesh and instance buffer
+    InitializePointBatch();
+    InitializePointLod();
+    
+    // Initialize the shared line buffer
+    InitializeLineBatch();
+    
+    // Initialize the mesh buffers
+    InitializeMeshBatch();
 }
 
 void Scene::Update() {
-    // Update scene logic here
+    PROFILE_SCOPE("Scene::Update");
+    
+    if (m_hoverPicking == HoverPicking::Gpu) {
+        UpdateGpuHover();
+    }
 }
 
 void Scene::Render() {
+    PROFILE_SCOPE("Scene::Render");
+    PROFILE_GPU_SCOPE("Scene::Render");
+    
+    // Upload view/projection once for every shader that reads the Camera block
+    UpdateCameraBlock();
+    
     // Render grid first (background)
     m_gridShader->Use();
-    glm::mat4 view = m_camera->GetViewMatrix();
-    glm::mat4 projection = m_camera->GetProjectionMatrix();
-    
-    m_gridShader->SetMat4("view", view);
-    m_gridShader->SetMat4("projection", projection);
     
     // Enable blending for grid
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Render grid
-    glm::mat4 gridModel = glm::mat4(1.0f);
-    m_gridShader->SetMat4("model", gridModel);
     RenderGrid();
     
     // Disable blending for other objects
     glDisable(GL_BLEND);
     
+    // Render the triangle mesh with a single indexed draw call
+    m_meshShader->Use();
+    RenderMesh();
+    
     // Use point shader for points
     m_pointShader->Use();
-    m_pointShader->SetMat4("view", view);
-    m_pointShader->SetMat4("projection", projection);
     
-    // Calculate constant screen size for points
-    float pointSize = 20.0f; // Base point size in pixels
-    m_pointShader->SetFloat("pointSize", pointSize);
-    
-    // Render points
-    for (const auto& point : m_points) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, point->GetPosition());
-        
-        // No scaling needed - the shader handles constant screen size
-        m_pointShader->SetMat4("model", model);
-        point->Render();
-    }
+    // Render all points with a single instanced draw call
+    RenderPoints();
     
     // Use line shader for lines
     m_lineShader->Use();
-    m_lineShader->SetMat4("view", view);
-    m_lineShader->SetMat4("projection", projection);
     
-    // Render lines
-    for (const auto& line : m_lines) {
-        glm::mat4 model = glm::mat4(1.0f);
-        m_lineShader->SetMat4("model", model);
-        line->Render();
-    }
+    // Render all lines with a single draw call
+    RenderLines();
     
     // Render coordinate axes in top right corner
     RenderAxes();
+    
+    m_needsRedraw = false;
+    m_camera->ClearDirty();
+}
+
+PointId Scene::AddPoint(const glm::vec3& position) {
+    PointId id = m_points.Add(position);
+    MarkPointsDirty(m_points.Size() - 1, m_points.Size());
+    m_needsRedraw = true;
+    return id;
+}
+
+void Scene::AddPoints(const glm::vec3* positions, size_t count, std::vector<PointId>* ids) {
+    if (count == 0) {
+        return;
+    }
+    
+    // One dirty range covers the batch, so the next frame uploads it with a
+    // single buffer transfer
+    size_t first = m_points.Size();
+    m_points.Add(positions, count, ids);
+    MarkPointsDirty(first, m_points.Size());
+    m_needsRedraw = true;
 }
 
-void Scene::AddPoint(const glm::vec3& position) {
-    m_points.push_back(std::make_unique<Point>(position));
+void Scene::ReservePoints(size_t count) {
+    m_points.Reserve(count);
 }
 
 void Scene::RemovePoint(int index) {
-    if (index >= 0 && index < static_cast<int>(m_points.size())) {
-        m_points.erase(m_points.begin() + index);
+    if (index >= 0 && index < static_cast<int>(m_points.Size())) {
+        PointId id = m_points.GetId(index);
+        if (id == m_selectedPoint) m_selectedPoint = InvalidPointId;
+        if (id == m_hoveredPoint) m_hoveredPoint = InvalidPointId;
+        
+        // Lines cannot outlive their endpoints
+        std::vector<LineId> incident;
+        m_lines.ForEachLineAt(static_cast<uint32_t>(index), [&](size_t line) {
+            incident.push_back(m_lines.GetId(line));
+        });
+        for (LineId line : incident) {
+            RemoveLine(line);
+        }
+        
+        // Only the point moved into index changes; its lines are re-pointed
+        // through the adjacency and handles need no fix-up
+        uint32_t last = static_cast<uint32_t>(m_points.Size() - 1);
+        m_points.Remove(index);
+        m_pointLod.PointRemoved(static_cast<uint32_t>(index), m_points.GetPositions());
+        if (static_cast<uint32_t>(index) != last) {
+            m_lines.MovePoint(last, static_cast<uint32_t>(index));
+            m_lines.ForEachLineAt(static_cast<uint32_t>(index), [&](size_t line) {
+                MarkLinesDirty(line, line + 1);
+            });
+            MarkPointsDirty(index, index + 1);
+        }
+        if (!m_pointPickerDirty) {
+            m_pointPicker.PointRemoved(static_cast<uint32_t>(index), m_points.Size());
+        }
+        m_needsRedraw = true;
+    }
+}
+
+void Scene::RemovePoint(PointId id) {
+    int index = m_points.IndexOf(id);
+    if (index >= 0) {
+        RemovePoint(index);
     }
 }
 
+void Scene::RemovePoints(const std::vector<PointId>& ids) {
+    if (ids.empty()) {
+        return;
+    }
+    
+    std::vector<LineId> incident;
+    for (PointId id : ids) {
+        int index = m_points.IndexOf(id);
+        if (index >= 0) {
+            m_lines.ForEachLineAt(static_cast<uint32_t>(index), [&](size_t line) {
+                incident.push_back(m_lines.GetId(line));
+            });
+        }
+    }
+    RemoveLines(incident);
+    
+    // Selection and hover handles of removed points simply stop resolving
+    std::vector<uint32_t> newIndexOfPoint;
+    m_points.Remove(ids, &newIndexOfPoint);
+    m_lines.RemapPoints(newIndexOfPoint);
+    if (m_points.IndexOf(m_selectedPoint) < 0) m_selectedPoint = InvalidPointId;
+    if (m_points.IndexOf(m_hoveredPoint) < 0) m_hoveredPoint = InvalidPointId;
+    
+    // Survivors slide down to close the gaps, so everything is re-sent
+    MarkPointsDirty(0, m_points.Size());
+    m_pointLod.Invalidate();
+    MarkLinesDirty(0, m_lines.Size());
+    m_pointPickerDirty = true;
+    m_needsRedraw = true;
+}
+
 void Scene::SelectPoint(int index) {
-    if (index >= 0 && index < static_cast<int>(m_points.size())) {
-        m_selectedPoint = index;
+    if (index >= 0 && index < static_cast<int>(m_points.Size())) {
+        m_selectedPoint = m_points.GetId(index);
         // Deselect all other points
-        for (auto& point : m_points) {
-            point->SetSelected(false);
-        }
-        m_points[index]->SetSelected(true);
+        m_points.ClearSelection();
+        m_points.SetSelected(index, true);
+        m_needsRedraw = true;
     }
 }
 
 void Scene::DeselectAll() {
-    m_selectedPoint = -1;
-    m_selectedLine = -1;
-    for (auto& point : m_points) {
-        point->SetSelected(false);
+    m_selectedPoint = InvalidPointId;
+    m_selectedLine = InvalidLineId;
+    m_points.ClearSelection();
+    m_lines.ClearSelection();
+    m_needsRedraw = true;
+}
+
+void Scene::SetPointPosition(int index, const glm::vec3& position) {
+    if (index >= 0 && index < static_cast<int>(m_points.Size())) {
+        m_points.SetPosition(index, position);
+        MarkPointsDirty(index, index + 1);
+        m_pointLod.PointMoved(static_cast<uint32_t>(index), position);
+        if (!m_pointPickerDirty) {
+            m_pointPicker.PointMoved(static_cast<uint32_t>(index));
+        }
+        
+        // Lines read the position through their point indices, so their GPU
+        // data is unchanged; only the incident lines' bounds need refitting
+        if (!m_lineBVHDirty) {
+            m_lines.ForEachLineAt(static_cast<uint32_t>(index), [&](size_t line) {
+                m_lineBVH.Refit(line, m_points.GetPositions(), m_lines.GetIndices());
+            });
+        }
+        m_needsRedraw = true;
+    }
+}
+
+LineId Scene::AddLine(PointId start, PointId end) {
+    int startIndex = m_points.IndexOf(start);
+    int endIndex = m_points.IndexOf(end);
+    if (startIndex < 0 || endIndex < 0 || startIndex == endIndex) {
+        return InvalidLineId;
+    }
+    
+    LineId id = m_lines.Add(static_cast<uint32_t>(startIndex), static_cast<uint32_t>(endIndex));
+    MarkLinesDirty(m_lines.Size() - 1, m_lines.Size());
+    m_needsRedraw = true;
+    return id;
+}
+
+void Scene::AddLines(const PointId* endpoints, size_t lineCount, std::vector<LineId>* ids) {
+    // Resolve every pair first so the store appends the accepted lines in one go
+    std::vector<uint32_t> indices;
+    std::vector<size_t> accepted;
+    indices.reserve(lineCount * 2);
+    for (size_t i = 0; i < lineCount; ++i) {
+        int startIndex = m_points.IndexOf(endpoints[i * 2]);
+        int endIndex = m_points.IndexOf(endpoints[i * 2 + 1]);
+        if (startIndex < 0 || endIndex < 0 || startIndex == endIndex) {
+            continue;
+        }
+        indices.push_back(static_cast<uint32_t>(startIndex));
+        indices.push_back(static_cast<uint32_t>(endIndex));
+        if (ids) {
+            accepted.push_back(i);
+        }
+    }
+    
+    size_t first = m_lines.Size();
+    size_t count = indices.size() / 2;
+    std::vector<LineId> added;
+    m_lines.Add(indices.data(), count, ids ? &added : nullptr);
+    if (ids) {
+        size_t base = ids->size();
+        ids->resize(base + lineCount, InvalidLineId);
+        for (size_t k = 0; k < count; ++k) {
+            (*ids)[base + accepted[k]] = added[k];
+        }
     }
-    for (auto& line : m_lines) {
-        line->SetSelected(false);
+    
+    if (count > 0) {
+        MarkLinesDirty(first, m_lines.Size());
+        m_needsRedraw = true;
     }
 }
 
-void Scene::AddLine(const glm::vec3& start, const glm::vec3& end) {
-    m_lines.push_back(std::make_unique<Line>(start, end));
+void Scene::AddIndexedLines(const uint32_t* pointIndices, size_t lineCount) {
+    size_t pointCount = m_points.Size();
+    auto valid = [&](size_t line) {
+        uint32_t start = pointIndices[line * 2];
+        uint32_t end = pointIndices[line * 2 + 1];
+        return start < pointCount && end < pointCount && start != end;
+    };
+    
+    // Well-formed input, the usual case, goes to the store without a copy
+    size_t first = m_lines.Size();
+    size_t line = 0;
+    while (line < lineCount && valid(line)) {
+        ++line;
+    }
+    m_lines.Add(pointIndices, line);
+    if (line < lineCount) {
+        std::vector<uint32_t> indices;
+        size_t skipped = 0;
+        for (; line < lineCount; ++line) {
+            if (valid(line)) {
+                indices.push_back(pointIndices[line * 2]);
+                indices.push_back(pointIndices[line * 2 + 1]);
+            } else {
+                ++skipped;
+            }
+        }
+        LOG_WARN("Skipped %zu lines with invalid endpoints", skipped);
+        m_lines.Add(indices.data(), indices.size() / 2);
+    }
+    
+    if (m_lines.Size() > first) {
+        MarkLinesDirty(first, m_lines.Size());
+        m_needsRedraw = true;
+    }
 }
 
 void Scene::RemoveLine(int index) {
-    if (index >= 0 && index < static_cast<int>(m_lines.size())) {
-        m_lines.erase(m_lines.begin() + index);
+    if (index >= 0 && index < static_cast<int>(m_lines.Size())) {
+        LineId id = m_lines.GetId(index);
+        if (id == m_selectedLine) m_selectedLine = InvalidLineId;
+        if (id == m_hoveredLine) m_hoveredLine = InvalidLineId;
+        
+        // The last line moves into index; that is the only slot to re-upload
+        size_t last = m_lines.Size() - 1;
+        m_lines.Remove(index);
+        MarkLinesDirty(index, index + 1);
+        if (!m_lineBVHDirty) {
+            m_lineBVH.LineRemoved(index, last, m_points.GetPositions(), m_lines.GetIndices());
+        }
+        m_needsRedraw = true;
+    }
+}
+
+void Scene::RemoveLine(LineId id) {
+    int index = m_lines.IndexOf(id);
+    if (index >= 0) {
+        RemoveLine(index);
+    }
+}
+
+void Scene::RemoveLines(const std::vector<LineId>& ids) {
+    if (ids.empty()) {
+        return;
     }
+    
+    std::vector<uint32_t> newIndexOfLine;
+    m_lines.Remove(ids, &newIndexOfLine);
+    if (m_lines.IndexOf(m_selectedLine) < 0) m_selectedLine = InvalidLineId;
+    if (m_lines.IndexOf(m_hoveredLine) < 0) m_hoveredLine = InvalidLineId;
+    // Survivors slide down to close the gaps, so everything is re-sent; the
+    // BVH only relabels its entries
+    MarkLinesDirty(0, m_lines.Size());
+    if (!m_lineBVHDirty) {
+        m_lineBVH.LinesRemoved(newIndexOfLine);
+    }
+    m_needsRedraw = true;
 }
 
 void Scene::SelectLine(int index) {
-    if (index >= 0 && index < static_cast<int>(m_lines.size())) {
-        m_selectedLine = index;
+    if (index >= 0 && index < static_cast<int>(m_lines.Size())) {
+        m_selectedLine = m_lines.GetId(index);
         // Deselect all other lines
-        for (auto& line : m_lines) {
-            line->SetSelected(false);
-        }
-        m_lines[index]->SetSelected(true);
+        m_lines.ClearSelection();
+        m_lines.SetSelected(index, true);
+        m_needsRedraw = true;
+    }
+}
+
+bool Scene::SetMesh(std::vector<glm::vec3> positions, std::vector<uint32_t> indices) {
+    size_t vertexCount = positions.size();
+    size_t faceCount = indices.size() / 3;
+    HalfEdgeMesh mesh;
+    if (!mesh.Build(std::move(positions), std::move(indices))) {
+        LOG_ERROR("Invalid mesh: %zu vertices, %zu triangle indices", vertexCount, faceCount * 3);
+        ClearMesh();
+        return false;
+    }
+    SetMesh(std::move(mesh));
+    return true;
+}
+
+void Scene::SetMesh(HalfEdgeMesh mesh) {
+    m_mesh = std::move(mesh);
+    if (!m_mesh.Empty()) {
+        LOG_INFO("Mesh: %zu vertices, %zu triangles, %.1f MB", m_mesh.VertexCount(), m_mesh.FaceCount(),
+                 m_mesh.GetMemoryUsage() / (1024.0 * 1024.0));
+    }
+    if (m_mesh.GetNonManifoldHalfEdgeCount() > 0) {
+        LOG_WARN("Mesh has %zu half-edges on non-manifold edges; they are treated as boundary",
+                 m_mesh.GetNonManifoldHalfEdgeCount());
+    }
+    m_meshDirty = true;
+    m_needsRedraw = true;
+}
+
+void Scene::ClearMesh() {
+    m_mesh.Clear();
+    m_meshDirty = true;
+    m_needsRedraw = true;
+}
+
+void Scene::Clear() {
+    m_points.Clear();
+    m_lines.Clear();
+    m_mesh.Clear();
+    m_selectedPoint = InvalidPointId;
+    m_selectedLine = InvalidLineId;
+    m_hoveredPoint = InvalidPointId;
+    m_hoveredLine = InvalidLineId;
+    m_gpuPicker.DiscardPending();
+    
+    m_pointDirtyBegin = m_pointDirtyEnd = 0;
+    m_lineDirtyBegin = m_lineDirtyEnd = 0;
+    m_pointLod.Invalidate();
+    m_pointPickerDirty = true;
+    m_lineBVHDirty = true;
+    m_meshDirty = true;
+    m_needsRedraw = true;
+}
+
+void Scene::UpdatePointPicker() {
+    // Bulk removals renumber every point, so they force a rebuild; appended,
+    // moved and singly removed points are patched into the picker until
+    // there are enough to re-index
+    const std::vector<glm::vec3>& positions = m_points.GetPositions();
+    if (m_pointPickerDirty || m_pointPicker.NeedsRebuild(positions.size())) {
+        m_pointPicker.Build(positions);
+        m_pointPickerDirty = false;
     }
 }
 
 int Scene::GetPointAtScreenPosition(double screenX, double screenY, int viewportWidth, int viewportHeight) {
-    // Convert screen coordinates to normalized device coordinates
-    // screenX and screenY are already adjusted for the graphics area (panel width subtracted)
-    float normalizedX = (2.0f * screenX) / viewportWidth - 1.0f;
-    float normalizedY = 1.0f - (2.0f * screenY) / viewportHeight;
-    
-    // Simple distance-based selection
-    const float selectionRadius = 0.05f; // Adjust this value for selection sensitivity
-    int closestPoint = -1;
-    float closestDistance = selectionRadius;
-    
-    for (int i = 0; i < static_cast<int>(m_points.size()); ++i) {
-        const auto& point = m_points[i];
-        glm::vec3 pointPos = point->GetPosition();
-        
-        // Convert world position to screen space (simplified)
-        glm::vec3 screenPos = glm::vec3(pointPos.x, pointPos.y, 0.0f);
-        
-        // Calculate distance in screen space
-        float distance = glm::length(glm::vec2(screenPos.x - normalizedX, screenPos.y - normalizedY));
-        
-        if (distance < closestDistance) {
-            closestDistance = distance;
-            closestPoint = i;
+    const std::vector<glm::vec3>& positions = m_points.GetPositions();
+    UpdatePointPicker();
+    
+    const float pickTolerancePixels = 6.0f;
+    return m_pointPicker.Pick(positions, m_camera->GetViewMatrix(), m_camera->GetProjectionMatrix(),
+                              glm::vec2(static_cast<float>(screenX), static_cast<float>(screenY)),
+                              glm::vec2(static_cast<float>(viewportWidth), static_cast<float>(viewportHeight)),
+                              pickTolerancePixels, MeshCache::SphereRadius);
+}
+
+int Scene::GetLineAtScreenPosition(double screenX, double screenY, int viewportWidth, int viewportHeight) {
+    const std::vector<glm::vec3>& positions = m_points.GetPositions();
+    const std::vector<uint32_t>& indices = m_lines.GetIndices();
+    
+    if (m_lineBVHDirty || m_lineBVH.NeedsRebuild(m_lines.Size())) {
+        m_lineBVH.Build(positions, indices);
+        m_lineBVHDirty = false;
+    }
+    
+    PickRay ray;
+    if (!PickRay::FromScreen(m_camera->GetViewMatrix(), m_camera->GetProjectionMatrix(),
+                             glm::vec2(static_cast<float>(screenX), static_cast<float>(screenY)),
+                             glm::vec2(static_cast<float>(viewportWidth), static_cast<float>(viewportHeight)),
+                             ray)) {
+        return -1;
+    }
+    
+    const float pickTolerancePixels = 5.0f;
+    return m_lineBVH.Pick(positions, indices, ray, pickTolerancePixels);
+}
+
+void Scene::UpdateHover(double screenX, double screenY, int viewportWidth, int viewportHeight) {
+    if (m_hoverPicking == HoverPicking::Gpu) {
+        m_hoverX = screenX;
+        m_hoverY = screenY;
+        m_hoverViewportWidth = viewportWidth;
+        m_hoverViewportHeight = viewportHeight;
+        m_hoverCursorValid = true;
+        m_gpuPickRequested = true;
+        return;
+    }
+    
+    int point = GetPointAtScreenPosition(screenX, screenY, viewportWidth, viewportHeight);
+    int line = point < 0 ? GetLineAtScreenPosition(screenX, screenY, viewportWidth, viewportHeight) : -1;
+    SetHover(point, line);
+}
+
+void Scene::SetHover(int pointIndex, int lineIndex) {
+    bool pointValid = pointIndex >= 0 && pointIndex < static_cast<int>(m_points.Size());
+    bool lineValid = lineIndex >= 0 && lineIndex < static_cast<int>(m_lines.Size());
+    PointId point = pointValid ? m_points.GetId(pointIndex) : InvalidPointId;
+    LineId line = lineValid ? m_lines.GetId(lineIndex) : InvalidLineId;
+    if (point == m_hoveredPoint && line == m_hoveredLine) {
+        return;
+    }
+    
+    int previousPoint = m_points.IndexOf(m_hoveredPoint);
+    int previousLine = m_lines.IndexOf(m_hoveredLine);
+    if (previousPoint >= 0) m_points.SetHovered(previousPoint, false);
+    if (previousLine >= 0) m_lines.SetHovered(previousLine, false);
+    m_hoveredPoint = point;
+    m_hoveredLine = line;
+    if (pointValid) m_points.SetHovered(pointIndex, true);
+    if (lineValid) m_lines.SetHovered(lineIndex, true);
+    m_needsRedraw = true;
+}
+
+void Scene::ClearHover() {
+    // Readbacks still in flight were for a cursor that has left the viewport
+    m_hoverCursorValid = false;
+    m_gpuPickRequested = false;
+    m_gpuPicker.DiscardPending();
+    
+    if (!m_hoveredPoint.IsValid() && !m_hoveredLine.IsValid()) {
+        return;
+    }
+    m_hoveredPoint = InvalidPointId;
+    m_hoveredLine = InvalidLineId;
+    m_points.ClearHover();
+    m_lines.ClearHover();
+    m_needsRedraw = true;
+}
+
+void Scene::SetHoverPicking(HoverPicking mode) {
+    if (mode == HoverPicking::Gpu && !m_gpuPickerInitialized) {
+        m_gpuPickerInitialized = m_gpuPicker.Initialize(CameraBlockBinding);
+        if (!m_gpuPickerInitialized) {
+            LOG_WARN("GPU picking unavailable, using CPU hover picking");
+            mode = HoverPicking::Cpu;
         }
     }
+    m_hoverPicking = mode;
+    m_gpuPicker.DiscardPending();
+    m_gpuPickRequested = m_hoverCursorValid && mode == HoverPicking::Gpu;
+    LOG_INFO("Hover picking: %s", mode == HoverPicking::Gpu ? "GPU ID buffer" : "CPU");
+}
+
+bool Scene::IsPickPending() const {
+    return m_hoverPicking == HoverPicking::Gpu && (m_gpuPickRequested || m_gpuPicker.IsReadbackPending());
+}
+
+void Scene::UpdateGpuHover() {
+    // Apply the newest finished readback. Indices can be a frame stale after
+    // removals; SetHover() drops any that are out of range.
+    int point = -1;
+    int line = -1;
+    if (m_gpuPicker.PollResult(point, line) && m_hoverCursorValid) {
+        SetHover(point, line);
+    }
     
-    return closestPoint;
+    // Edits and camera moves change what lies under a still cursor
+    if (m_hoverCursorValid && (m_needsRedraw || m_camera->IsDirty())) {
+        m_gpuPickRequested = true;
+    }
+    if (m_gpuPickRequested) {
+        RenderPickingPass();
+    }
+}
+
+void Scene::RenderPickingPass() {
+    // With every readback slot busy the request stays queued for the next call
+    if (!m_gpuPicker.CanBeginPass()) {
+        return;
+    }
+    m_gpuPickRequested = false;
+    
+    // The pass reads the same GPU buffers as the visible frame
+    if (m_pointDirtyBegin < m_pointDirtyEnd || m_points.Size() > m_pointInstanceCapacity) {
+        UploadPointInstances();
+    }
+    if (m_lineDirtyBegin < m_lineDirtyEnd || m_lines.Size() > m_lineCapacity) {
+        UploadLines();
+    }
+    UpdateCameraBlock();
+    
+    if (!m_gpuPicker.BeginPass(m_hoverX, m_hoverY, m_hoverViewportWidth, m_hoverViewportHeight)) {
+        return;
+    }
+    
+    // Only spheres that can cover a pixel of the pick box are drawn; the
+    // extra pixel allows for the box being snapped to whole pixels
+    const std::vector<glm::vec3>& positions = m_points.GetPositions();
+    UpdatePointPicker();
+    m_pointPicker.Collect(positions, m_camera->GetViewMatrix(), m_camera->GetProjectionMatrix(),
+                          glm::vec2(static_cast<float>(m_hoverX), static_cast<float>(m_hoverY)),
+                          glm::vec2(static_cast<float>(m_hoverViewportWidth), static_cast<float>(m_hoverViewportHeight)),
+                          static_cast<float>(GpuPicker::PickRadius + 1), MeshCache::SphereRadius, m_pickCandidates);
+    m_gpuPicker.DrawPoints(positions, m_pickCandidates);
+    m_gpuPicker.DrawLines(m_lineVAO, static_cast<GLsizei>(m_lines.Size() * 2));
+    m_gpuPicker.EndPass();
 }
 
 void Scene::UpdateViewport(int width, int height) {
@@ -280,6 +880,10 @@ void Scene::UpdateViewport(int width, int height) {
     if (m_camera) {
         m_camera->SetAspectRatio(static_cast<float>(width) / static_cast<float>(height));
     }
+    
+    // Point levels of detail are chosen by size in pixels
+    m_viewportWidth = width;
+    m_viewportHeight = height;
 } 
 
 void Scene::InitializeGrid() {
@@ -371,12 +975,18 @@ void Scene::InitializeAxes() {
 }
 
 void Scene::RenderGrid() {
+    PROFILE_SCOPE("Scene::RenderGrid");
+    PROFILE_GPU_SCOPE("Scene::RenderGrid");
+    
     glBindVertexArray(m_gridVAO);
     glDrawArrays(GL_LINES, 0, m_gridVertexCount);
     glBindVertexArray(0);
 }
 
 void Scene::RenderAxes() {
+    PROFILE_SCOPE("Scene::RenderAxes");
+    PROFILE_GPU_SCOPE("Scene::RenderAxes");
+    
     // Save current viewport
     GLint viewport[4];
     glGetIntegerv(GL_VIEWPORT, viewport);
@@ -385,18 +995,9 @@ void Scene::RenderAxes() {
     int axesSize = 100;
     glViewport(viewport[2] - axesSize - 10, viewport[3] - axesSize - 10, axesSize, axesSize);
     
-    // Use axes shader
+    // Use axes shader (its fixed orthographic matrices are set in Initialize)
     m_axesShader->Use();
     
-    // Set up orthographic projection for axes
-    glm::mat4 axesProjection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-    glm::mat4 axesView = glm::mat4(1.0f);
-    glm::mat4 axesModel = glm::mat4(1.0f);
-    
-    m_axesShader->SetMat4("projection", axesProjection);
-    m_axesShader->SetMat4("view", axesView);
-    m_axesShader->SetMat4("model", axesModel);
-    
     // Render axes
     glBindVertexArray(m_axesVAO);
     glDrawArrays(GL_LINES, 0, m_axesVertexCount);
@@ -404,4 +1005,334 @@ void Scene::RenderAxes() {
     
     // Restore viewport
     glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
-} 
\ No newline at end of file
+}
+
+void Scene::InitializePointBatch() {
+    // The sphere is built once per process; every point is drawn as an instance of it
+    const Mesh& sphere = MeshCache::Instance().Get(Primitive::Sphere);
+    m_pointMeshIndexCount = sphere.indexCount;
+    
+    glGenVertexArrays(1, &m_pointVAO);
+    glGenBuffers(1, &m_pointInstanceVBO);
+    
+    glBindVertexArray(m_pointVAO);
+    
+    // Shared mesh buffers
+    glBindBuffer(GL_ARRAY_BUFFER, sphere.vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphere.ebo);
+    
+    // Instance buffer (one vec3 position per point, advanced once per instance)
+    glBindBuffer(GL_ARRAY_BUFFER, m_pointInstanceVBO);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    
+    glBindVertexArray(0);
+    
+    m_pointInstanceCapacity = 0;
+    MarkPointsDirty(0, m_points.Size());
+}
+
+void Scene::MarkPointsDirty(size_t begin, size_t end) {
+    ExtendDirtyRange(m_pointDirtyBegin, m_pointDirtyEnd, begin, end);
+}
+
+void Scene::UploadPointInstances() {
+    // The store's position array is already the instance buffer layout
+    const std::vector<glm::vec3>& positions = m_points.GetPositions();
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_pointInstanceVBO);
+    if (positions.size() > m_pointInstanceCapacity) {
+        // Grow geometrically so bulk inserts don't reallocate every frame,
+        // or straight to the store's reservation; the new storage is empty
+        // so everything is re-sent
+        m_pointInstanceCapacity = std::max({positions.size(), m_pointInstanceCapacity * 2, positions.capacity()});
+        glBufferData(GL_ARRAY_BUFFER, m_pointInstanceCapacity * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+        MarkPointsDirty(0, positions.size());
+    }
+    
+    // A moved point re-sends one vec3; its lines index it and need nothing
+    size_t end = std::min(m_pointDirtyEnd, positions.size());
+    if (m_pointDirtyBegin < end) {
+        UploadRing::Instance().Upload(m_pointInstanceVBO, m_pointDirtyBegin * sizeof(glm::vec3),
+                                      positions.data() + m_pointDirtyBegin, (end - m_pointDirtyBegin) * sizeof(glm::vec3));
+    }
+    
+    m_pointDirtyBegin = 0;
+    m_pointDirtyEnd = 0;
+}
+
+void Scene::RenderPoints() {
+    PROFILE_SCOPE("Scene::RenderPoints");
+    PROFILE_GPU_SCOPE("Scene::RenderPoints");
+    
+    if (m_pointDirtyBegin < m_pointDirtyEnd || m_points.Size() > m_pointInstanceCapacity) {
+        UploadPointInstances();
+    }
+    
+    if (m_points.Empty()) {
+        m_pointLodSelection.stats = PointLodStats();
+        return;
+    }
+    if (m_pointLodEnabled) {
+        RenderPointLod();
+        return;
+    }
+    
+    glBindVertexArray(m_pointVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, m_pointMeshIndexCount, GL_UNSIGNED_INT, (void*)0, static_cast<GLsizei>(m_points.Size()));
+    glBindVertexArray(0);
+}
+
+void Scene::SetPointLod(bool enabled) {
+    m_pointLodEnabled = enabled;
+    m_pointLodSelection = PointLodSelection();
+    m_needsRedraw = true;
+}
+
+void Scene::InitializePointLod() {
+    const Mesh& sphere = MeshCache::Instance().Get(Primitive::Sphere);
+    
+    // Sprites: point positions as plain vertices, in PointLod's slot order
+    glGenVertexArrays(1, &m_pointSpriteVAO);
+    glGenBuffers(1, &m_pointLodEBO);
+    glBindVertexArray(m_pointSpriteVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_pointInstanceVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_pointLodEBO);
+    glBindVertexArray(0);
+    
+    // Near spheres: the shared mesh instanced over positions gathered per
+    // frame, never more than the geometry budget
+    glGenVertexArrays(1, &m_pointNearVAO);
+    glGenBuffers(1, &m_pointNearVBO);
+    glBindVertexArray(m_pointNearVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, sphere.vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphere.ebo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_pointNearVBO);
+    glBufferData(GL_ARRAY_BUFFER, PointLod::GeometryBudget * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    m_pointLodCapacity = 0;
+    m_pointLod.Invalidate();
+}
+
+void Scene::RenderPointLod() {
+    const std::vector<glm::vec3>& positions = m_points.GetPositions();
+    
+    // Edits move only a few slots; a re-sort or growth re-sends them all
+    m_pointLodDirty.clear();
+    m_pointLod.Update(positions, m_pointLodDirty);
+    const std::vector<uint32_t>& slots = m_pointLod.GetSlots();
+    if (slots.size() > m_pointLodCapacity) {
+        m_pointLodCapacity = std::max(slots.size(), m_pointLodCapacity * 2);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_pointLodEBO);
+        glBufferData(GL_COPY_WRITE_BUFFER, m_pointLodCapacity * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        m_pointLodDirty.assign(1, PointLodRange{0, static_cast<uint32_t>(slots.size())});
+    }
+    for (const PointLodRange& range : m_pointLodDirty) {
+        UploadRing::Instance().Upload(m_pointLodEBO, range.first * sizeof(GLuint), slots.data() + range.first,
+                                      range.count * sizeof(GLuint));
+    }
+    
+    // Pixels per world unit at distance 1 sets every size on screen
+    glm::mat4 projection = m_camera->GetProjectionMatrix();
+    float pixelsPerUnit = 0.5f * projection[1][1] * static_cast<float>(m_viewportHeight);
+    PointLodView view;
+    view.viewProjection = projection * m_camera->GetViewMatrix();
+    view.eye = m_camera->GetPosition();
+    view.pixelsPerUnit = pixelsPerUnit;
+    view.viewportPixels = static_cast<float>(m_viewportWidth) * static_cast<float>(m_viewportHeight);
+    view.pointRadius = MeshCache::SphereRadius;
+    m_pointLod.Select(positions, view, m_pointLodSelection);
+    
+    const std::vector<glm::vec3>& nearPositions = m_pointLodSelection.geometryPositions;
+    if (!nearPositions.empty()) {
+        UploadRing::Instance().Upload(m_pointNearVBO, 0, nearPositions.data(), nearPositions.size() * sizeof(glm::vec3));
+        m_pointShader->Use();
+        glBindVertexArray(m_pointNearVAO);
+        glDrawElementsInstanced(GL_TRIANGLES, m_pointMeshIndexCount, GL_UNSIGNED_INT, (void*)0,
+                                static_cast<GLsizei>(nearPositions.size()));
+    }
+    
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glBindVertexArray(m_pointSpriteVAO);
+    DrawPointSprites(*m_pointImpostorShader, m_pointLodSelection.impostors, pixelsPerUnit);
+    DrawPointSprites(*m_pointDotShader, m_pointLodSelection.dots, pixelsPerUnit);
+    glBindVertexArray(0);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+}
+
+void Scene::DrawPointSprites(Shader& shader, const std::vector<PointLodRange>& ranges, float pixelsPerUnit) {
+    if (ranges.empty()) {
+        return;
+    }
+    shader.Use();
+    shader.SetFloat("pixelsPerUnit", pixelsPerUnit);
+    
+    // Every range of the level in one call
+    m_drawCounts.clear();
+    m_drawOffsets.clear();
+    for (const PointLodRange& range : ranges) {
+        m_drawCounts.push_back(static_cast<GLsizei>(range.count));
+        m_drawOffsets.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(range.first) * sizeof(GLuint)));
+    }
+    glMultiDrawElements(GL_POINTS, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(),
+                        static_cast<GLsizei>(m_drawCounts.size()));
+}
+
+void Scene::InitializeLineBatch() {
+    glGenVertexArrays(1, &m_lineVAO);
+    glGenBuffers(1, &m_lineEBO);
+    
+    // Line vertices are the point positions; each line adds two indices
+    glBindVertexArray(m_lineVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_pointInstanceVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_lineEBO);
+    glBindVertexArray(0);
+    
+    m_lineCapacity = 0;
+    MarkLinesDirty(0, m_lines.Size());
+}
+
+void Scene::MarkLinesDirty(size_t begin, size_t end) {
+    ExtendDirtyRange(m_lineDirtyBegin, m_lineDirtyEnd, begin, end);
+}
+
+void Scene::UploadLines() {
+    // The element buffer binding is VAO state
+    glBindVertexArray(m_lineVAO);
+    
+    if (m_lines.Size() > m_lineCapacity) {
+        // Grow geometrically; the new storage is empty so everything is re-sent
+        m_lineCapacity = std::max(m_lines.Size(), m_lineCapacity * 2);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_lineCapacity * 2 * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+        MarkLinesDirty(0, m_lines.Size());
+    }
+    glBindVertexArray(0);
+    
+    // The store's index array matches the buffer layout, so dirty lines upload without repacking
+    size_t end = std::min(m_lineDirtyEnd, m_lines.Size());
+    if (m_lineDirtyBegin < end) {
+        const uint32_t* indices = m_lines.GetIndices().data() + m_lineDirtyBegin * 2;
+        UploadRing::Instance().Upload(m_lineEBO, m_lineDirtyBegin * 2 * sizeof(GLuint), indices,
+                                      (end - m_lineDirtyBegin) * 2 * sizeof(GLuint));
+    }
+    
+    m_lineDirtyBegin = 0;
+    m_lineDirtyEnd = 0;
+}
+
+void Scene::RenderLines() {
+    PROFILE_SCOPE("Scene::RenderLines");
+    PROFILE_GPU_SCOPE("Scene::RenderLines");
+    
+    // Lines index the point instance buffer, which must be current too
+    if (m_pointDirtyBegin < m_pointDirtyEnd || m_points.Size() > m_pointInstanceCapacity) {
+        UploadPointInstances();
+    }
+    if (m_lineDirtyBegin < m_lineDirtyEnd || m_lines.Size() > m_lineCapacity) {
+        UploadLines();
+    }
+    
+    if (m_lines.Empty()) {
+        return;
+    }
+    
+    glBindVertexArray(m_lineVAO);
+    
+    // Highlighted segments go first: the full batch drawn afterwards lies at
+    // the same depth and fails the depth test there, leaving the highlight
+    int selectedLine = m_lines.IndexOf(m_selectedLine);
+    int hoveredLine = m_lines.IndexOf(m_hoveredLine);
+    if (selectedLine >= 0) {
+        m_lineShader->SetVec3(m_lineColorLoc, glm::vec3(1.0f, 0.85f, 0.1f)); // Yellow for selection
+        glDrawElements(GL_LINES, 2, GL_UNSIGNED_INT, (void*)(selectedLine * 2 * sizeof(GLuint)));
+    }
+    if (hoveredLine >= 0 && hoveredLine != selectedLine) {
+        m_lineShader->SetVec3(m_lineColorLoc, glm::vec3(0.9f, 0.95f, 1.0f)); // Near-white for hover
+        glDrawElements(GL_LINES, 2, GL_UNSIGNED_INT, (void*)(hoveredLine * 2 * sizeof(GLuint)));
+    }
+    
+    m_lineShader->SetVec3(m_lineColorLoc, glm::vec3(0.2f, 0.5f, 1.0f)); // Blue color for lines
+    glDrawElements(GL_LINES, static_cast<GLsizei>(m_lines.Size() * 2), GL_UNSIGNED_INT, (void*)0);
+    glBindVertexArray(0);
+}
+
+void Scene::InitializeMeshBatch() {
+    glGenVertexArrays(1, &m_meshVAO);
+    glGenBuffers(1, &m_meshVBO);
+    glGenBuffers(1, &m_meshEBO);
+    
+    glBindVertexArray(m_meshVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_meshVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_meshEBO);
+    glBindVertexArray(0);
+    
+    m_meshDirty = true;
+}
+
+void Scene::UploadMesh() {
+    // The mesh's vertex and index arrays are already the buffer layouts;
+    // connectivity stays on the CPU
+    const std::vector<glm::vec3>& positions = m_mesh.GetPositions();
+    const std::vector<uint32_t>& indices = m_mesh.GetIndices();
+    
+    glBindVertexArray(m_meshVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), positions.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+    
+    m_meshDirty = false;
+}
+
+void Scene::RenderMesh() {
+    PROFILE_SCOPE("Scene::RenderMesh");
+    PROFILE_GPU_SCOPE("Scene::RenderMesh");
+    
+    if (m_meshDirty) {
+        UploadMesh();
+    }
+    
+    if (m_mesh.Empty()) {
+        return;
+    }
+    
+    glBindVertexArray(m_meshVAO);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_mesh.HalfEdgeCount()), GL_UNSIGNED_INT, (void*)0);
+    glBindVertexArray(0);
+}
+
+void Scene::InitializeCameraBlock() {
+    glGenBuffers(1, &m_cameraUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUBO);
+    glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    glBindBufferBase(GL_UNIFORM_BUFFER, CameraBlockBinding, m_cameraUBO);
+}
+
+void Scene::UpdateCameraBlock() {
+    // std140 layout: two column-major mat4s back to back (view, projection)
+    glm::mat4 matrices[2] = {
+        m_camera->GetViewMatrix(),
+        m_camera->GetProjectionMatrix()
+    };
+    
+    UploadRing::Instance().Upload(m_cameraUBO, 0, matrices, sizeof(matrices));
+}
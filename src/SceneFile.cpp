@@ -0,0 +1,260 @@
+#include "SceneFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// The platform headers come before Scene.h so windows.h, not glad, defines APIENTRY
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Scene.h"
+#include "Log.h"
+#include "Profiler.h"
+
+namespace {
+
+constexpr char Magic[8] = {'M', 'E', 'S', 'H', 'S', 'C', 'N', '\0'};
+constexpr uint32_t Version = 1;
+constexpr uint64_t SectionAlignment = 64;
+
+uint64_t AlignUp(uint64_t offset) {
+    return (offset + SectionAlignment - 1) & ~(SectionAlignment - 1);
+}
+
+// Section offsets for a header's counts; end is the exact file size
+struct SectionLayout {
+    uint64_t points;
+    uint64_t lines;
+    uint64_t meshPositions;
+    uint64_t meshIndices;
+    uint64_t end;
+};
+
+SectionLayout ComputeLayout(const SceneFileHeader& header) {
+    SectionLayout layout;
+    layout.points = AlignUp(sizeof(SceneFileHeader));
+    layout.lines = AlignUp(layout.points + header.pointCount * sizeof(glm::vec3));
+    layout.meshPositions = AlignUp(layout.lines + header.lineCount * 2 * sizeof(uint32_t));
+    layout.meshIndices = AlignUp(layout.meshPositions + header.meshVertexCount * sizeof(glm::vec3));
+    layout.end = layout.meshIndices + header.meshTriangleCount * 3 * sizeof(uint32_t);
+    return layout;
+}
+
+// Fletcher-64 over little-endian 32-bit words. The modulo is deferred to
+// once per block; 65536 words keep the second sum below 2^64.
+class Fletcher64 {
+public:
+    // size must be a multiple of 4
+    void Update(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        size_t words = size / 4;
+        while (words > 0) {
+            size_t block = std::min(words, BlockWords);
+            for (size_t i = 0; i < block; ++i) {
+                uint32_t word;
+                std::memcpy(&word, bytes + i * 4, 4);
+                m_sum1 += word;
+                m_sum2 += m_sum1;
+            }
+            m_sum1 %= Modulus;
+            m_sum2 %= Modulus;
+            bytes += block * 4;
+            words -= block;
+        }
+    }
+
+    uint64_t Value() const { return (m_sum2 << 32) | m_sum1; }
+
+private:
+    static constexpr uint64_t Modulus = 0xFFFFFFFFu;
+    static constexpr size_t BlockWords = 65536;
+
+    uint64_t m_sum1 = 0;
+    uint64_t m_sum2 = 0;
+};
+
+// Sequential section writer: pads with zeros up to each section offset and
+// checksums everything it writes
+class SectionWriter {
+public:
+    SectionWriter(FILE* file, uint64_t position) : m_file(file), m_position(position), m_ok(true) {}
+
+    void Write(uint64_t offset, const void* data, size_t size) {
+        static const uint8_t zeros[SectionAlignment] = {};
+        size_t padding = static_cast<size_t>(offset - m_position);
+        Put(zeros, padding);
+        Put(data, size);
+    }
+
+    bool Ok() const { return m_ok; }
+    uint64_t Checksum() const { return m_checksum.Value(); }
+
+private:
+    void Put(const void* data, size_t size) {
+        if (size == 0 || !m_ok) {
+            return;
+        }
+        m_ok = std::fwrite(data, 1, size, m_file) == size;
+        m_checksum.Update(data, size);
+        m_position += size;
+    }
+
+    FILE* m_file;
+    uint64_t m_position;
+    bool m_ok;
+    Fletcher64 m_checksum;
+};
+
+// Push the file's data to disk before it is renamed into place
+bool SyncFile(FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool MoveIntoPlace(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    // rename() refuses to overwrite on Windows
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+}
+
+bool MappedSceneFile::Open(const std::string& path) {
+    if (!m_file.Open(path)) {
+        return false;
+    }
+    if (m_file.GetSize() < sizeof(SceneFileHeader)) {
+        LOG_ERROR("%s is not a scene file", path.c_str());
+        Close();
+        return false;
+    }
+
+    const SceneFileHeader& header = GetHeader();
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.headerSize != sizeof(SceneFileHeader)) {
+        LOG_ERROR("%s is not a scene file", path.c_str());
+        Close();
+        return false;
+    }
+    if (header.version != Version) {
+        LOG_ERROR("%s has unsupported scene file version %u", path.c_str(), header.version);
+        Close();
+        return false;
+    }
+
+    // Bound the counts first so a corrupt header cannot overflow the layout
+    size_t size = m_file.GetSize();
+    uint64_t maxCount = size / sizeof(uint32_t);
+    SectionLayout layout = ComputeLayout(header);
+    if (header.pointCount > maxCount || header.lineCount > maxCount || header.meshVertexCount > maxCount ||
+        header.meshTriangleCount > maxCount || layout.end != size) {
+        LOG_ERROR("%s is truncated or corrupt (%zu bytes, header expects %llu)", path.c_str(), size,
+                  static_cast<unsigned long long>(layout.end));
+        Close();
+        return false;
+    }
+    m_pointsOffset = static_cast<size_t>(layout.points);
+    m_linesOffset = static_cast<size_t>(layout.lines);
+    m_meshPositionsOffset = static_cast<size_t>(layout.meshPositions);
+    m_meshIndicesOffset = static_cast<size_t>(layout.meshIndices);
+    return true;
+}
+
+bool MappedSceneFile::VerifyChecksum() const {
+    PROFILE_SCOPE("MappedSceneFile::VerifyChecksum");
+
+    if (!IsOpen()) {
+        return false;
+    }
+    m_file.AdviseSequential();
+    Fletcher64 checksum;
+    checksum.Update(m_file.GetData() + sizeof(SceneFileHeader), m_file.GetSize() - sizeof(SceneFileHeader));
+    return checksum.Value() == GetHeader().checksum;
+}
+
+bool SaveSceneFile(const Scene& scene, const std::string& path) {
+    PROFILE_SCOPE("SaveSceneFile");
+
+    const std::vector<glm::vec3>& points = scene.GetPoints().GetPositions();
+    const std::vector<uint32_t>& lines = scene.GetLines().GetIndices();
+    const HalfEdgeMesh& mesh = scene.GetMesh();
+
+    SceneFileHeader header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.headerSize = sizeof(SceneFileHeader);
+    header.pointCount = points.size();
+    header.lineCount = lines.size() / 2;
+    header.meshVertexCount = mesh.VertexCount();
+    header.meshTriangleCount = mesh.FaceCount();
+    SectionLayout layout = ComputeLayout(header);
+
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Failed to open %s", tempPath.c_str());
+        return false;
+    }
+
+    // The header goes in twice: once to reserve its space, then again with
+    // the checksum of everything after it
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    SectionWriter writer(file, sizeof(header));
+    writer.Write(layout.points, points.data(), points.size() * sizeof(glm::vec3));
+    writer.Write(layout.lines, lines.data(), lines.size() * sizeof(uint32_t));
+    writer.Write(layout.meshPositions, mesh.GetPositions().data(), mesh.VertexCount() * sizeof(glm::vec3));
+    writer.Write(layout.meshIndices, mesh.GetIndices().data(), mesh.GetIndices().size() * sizeof(uint32_t));
+    header.checksum = writer.Checksum();
+    written = written && writer.Ok() && std::fseek(file, 0, SEEK_SET) == 0 &&
+              std::fwrite(&header, sizeof(header), 1, file) == 1 && SyncFile(file);
+    written = std::fclose(file) == 0 && written;
+
+    if (!written || !MoveIntoPlace(tempPath, path)) {
+        LOG_ERROR("Failed to write %s", path.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LoadSceneFile(Scene& scene, const std::string& path, bool verifyChecksum) {
+    PROFILE_SCOPE("LoadSceneFile");
+
+    MappedSceneFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    if (verifyChecksum && !file.VerifyChecksum()) {
+        LOG_ERROR("%s failed its checksum; not loading it", path.c_str());
+        return false;
+    }
+
+    // Every section is copied straight out of the mapping in one piece; the
+    // scene then uploads each array with a single transfer on the next frame
+    scene.Clear();
+    scene.AddPoints(file.GetPointPositions(), file.GetPointCount());
+    scene.AddIndexedLines(file.GetLineIndices(), file.GetLineCount());
+    if (file.GetMeshTriangleCount() > 0) {
+        const glm::vec3* positions = file.GetMeshPositions();
+        const uint32_t* indices = file.GetMeshIndices();
+        scene.SetMesh(std::vector<glm::vec3>(positions, positions + file.GetMeshVertexCount()),
+                      std::vector<uint32_t>(indices, indices + file.GetMeshTriangleCount() * 3));
+    }
+    return true;
+}
@@ -0,0 +1,916 @@
+#include "SceneImporter.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include "Scene.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <mutex>
+
+namespace {
+
+// Text parsing
+
+bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+const char* SkipBlanks(const char* p, const char* end) {
+    while (p < end && IsBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+const char* SkipToken(const char* p, const char* end) {
+    while (p < end && !IsBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+// Parse the next number on a line, advancing p past it
+bool ParseFloat(const char*& p, const char* end, float& value) {
+    p = SkipBlanks(p, end);
+    if (p < end && *p == '+') {
+        ++p;
+    }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+    return true;
+#else
+    // Toolchains without floating-point from_chars (GCC before 11, as in
+    // the MinGW build) parse a terminated copy of the token instead
+    const char* tokenEnd = SkipToken(p, end);
+    size_t length = static_cast<size_t>(tokenEnd - p);
+    char token[64];
+    if (length == 0 || length >= sizeof(token)) {
+        return false;
+    }
+    std::memcpy(token, p, length);
+    token[length] = '\0';
+    char* parsed = nullptr;
+    value = std::strtof(token, &parsed);
+    if (parsed != token + length) {
+        return false;
+    }
+    p = tokenEnd;
+    return true;
+#endif
+}
+
+bool ParseInt(const char*& p, const char* end, int64_t& value) {
+    p = SkipBlanks(p, end);
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+    return true;
+}
+
+// Calls visit(begin, end) for every line, without its line break
+template <typename Visitor>
+void ForEachLine(const char* begin, const char* end, Visitor visit) {
+    while (begin < end) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        const char* lineEnd = newline ? newline : end;
+        visit(begin, lineEnd > begin && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd);
+        begin = newline ? newline + 1 : end;
+    }
+}
+
+uint64_t CountLines(const char* begin, const char* end) {
+    uint64_t count = 0;
+    while (begin < end) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        if (!newline) {
+            break;
+        }
+        ++count;
+        begin = newline + 1;
+    }
+    return count;
+}
+
+// PLY header
+
+enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Invalid };
+
+PlyType PlyTypeFromName(const std::string& name) {
+    if (name == "char" || name == "int8") return PlyType::Int8;
+    if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+    if (name == "short" || name == "int16") return PlyType::Int16;
+    if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+    if (name == "int" || name == "int32") return PlyType::Int32;
+    if (name == "uint" || name == "uint32") return PlyType::UInt32;
+    if (name == "float" || name == "float32") return PlyType::Float32;
+    if (name == "double" || name == "float64") return PlyType::Float64;
+    return PlyType::Invalid;
+}
+
+size_t PlyTypeSize(PlyType type) {
+    switch (type) {
+        case PlyType::Int8: case PlyType::UInt8: return 1;
+        case PlyType::Int16: case PlyType::UInt16: return 2;
+        case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+        case PlyType::Float64: return 8;
+        default: return 0;
+    }
+}
+
+template <typename T>
+T LoadScalar(const uint8_t* p, bool swap) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, p, sizeof(T));
+    if (swap) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+double ReadPlyScalar(const uint8_t* p, PlyType type, bool swap) {
+    switch (type) {
+        case PlyType::Int8: return LoadScalar<int8_t>(p, swap);
+        case PlyType::UInt8: return LoadScalar<uint8_t>(p, swap);
+        case PlyType::Int16: return LoadScalar<int16_t>(p, swap);
+        case PlyType::UInt16: return LoadScalar<uint16_t>(p, swap);
+        case PlyType::Int32: return LoadScalar<int32_t>(p, swap);
+        case PlyType::UInt32: return LoadScalar<uint32_t>(p, swap);
+        case PlyType::Float32: return LoadScalar<float>(p, swap);
+        case PlyType::Float64: return LoadScalar<double>(p, swap);
+        default: return 0.0;
+    }
+}
+
+struct PlyProperty {
+    std::string name;
+    PlyType type = PlyType::Invalid;       // item type for lists
+    PlyType countType = PlyType::Invalid;  // set for list properties only
+    size_t offset = 0;                     // within a fixed-size record
+};
+
+enum class PlyRole { Vertex, Face, Edge, Other };
+
+struct PlyElement {
+    std::string name;
+    uint64_t count = 0;
+    std::vector<PlyProperty> properties;
+    PlyRole role = PlyRole::Other;
+    bool fixedSize = true;      // no list properties
+    size_t stride = 0;          // record size when fixedSize
+    int x = -1, y = -1, z = -1;
+    int indexList = -1;         // face: vertex_indices
+    int vertex1 = -1, vertex2 = -1;
+};
+
+enum class PlyEncoding { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+struct PlyHeader {
+    PlyEncoding encoding = PlyEncoding::Ascii;
+    std::vector<PlyElement> elements;
+    size_t dataOffset = 0;
+};
+
+bool ParsePlyHeader(const char* data, size_t size, PlyHeader& header, std::string& error) {
+    const char* end = data + size;
+    const char* line = data;
+    bool sawFormat = false;
+    bool first = true;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        if (!newline) {
+            error = "header has no end_header";
+            return false;
+        }
+        std::vector<std::string> words;
+        for (const char* p = SkipBlanks(line, newline); p < newline; p = SkipBlanks(p, newline)) {
+            const char* wordEnd = SkipToken(p, newline);
+            words.emplace_back(p, wordEnd);
+            p = wordEnd;
+        }
+        line = newline + 1;
+
+        if (first) {
+            if (words.size() != 1 || words[0] != "ply") {
+                error = "missing ply magic";
+                return false;
+            }
+            first = false;
+        } else if (words.empty() || words[0] == "comment" || words[0] == "obj_info") {
+            continue;
+        } else if (words[0] == "format" && words.size() >= 2) {
+            if (words[1] == "ascii") header.encoding = PlyEncoding::Ascii;
+            else if (words[1] == "binary_little_endian") header.encoding = PlyEncoding::BinaryLittleEndian;
+            else if (words[1] == "binary_big_endian") header.encoding = PlyEncoding::BinaryBigEndian;
+            else {
+                error = "unknown format " + words[1];
+                return false;
+            }
+            sawFormat = true;
+        } else if (words[0] == "element" && words.size() == 3) {
+            PlyElement element;
+            element.name = words[1];
+            element.count = std::strtoull(words[2].c_str(), nullptr, 10);
+            if (element.name == "vertex") element.role = PlyRole::Vertex;
+            else if (element.name == "face") element.role = PlyRole::Face;
+            else if (element.name == "edge") element.role = PlyRole::Edge;
+            header.elements.push_back(element);
+        } else if (words[0] == "property" && !header.elements.empty()) {
+            PlyElement& element = header.elements.back();
+            PlyProperty property;
+            if (words.size() == 5 && words[1] == "list") {
+                property.countType = PlyTypeFromName(words[2]);
+                property.type = PlyTypeFromName(words[3]);
+                property.name = words[4];
+                element.fixedSize = false;
+                if (property.countType == PlyType::Invalid) {
+                    error = "unknown property type " + words[2];
+                    return false;
+                }
+            } else if (words.size() == 3) {
+                property.type = PlyTypeFromName(words[1]);
+                property.name = words[2];
+                property.offset = element.stride;
+                element.stride += PlyTypeSize(property.type);
+            }
+            if (property.type == PlyType::Invalid) {
+                error = "malformed property line";
+                return false;
+            }
+            int index = static_cast<int>(element.properties.size());
+            bool list = property.countType != PlyType::Invalid;
+            if (!list && property.name == "x") element.x = index;
+            if (!list && property.name == "y") element.y = index;
+            if (!list && property.name == "z") element.z = index;
+            if (!list && property.name == "vertex1") element.vertex1 = index;
+            if (!list && property.name == "vertex2") element.vertex2 = index;
+            if (list && (property.name == "vertex_indices" || property.name == "vertex_index")) element.indexList = index;
+            element.properties.push_back(property);
+        } else if (words[0] == "end_header") {
+            header.dataOffset = static_cast<size_t>(line - data);
+            if (!sawFormat) {
+                error = "missing format line";
+                return false;
+            }
+            for (PlyElement& element : header.elements) {
+                if (element.role == PlyRole::Vertex && (element.x < 0 || element.y < 0 || element.z < 0)) {
+                    error = "vertex element lacks x, y or z";
+                    return false;
+                }
+                if (element.role == PlyRole::Face && element.indexList < 0) element.role = PlyRole::Other;
+                if (element.role == PlyRole::Edge && (element.vertex1 < 0 || element.vertex2 < 0)) element.role = PlyRole::Other;
+            }
+            return true;
+        } else {
+            error = "unexpected header line " + words[0];
+            return false;
+        }
+    }
+    error = "header has no end_header";
+    return false;
+}
+
+// Parsed output of one job. OBJ allows negative indices, counted back from
+// the latest vertex; that vertex's number is only known once every earlier
+// chunk is counted, so those indices are patched when the chunk is delivered.
+struct RelativeIndex {
+    size_t slot;                // position in lines or triangles
+    int64_t fromChunkStart;     // vertex index relative to the chunk's first vertex
+};
+
+struct ParsedChunk {
+    ImportChunk chunk;
+    std::vector<RelativeIndex> relativeLines;
+    std::vector<RelativeIndex> relativeTriangles;
+    size_t skippedLines = 0;
+    size_t begin = 0;           // input byte range, released after delivery
+    size_t end = 0;
+};
+
+// Fan-triangulate a polygon or split a polyline into segments
+void EmitPolygon(const std::vector<uint32_t>& corners, std::vector<uint32_t>& triangles) {
+    for (size_t k = 1; k + 1 < corners.size(); ++k) {
+        triangles.push_back(corners[0]);
+        triangles.push_back(corners[k]);
+        triangles.push_back(corners[k + 1]);
+    }
+}
+
+void EmitPolyline(const std::vector<uint32_t>& corners, std::vector<uint32_t>& lines) {
+    for (size_t k = 0; k + 1 < corners.size(); ++k) {
+        lines.push_back(corners[k]);
+        lines.push_back(corners[k + 1]);
+    }
+}
+
+// Line parsers. Each appends to out and counts lines it cannot read.
+
+void ParseXyzLine(const char* p, const char* end, ParsedChunk& out) {
+    p = SkipBlanks(p, end);
+    if (p == end || *p == '#' || *p == '/') {
+        return;
+    }
+    glm::vec3 position;
+    if (ParseFloat(p, end, position.x) && ParseFloat(p, end, position.y) && ParseFloat(p, end, position.z)) {
+        out.chunk.points.push_back(position);
+    } else {
+        ++out.skippedLines;
+    }
+}
+
+void ParseObjLine(const char* p, const char* end, ParsedChunk& out, std::vector<int64_t>& scratch) {
+    p = SkipBlanks(p, end);
+    if (end - p < 2 || !IsBlank(p[1])) {
+        return;
+    }
+
+    char statement = p[0];
+    if (statement == 'v') {
+        glm::vec3 position;
+        ++p;
+        if (ParseFloat(p, end, position.x) && ParseFloat(p, end, position.y) && ParseFloat(p, end, position.z)) {
+            out.chunk.points.push_back(position);
+        } else {
+            ++out.skippedLines;
+        }
+        return;
+    }
+    if (statement != 'l' && statement != 'f') {
+        return;
+    }
+
+    // Corners are "v", "v/vt", "v//vn" or "v/vt/vn"; only v is used
+    scratch.clear();
+    ++p;
+    for (p = SkipBlanks(p, end); p < end; p = SkipBlanks(p, end)) {
+        int64_t index;
+        if (!ParseInt(p, end, index) || index == 0) {
+            ++out.skippedLines;
+            return;
+        }
+        scratch.push_back(index);
+        p = SkipToken(p, end);
+    }
+    if (scratch.size() < (statement == 'l' ? 2u : 3u)) {
+        ++out.skippedLines;
+        return;
+    }
+
+    bool polygon = statement == 'f';
+    std::vector<uint32_t>& target = polygon ? out.chunk.triangles : out.chunk.lines;
+    std::vector<RelativeIndex>& relative = polygon ? out.relativeTriangles : out.relativeLines;
+    int64_t vertexCount = static_cast<int64_t>(out.chunk.points.size());
+
+    // Emit corners in place, then record which slots still need patching
+    size_t first = target.size();
+    std::vector<uint32_t> corners(scratch.size());
+    for (size_t k = 0; k < scratch.size(); ++k) {
+        int64_t index = scratch[k];
+        corners[k] = index > 0 && index <= InvalidImportIndex ? static_cast<uint32_t>(index - 1) : InvalidImportIndex;
+    }
+    if (polygon) {
+        EmitPolygon(corners, target);
+    } else {
+        EmitPolyline(corners, target);
+    }
+    for (size_t slot = first; slot < target.size(); ++slot) {
+        // Map each emitted slot back to its corner to find relative indices
+        size_t corner;
+        if (polygon) {
+            size_t triangle = (slot - first) / 3;
+            size_t side = (slot - first) % 3;
+            corner = side == 0 ? 0 : triangle + side;
+        } else {
+            corner = (slot - first) / 2 + (slot - first) % 2;
+        }
+        if (scratch[corner] < 0) {
+            relative.push_back({slot, vertexCount + scratch[corner]});
+        }
+    }
+}
+
+// PLY text record: one element instance per line
+void ParsePlyLine(const char* p, const char* end, const PlyElement& element, ParsedChunk& out,
+                  std::vector<uint32_t>& corners) {
+    glm::vec3 position(0.0f);
+    int64_t vertex1 = -1;
+    int64_t vertex2 = -1;
+    corners.clear();
+
+    for (size_t k = 0; k < element.properties.size(); ++k) {
+        const PlyProperty& property = element.properties[k];
+        int index = static_cast<int>(k);
+        if (property.countType != PlyType::Invalid) {
+            int64_t count;
+            if (!ParseInt(p, end, count) || count < 0) {
+                ++out.skippedLines;
+                return;
+            }
+            for (int64_t item = 0; item < count; ++item) {
+                int64_t value;
+                if (index == element.indexList) {
+                    if (!ParseInt(p, end, value)) {
+                        ++out.skippedLines;
+                        return;
+                    }
+                    corners.push_back(value >= 0 && value < InvalidImportIndex ? static_cast<uint32_t>(value) : InvalidImportIndex);
+                } else {
+                    p = SkipToken(SkipBlanks(p, end), end);
+                }
+            }
+        } else if (index == element.x || index == element.y || index == element.z) {
+            float value;
+            if (!ParseFloat(p, end, value)) {
+                ++out.skippedLines;
+                return;
+            }
+            position[index == element.x ? 0 : index == element.y ? 1 : 2] = value;
+        } else if (index == element.vertex1 || index == element.vertex2) {
+            int64_t value;
+            if (!ParseInt(p, end, value)) {
+                ++out.skippedLines;
+                return;
+            }
+            (index == element.vertex1 ? vertex1 : vertex2) = value;
+        } else {
+            p = SkipToken(SkipBlanks(p, end), end);
+        }
+    }
+
+    if (element.role == PlyRole::Vertex) {
+        out.chunk.points.push_back(position);
+    } else if (element.role == PlyRole::Face) {
+        EmitPolygon(corners, out.chunk.triangles);
+    } else if (element.role == PlyRole::Edge) {
+        auto toIndex = [](int64_t value) {
+            return value >= 0 && value < InvalidImportIndex ? static_cast<uint32_t>(value) : InvalidImportIndex;
+        };
+        out.chunk.lines.push_back(toIndex(vertex1));
+        out.chunk.lines.push_back(toIndex(vertex2));
+    }
+}
+
+class Importer {
+public:
+    Importer(const MappedFile& file, const ImportOptions& options, const ImportConsumer& consume)
+        : m_file(file)
+        , m_pool(options.threadCount)
+        , m_chunkSize(std::max<size_t>(options.chunkSize, 4096))
+        , m_consume(consume)
+        , m_vertexCount(0)
+        , m_mayHaveLines(false)
+        , m_mayHaveFaces(false)
+        , m_pointsDeclared(0)
+        , m_stopped(false) {}
+
+    // What the file may contain, reported with every chunk
+    void SetContents(bool mayHaveLines, bool mayHaveFaces, size_t pointsDeclared) {
+        m_mayHaveLines = mayHaveLines;
+        m_mayHaveFaces = mayHaveFaces;
+        m_pointsDeclared = pointsDeclared;
+    }
+
+    bool ImportText(ImportFormat format, size_t begin, size_t end, const PlyHeader* ply);
+    bool ImportPlyBinary(const PlyHeader& header);
+
+    const ImportStats& GetStats() const { return m_stats; }
+    bool Stopped() const { return m_stopped; }
+
+private:
+    // Runs parse(chunk, out) for every chunk on the pool and delivers the
+    // results in chunk order on this thread, with at most two jobs per
+    // worker in flight
+    template <typename Parse>
+    bool RunOrdered(size_t chunkCount, Parse parse);
+
+    // Patches relative indices, updates the counts and hands the chunk on
+    bool Deliver(ParsedChunk& parsed);
+
+    size_t AlignToLine(size_t offset, size_t begin, size_t end) const;
+    bool ImportPlyBinaryVertices(const PlyElement& element, size_t offset, bool swap);
+    bool WalkPlyBinaryElement(const PlyElement& element, size_t& offset, bool swap);
+
+    const MappedFile& m_file;
+    ThreadPool m_pool;
+    size_t m_chunkSize;
+    const ImportConsumer& m_consume;
+    uint64_t m_vertexCount;     // vertices delivered so far
+    bool m_mayHaveLines;
+    bool m_mayHaveFaces;
+    size_t m_pointsDeclared;
+    bool m_stopped;             // consume asked to stop
+    ImportStats m_stats;
+};
+
+template <typename Parse>
+bool Importer::RunOrdered(size_t chunkCount, Parse parse) {
+    size_t window = m_pool.GetThreadCount() * 2;
+    std::vector<ParsedChunk> slots(window);
+    std::deque<std::future<void>> inFlight;
+    size_t submitted = 0;
+    size_t delivered = 0;
+    bool keepGoing = true;
+
+    while (delivered < chunkCount) {
+        while (keepGoing && submitted < chunkCount && submitted - delivered < window) {
+            ParsedChunk* slot = &slots[submitted % window];
+            size_t chunk = submitted;
+            inFlight.push_back(m_pool.Submit([slot, chunk, &parse] {
+                *slot = ParsedChunk();
+                parse(chunk, *slot);
+            }));
+            ++submitted;
+        }
+        if (inFlight.empty()) {
+            break;
+        }
+
+        // Jobs still reference the slots, so they are drained even after a stop
+        inFlight.front().get();
+        inFlight.pop_front();
+        if (keepGoing) {
+            keepGoing = Deliver(slots[delivered % window]);
+        }
+        slots[delivered % window] = ParsedChunk();
+        ++delivered;
+    }
+    return keepGoing;
+}
+
+bool Importer::Deliver(ParsedChunk& parsed) {
+    auto resolve = [this](int64_t fromChunkStart) {
+        int64_t index = static_cast<int64_t>(m_vertexCount) + fromChunkStart;
+        return index >= 0 && index < InvalidImportIndex ? static_cast<uint32_t>(index) : InvalidImportIndex;
+    };
+    for (const RelativeIndex& relative : parsed.relativeLines) {
+        parsed.chunk.lines[relative.slot] = resolve(relative.fromChunkStart);
+    }
+    for (const RelativeIndex& relative : parsed.relativeTriangles) {
+        parsed.chunk.triangles[relative.slot] = resolve(relative.fromChunkStart);
+    }
+
+    parsed.chunk.inputEnd = parsed.end;
+    parsed.chunk.inputSize = m_file.GetSize();
+    parsed.chunk.mayHaveLines = m_mayHaveLines;
+    parsed.chunk.mayHaveFaces = m_mayHaveFaces;
+    parsed.chunk.pointsDeclared = m_pointsDeclared;
+
+    m_vertexCount += parsed.chunk.points.size();
+    m_stats.points += parsed.chunk.points.size();
+    m_stats.lines += parsed.chunk.lines.size() / 2;
+    m_stats.triangles += parsed.chunk.triangles.size() / 3;
+    m_stats.skippedLines += parsed.skippedLines;
+
+    bool keepGoing = m_consume(parsed.chunk);
+    m_file.Release(parsed.begin, parsed.end - parsed.begin);
+    m_stopped = m_stopped || !keepGoing;
+    return keepGoing;
+}
+
+size_t Importer::AlignToLine(size_t offset, size_t begin, size_t end) const {
+    // A chunk owns the lines that start inside it
+    if (offset <= begin) {
+        return begin;
+    }
+    if (offset >= end) {
+        return end;
+    }
+    const char* data = reinterpret_cast<const char*>(m_file.GetData());
+    const void* newline = std::memchr(data + offset - 1, '\n', end - (offset - 1));
+    return newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) + 1 : end;
+}
+
+bool Importer::ImportText(ImportFormat format, size_t begin, size_t end, const PlyHeader* ply) {
+    const char* data = reinterpret_cast<const char*>(m_file.GetData());
+    size_t chunkCount = (end - begin + m_chunkSize - 1) / m_chunkSize;
+
+    // ASCII PLY lines mean different elements depending on their line
+    // number. Each job counts its own lines, then waits for the job before
+    // it to publish where it started; jobs run in submission order, so the
+    // wait is short and cannot deadlock.
+    std::vector<uint64_t> firstLine(chunkCount + 1, 0);
+    std::vector<char> firstLineKnown(chunkCount + 1, 0);
+    firstLineKnown[0] = 1;
+    std::mutex numberingMutex;
+    std::condition_variable numbered;
+
+    std::vector<uint64_t> elementEnd;
+    if (ply) {
+        uint64_t line = 0;
+        for (const PlyElement& element : ply->elements) {
+            line += element.count;
+            elementEnd.push_back(line);
+        }
+    }
+
+    return RunOrdered(chunkCount, [&](size_t chunk, ParsedChunk& out) {
+        PROFILE_SCOPE("Importer::ParseChunk");
+
+        out.begin = AlignToLine(begin + chunk * m_chunkSize, begin, end);
+        out.end = AlignToLine(begin + (chunk + 1) * m_chunkSize, begin, end);
+        const char* chunkBegin = data + out.begin;
+        const char* chunkEnd = data + out.end;
+
+        if (format == ImportFormat::Xyz) {
+            ForEachLine(chunkBegin, chunkEnd, [&](const char* p, const char* lineEnd) { ParseXyzLine(p, lineEnd, out); });
+            return;
+        }
+        if (format == ImportFormat::Obj) {
+            std::vector<int64_t> scratch;
+            ForEachLine(chunkBegin, chunkEnd, [&](const char* p, const char* lineEnd) {
+                ParseObjLine(p, lineEnd, out, scratch);
+            });
+            return;
+        }
+
+        uint64_t lineCount = CountLines(chunkBegin, chunkEnd);
+        uint64_t line;
+        {
+            std::unique_lock<std::mutex> lock(numberingMutex);
+            numbered.wait(lock, [&] { return firstLineKnown[chunk] != 0; });
+            line = firstLine[chunk];
+            firstLine[chunk + 1] = line + lineCount;
+            firstLineKnown[chunk + 1] = 1;
+        }
+        numbered.notify_all();
+
+        size_t element = 0;
+        std::vector<uint32_t> corners;
+        ForEachLine(chunkBegin, chunkEnd, [&](const char* p, const char* lineEnd) {
+            while (element < elementEnd.size() && line >= elementEnd[element]) {
+                ++element;
+            }
+            if (element < elementEnd.size()) {
+                ParsePlyLine(p, lineEnd, ply->elements[element], out, corners);
+            }
+            ++line;
+        });
+    });
+}
+
+bool Importer::ImportPlyBinary(const PlyHeader& header) {
+    bool swap = header.encoding == PlyEncoding::BinaryBigEndian;
+    size_t offset = header.dataOffset;
+    for (const PlyElement& element : header.elements) {
+        if (element.fixedSize) {
+            // Records have one size, so any record range can be parsed on its
+            // own. The count comes from the header, so it is checked against
+            // the file by division: count * stride could overflow.
+            if (element.role == PlyRole::Vertex && element.stride == 0) {
+                LOG_ERROR("PLY %s element has no properties", element.name.c_str());
+                return false;
+            }
+            if (element.stride > 0 && element.count > (m_file.GetSize() - offset) / element.stride) {
+                LOG_ERROR("PLY %s element is truncated", element.name.c_str());
+                return false;
+            }
+            uint64_t bytes = element.count * element.stride;
+            if (element.role == PlyRole::Vertex && !ImportPlyBinaryVertices(element, offset, swap)) {
+                return false;
+            }
+            if (element.role != PlyRole::Vertex && element.role != PlyRole::Other &&
+                !WalkPlyBinaryElement(element, offset, swap)) {
+                return false;
+            }
+            if (element.role == PlyRole::Vertex || element.role == PlyRole::Other) {
+                offset += static_cast<size_t>(bytes);
+            }
+        } else if (!WalkPlyBinaryElement(element, offset, swap)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Importer::ImportPlyBinaryVertices(const PlyElement& element, size_t offset, bool swap) {
+    const uint8_t* records = m_file.GetData() + offset;
+    size_t recordsPerChunk = std::max<size_t>(1, m_chunkSize / std::max<size_t>(element.stride, 1));
+    size_t chunkCount = static_cast<size_t>((element.count + recordsPerChunk - 1) / recordsPerChunk);
+    const PlyProperty& x = element.properties[element.x];
+    const PlyProperty& y = element.properties[element.y];
+    const PlyProperty& z = element.properties[element.z];
+
+    return RunOrdered(chunkCount, [&](size_t chunk, ParsedChunk& out) {
+        PROFILE_SCOPE("Importer::ParseChunk");
+
+        size_t first = chunk * recordsPerChunk;
+        size_t last = std::min<size_t>(first + recordsPerChunk, static_cast<size_t>(element.count));
+        out.begin = offset + first * element.stride;
+        out.end = offset + last * element.stride;
+        out.chunk.points.resize(last - first);
+        for (size_t record = first; record < last; ++record) {
+            const uint8_t* p = records + record * element.stride;
+            out.chunk.points[record - first] = glm::vec3(static_cast<float>(ReadPlyScalar(p + x.offset, x.type, swap)),
+                                                         static_cast<float>(ReadPlyScalar(p + y.offset, y.type, swap)),
+                                                         static_cast<float>(ReadPlyScalar(p + z.offset, z.type, swap)));
+        }
+    });
+}
+
+bool Importer::WalkPlyBinaryElement(const PlyElement& element, size_t& offset, bool swap) {
+    // Variable-size records (faces) are found one after another, so they
+    // are read on this thread and delivered in batches
+    const size_t batchItems = 1 << 20;
+    const uint8_t* data = m_file.GetData();
+    size_t size = m_file.GetSize();
+    ParsedChunk out;
+    out.begin = offset;
+    std::vector<uint32_t> corners;
+
+    for (uint64_t record = 0; record < element.count; ++record) {
+        glm::vec3 position(0.0f);
+        int64_t vertex1 = -1;
+        int64_t vertex2 = -1;
+        corners.clear();
+        for (size_t k = 0; k < element.properties.size(); ++k) {
+            const PlyProperty& property = element.properties[k];
+            int index = static_cast<int>(k);
+            size_t itemSize = PlyTypeSize(property.type);
+            if (property.countType != PlyType::Invalid) {
+                size_t countSize = PlyTypeSize(property.countType);
+                if (countSize > size - offset) {
+                    LOG_ERROR("PLY %s element is truncated", element.name.c_str());
+                    return false;
+                }
+                double count = ReadPlyScalar(data + offset, property.countType, swap);
+                offset += countSize;
+                if (count < 0 || count * itemSize > static_cast<double>(size - offset)) {
+                    LOG_ERROR("PLY %s element is truncated", element.name.c_str());
+                    return false;
+                }
+                for (size_t item = 0; item < static_cast<size_t>(count); ++item) {
+                    if (index == element.indexList) {
+                        double value = ReadPlyScalar(data + offset, property.type, swap);
+                        corners.push_back(value >= 0 && value < InvalidImportIndex ? static_cast<uint32_t>(value) : InvalidImportIndex);
+                    }
+                    offset += itemSize;
+                }
+                continue;
+            }
+            if (itemSize > size - offset) {
+                LOG_ERROR("PLY %s element is truncated", element.name.c_str());
+                return false;
+            }
+            double value = ReadPlyScalar(data + offset, property.type, swap);
+            offset += itemSize;
+            if (index == element.x) position.x = static_cast<float>(value);
+            if (index == element.y) position.y = static_cast<float>(value);
+            if (index == element.z) position.z = static_cast<float>(value);
+            if (index == element.vertex1) vertex1 = static_cast<int64_t>(value);
+            if (index == element.vertex2) vertex2 = static_cast<int64_t>(value);
+        }
+
+        if (element.role == PlyRole::Vertex) {
+            out.chunk.points.push_back(position);
+        } else if (element.role == PlyRole::Face) {
+            EmitPolygon(corners, out.chunk.triangles);
+        } else if (element.role == PlyRole::Edge) {
+            out.chunk.lines.push_back(vertex1 >= 0 && vertex1 < InvalidImportIndex ? static_cast<uint32_t>(vertex1) : InvalidImportIndex);
+            out.chunk.lines.push_back(vertex2 >= 0 && vertex2 < InvalidImportIndex ? static_cast<uint32_t>(vertex2) : InvalidImportIndex);
+        }
+
+        size_t items = out.chunk.points.size() + out.chunk.lines.size() / 2 + out.chunk.triangles.size() / 3;
+        if (items >= batchItems || record + 1 == element.count) {
+            out.end = offset;
+            if (!Deliver(out)) {
+                return false;
+            }
+            out = ParsedChunk();
+            out.begin = offset;
+        }
+    }
+    return true;
+}
+
+
+}
+
+ImportFormat ImportFormatFromPath(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+    for (char& c : extension) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (extension == "ply") return ImportFormat::Ply;
+    if (extension == "obj") return ImportFormat::Obj;
+    if (extension == "xyz") return ImportFormat::Xyz;
+    return ImportFormat::Auto;
+}
+
+bool ImportFile(const std::string& path, const ImportOptions& options, const ImportConsumer& consume,
+                ImportStats* stats) {
+    PROFILE_SCOPE("ImportFile");
+    auto start = std::chrono::steady_clock::now();
+
+    ImportFormat format = options.format == ImportFormat::Auto ? ImportFormatFromPath(path) : options.format;
+    if (format == ImportFormat::Auto) {
+        LOG_ERROR("Cannot tell the format of %s; expected .ply, .obj or .xyz", path.c_str());
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    file.AdviseSequential();
+
+    Importer importer(file, options, consume);
+    bool imported;
+    if (format == ImportFormat::Ply) {
+        PlyHeader header;
+        std::string error;
+        if (!ParsePlyHeader(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), header, error)) {
+            LOG_ERROR("%s: %s", path.c_str(), error.c_str());
+            return false;
+        }
+        bool hasLines = false;
+        bool hasFaces = false;
+        size_t vertexCount = 0;
+        for (const PlyElement& element : header.elements) {
+            hasLines = hasLines || (element.role == PlyRole::Edge && element.count > 0);
+            hasFaces = hasFaces || (element.role == PlyRole::Face && element.count > 0);
+            vertexCount += element.role == PlyRole::Vertex ? static_cast<size_t>(element.count) : 0;
+        }
+        importer.SetContents(hasLines, hasFaces, vertexCount);
+        imported = header.encoding == PlyEncoding::Ascii
+                       ? importer.ImportText(format, header.dataOffset, file.GetSize(), &header)
+                       : importer.ImportPlyBinary(header);
+    } else {
+        importer.SetContents(format == ImportFormat::Obj, format == ImportFormat::Obj, 0);
+        imported = importer.ImportText(format, 0, file.GetSize(), nullptr);
+    }
+
+    if (stats) {
+        *stats = importer.GetStats();
+        stats->bytes = file.GetSize();
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (importer.GetStats().skippedLines > 0) {
+        LOG_WARN("%s: skipped %zu malformed lines", path.c_str(), importer.GetStats().skippedLines);
+    }
+    return imported && !importer.Stopped();
+}
+
+bool ImportFile(Scene& scene, const std::string& path, const ImportOptions& options, ImportStats* stats) {
+    // Indices arrive relative to the import; the scene may already hold points
+    uint32_t base = static_cast<uint32_t>(scene.GetPoints().Size());
+    std::vector<uint32_t> triangles;
+    ImportStats importStats;
+    bool imported = ImportFile(path, options, [&](ImportChunk& chunk) {
+        scene.AddPoints(chunk.points);
+        for (uint32_t& index : chunk.lines) {
+            index = index == InvalidImportIndex ? InvalidImportIndex : index + base;
+        }
+        scene.AddIndexedLines(chunk.lines.data(), chunk.lines.size() / 2);
+        triangles.insert(triangles.end(), chunk.triangles.begin(), chunk.triangles.end());
+        return true;
+    }, &importStats);
+
+    // Faces become the scene mesh over the imported vertices; triangles
+    // that reference a missing vertex are dropped rather than failing it
+    if (!triangles.empty()) {
+        const std::vector<glm::vec3>& points = scene.GetPoints().GetPositions();
+        uint32_t vertexCount = static_cast<uint32_t>(points.size() - base);
+        size_t kept = 0;
+        for (size_t triangle = 0; triangle < triangles.size() / 3; ++triangle) {
+            const uint32_t* corner = &triangles[triangle * 3];
+            if (corner[0] < vertexCount && corner[1] < vertexCount && corner[2] < vertexCount) {
+                std::copy(corner, corner + 3, triangles.begin() + kept * 3);
+                ++kept;
+            }
+        }
+        if (kept < triangles.size() / 3) {
+            LOG_WARN("%s: dropped %zu faces with missing vertices", path.c_str(), triangles.size() / 3 - kept);
+        }
+        triangles.resize(kept * 3);
+        scene.SetMesh(std::vector<glm::vec3>(points.begin() + base, points.end()), std::move(triangles));
+    }
+
+    if (imported) {
+        LOG_INFO("Imported %s: %zu points, %zu lines, %zu triangles in %.2f s (%.0f MB/s)", path.c_str(),
+                 importStats.points, importStats.lines, importStats.triangles, importStats.seconds,
+                 importStats.bytes / (1024.0 * 1024.0) / std::max(importStats.seconds, 1e-9));
+    }
+    if (stats) {
+        *stats = importStats;
+    }
+    return imported;
+}
@@ -1,25 +1,25 @@
 #include "Shader.h"
 #include <fstream>
 #include <sstream>
-#include <iostream>
+#include "Log.h"
 #include <glm/gtc/type_ptr.hpp>
 
 Shader::Shader() : m_id(0) {
-    std::cout << "Shader created" << std::endl;
+    LOG_DEBUG("Shader created");
 }
 
 Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource) : m_id(0) {
-    std::cout << "Shader created with sources" << std::endl;
+    LOG_DEBUG("Shader created with sources");
     LoadFromStrings(vertexSource, fragmentSource);
 }
 
 Shader::~Shader() {
-    std::cout << "Shader destroyed" << std::endl;
+    LOG_DEBUG("Shader destroyed");
     Delete();
 }
 
 bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::cout << "Loading shader from files: " << vertexPath << ", " << fragmentPath << std::endl;
+    LOG_DEBUG("Loading shader from files: %s, %s", vertexPath.c_str(), fragmentPath.c_str());
     std::string vertexCode;
     std::string fragmentCode;
     std::ifstream vShaderFile;
@@ -38,12 +38,12 @@ bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fra
     vertexCode = vShaderStream.str();
     fragmentCode = fShaderStream.str();
     
-    std::cout << "✅ Shader loaded from files successfully" << std::endl;
+    LOG_DEBUG("Shader loaded from files successfully");
     return LoadFromStrings(vertexCode, fragmentCode);
 }
 
 bool Shader::LoadFromStrings(const std::string& vertexSource, const std::string& fragmentSource) {
-    std::cout << "Loading shader from strings" << std::endl;
+    LOG_DEBUG("Loading shader from strings");
     m_vertexSource = vertexSource;
     m_fragmentSource = fragmentSource;
     
@@ -63,11 +63,12 @@ bool Shader::LoadFromStrings(const std::string& vertexSource, const std::string&
     glLinkProgram(m_id);
     
     CheckCompileErrors(m_id, "PROGRAM");
+    CacheUniformLocations();
     
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
     
-    std::cout << "✅ Shader compiled and linked successfully" << std::endl;
+    LOG_DEBUG("Shader compiled and linked successfully");
     return true;
 }
 
@@ -82,32 +83,74 @@ void Shader::Delete() {
     }
 }
 
-void Shader::SetBool(const std::string& name, bool value) {
-    glUniform1i(glGetUniformLocation(m_id, name.c_str()), (int)value);
+GLint Shader::GetUniformLocation(const char* name) const {
+    auto it = m_uniformLocations.find(name);
+    return it != m_uniformLocations.end() ? it->second : -1;
 }
 
-void Shader::SetInt(const std::string& name, int value) {
-    glUniform1i(glGetUniformLocation(m_id, name.c_str()), value);
+bool Shader::BindUniformBlock(const char* blockName, GLuint bindingPoint) {
+    GLuint blockIndex = glGetUniformBlockIndex(m_id, blockName);
+    if (blockIndex == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(m_id, blockIndex, bindingPoint);
+    return true;
+}
+
+void Shader::SetBool(GLint location, bool value) {
+    glUniform1i(location, (int)value);
+}
+
+void Shader::SetInt(GLint location, int value) {
+    glUniform1i(location, value);
+}
+
+void Shader::SetFloat(GLint location, float value) {
+    glUniform1f(location, value);
+}
+
+void Shader::SetVec2(GLint location, const glm::vec2& value) {
+    glUniform2fv(location, 1, &value[0]);
+}
+
+void Shader::SetVec3(GLint location, const glm::vec3& value) {
+    glUniform3fv(location, 1, &value[0]);
+}
+
+void Shader::SetVec4(GLint location, const glm::vec4& value) {
+    glUniform4fv(location, 1, &value[0]);
+}
+
+void Shader::SetMat4(GLint location, const glm::mat4& value) {
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::SetBool(const char* name, bool value) {
+    SetBool(GetUniformLocation(name), value);
+}
+
+void Shader::SetInt(const char* name, int value) {
+    SetInt(GetUniformLocation(name), value);
 }
 
-void Shader::SetFloat(const std::string& name, float value) {
-    glUniform1f(glGetUniformLocation(m_id, name.c_str()), value);
+void Shader::SetFloat(const char* name, float value) {
+    SetFloat(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec2(const std::string& name, const glm::vec2& value) {
-    glUniform2fv(glGetUniformLocation(m_id, name.c_str()), 1, &value[0]);
+void Shader::SetVec2(const char* name, const glm::vec2& value) {
+    SetVec2(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec3(const std::string& name, const glm::vec3& value) {
-    glUniform3fv(glGetUniformLocation(m_id, name.c_str()), 1, &value[0]);
+void Shader::SetVec3(const char* name, const glm::vec3& value) {
+    SetVec3(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec4(const std::string& name, const glm::vec4& value) {
-    glUniform4fv(glGetUniformLocation(m_id, name.c_str()), 1, &value[0]);
+void Shader::SetVec4(const char* name, const glm::vec4& value) {
+    SetVec4(GetUniformLocation(name), value);
 }
 
-void Shader::SetMat4(const std::string& name, const glm::mat4& value) {
-    glUniformMatrix4fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));     
+void Shader::SetMat4(const char* name, const glm::mat4& value) {
+    SetMat4(GetUniformLocation(name), value);
 }
 
 bool Shader::CompileShader(const std::string& source, GLenum type, GLuint& shader) {
@@ -124,9 +167,40 @@ bool Shader::CompileShader(const std::string& source, GLenum type, GLuint& shade
 bool Shader::LinkProgram() {
     glLinkProgram(m_id);
     CheckCompileErrors(m_id, "PROGRAM");
+    CacheUniformLocations();
     return true;
 }
 
+void Shader::CacheUniformLocations() {
+    m_uniformLocations.clear();
+    
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    
+    std::string name(maxNameLength > 0 ? maxNameLength : 1, '\0');
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_id, i, maxNameLength, &length, &size, &type, &name[0]);
+        
+        std::string uniformName(name.data(), length);
+        GLint location = glGetUniformLocation(m_id, uniformName.c_str());
+        if (location < 0) {
+            continue; // Uniform block members have no location
+        }
+        
+        // Arrays are reported as "name[0]"; make them reachable by their plain name too
+        size_t bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            m_uniformLocations.emplace(uniformName.substr(0, bracket), location);
+        }
+        m_uniformLocations.emplace(std::move(uniformName), location);
+    }
+}
+
 void Shader::CheckCompileErrors(GLuint shader, const std::string& type) {
     GLint success;
     GLchar infoLog[1024];
@@ -135,13 +209,13 @@ void Shader::CheckCompileErrors(GLuint shader, const std::string& type) {
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
         if (!success) {
             glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
-            std::cerr << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << std::endl;
+            LOG_ERROR("Shader compilation error of type: %s\n%s", type.c_str(), infoLog);
         }
     } else {
         glGetProgramiv(shader, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shader, 1024, nullptr, infoLog);
-            std::cerr << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << std::endl;
+            LOG_ERROR("Program linking error of type: %s\n%s", type.c_str(), infoLog);
         }
     }
 } 
\ No newline at end of file
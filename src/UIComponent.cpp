@@ -1,10 +1,16 @@
 #include "UIComponent.h"
-#include <iostream>
+#include "OverlayRenderer.h"
+#include "UploadRing.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <algorithm>
 
 UIComponent::UIComponent(int windowWidth, int windowHeight)
-    : m_currentTool(Tool::Point), m_isAddingLine(false), m_firstPointIndex(-1),
+    : m_currentTool(Tool::Point), m_isAddingLine(false), m_firstPoint(InvalidPointId),
       m_panelWidth(200), m_windowWidth(windowWidth), m_windowHeight(windowHeight),
-      m_initialized(false), m_uiShader(nullptr), m_uiVAO(0), m_uiVBO(0) {
+      m_initialized(false), m_uiShader(nullptr), m_overlay(nullptr), m_projectionLoc(-1), m_uiVAO(0), m_uiVBO(0),
+      m_triangleVertexCount(0), m_lineVertexCount(0), m_uiBufferCapacity(0), m_geometryDirty(true),
+      m_progress(-1.0f), m_progressPixels(-1) {
 }
 
 UIComponent::~UIComponent() {
@@ -43,10 +49,11 @@ void UIComponent::InitializeUIShader() {
     )";
     
     m_uiShader = std::make_unique<Shader>(vertexSource, fragmentSource);
+    m_projectionLoc = m_uiShader->GetUniformLocation("projection");
 }
 
 void UIComponent::InitializeUIBuffers() {
-    std::cout << "Initializing UI buffers" << std::endl;
+    LOG_DEBUG("Initializing UI buffers");
     
     glGenVertexArrays(1, &m_uiVAO);
     glGenBuffers(1, &m_uiVBO);
@@ -66,7 +73,7 @@ void UIComponent::InitializeUIBuffers() {
 }
 
 void UIComponent::CreateButtons() {
-    std::cout << "Creating UI buttons" << std::endl;
+    LOG_DEBUG("Creating UI buttons");
     
     // Clear any existing buttons
     m_buttons.clear();
@@ -77,10 +84,7 @@ void UIComponent::CreateButtons() {
     // Line tool button - place it below the Point button
     m_buttons.emplace_back(glm::vec2(10, m_windowHeight - 150), glm::vec2(120, 40), "Line", Tool::Line);
     
-    std::cout << "Created " << m_buttons.size() << " buttons" << std::endl;
-    std::cout << "Window height: " << m_windowHeight << std::endl;
-    std::cout << "Point button at: (" << m_buttons[0].position.x << ", " << m_buttons[0].position.y << ")" << std::endl;
-    std::cout << "Line button at: (" << m_buttons[1].position.x << ", " << m_buttons[1].position.y << ")" << std::endl;
+    LOG_DEBUG("Created %zu buttons (window height %d)", m_buttons.size(), m_windowHeight);
 }
 
 void UIComponent::Update() {
@@ -89,12 +93,21 @@ void UIComponent::Update() {
 }
 
 void UIComponent::Render() {
+    PROFILE_SCOPE("UIComponent::Render");
+    PROFILE_GPU_SCOPE("UIComponent::Render");
+    
     if (!m_initialized) {
-        std::cout << "UI not initialized, skipping render" << std::endl;
+        LOG_TRACE("UI not initialized, skipping render");
         return;
     }
     
-    std::cout << "Rendering UI components" << std::endl;
+    // Geometry only changes on tool or window size changes; idle frames
+    // skip straight to the two draw calls
+    if (m_geometryDirty) {
+        RebuildGeometry();
+        UploadGeometry();
+        m_geometryDirty = false;
+    }
     
     // Save current OpenGL state
     GLint prevViewport[4];
@@ -105,18 +118,64 @@ void UIComponent::Render() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    // Use UI shader
+    if (m_uiShader) {
+        m_uiShader->Use();
+    }
+    
+    glBindVertexArray(m_uiVAO);
+    if (m_triangleVertexCount > 0) {
+        glDrawArrays(GL_TRIANGLES, 0, m_triangleVertexCount);
+    }
+    if (m_lineVertexCount > 0) {
+        glDrawArrays(GL_LINES, m_triangleVertexCount, m_lineVertexCount);
+    }
+    glBindVertexArray(0);
+    
+    RenderLabels();
+    
+    // Restore OpenGL state
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+}
+
+void UIComponent::RebuildGeometry() {
+    m_triangleVertices.clear();
+    m_lineVertices.clear();
+    
+    AppendPanel();
+    AppendButtons();
+    AppendDebugInfo();
+    AppendProgress();
+    
+    m_triangleVertexCount = static_cast<GLsizei>(m_triangleVertices.size() / 5);
+    m_lineVertexCount = static_cast<GLsizei>(m_lineVertices.size() / 5);
+}
+
+void UIComponent::UploadGeometry() {
+    // Triangles first, lines appended after them in the same buffer
+    size_t triangleBytes = m_triangleVertices.size() * sizeof(float);
+    size_t lineBytes = m_lineVertices.size() * sizeof(float);
+    size_t totalBytes = triangleBytes + lineBytes;
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_uiVBO);
+    if (totalBytes > m_uiBufferCapacity) {
+        glBufferData(GL_ARRAY_BUFFER, totalBytes, nullptr, GL_DYNAMIC_DRAW);
+        m_uiBufferCapacity = totalBytes;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    UploadRing::Instance().Upload(m_uiVBO, 0, m_triangleVertices.data(), triangleBytes);
+    UploadRing::Instance().Upload(m_uiVBO, triangleBytes, m_lineVertices.data(), lineBytes);
+    
+    // The projection only depends on the window size, so it is set here
+    // rather than every frame; uniform values persist in the program
     if (m_uiShader) {
         m_uiShader->Use();
         
-        // Set up orthographic projection matrix
         // Left=0, Right=windowWidth, Bottom=0, Top=windowHeight
         float left = 0.0f;
         float right = static_cast<float>(m_windowWidth);
         float bottom = 0.0f;
         float top = static_cast<float>(m_windowHeight);
         
-        // Create orthographic projection matrix manually
         float projection[16] = {
             2.0f / (right - left), 0.0f, 0.0f, 0.0f,
             0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
@@ -124,172 +183,69 @@ void UIComponent::Render() {
             -(right + left) / (right - left), -(top + bottom) / (top - bottom), 0.0f, 1.0f
         };
         
-        // Set the projection uniform
-        GLint projLoc = glGetUniformLocation(m_uiShader->GetID(), "projection");
-        if (projLoc != -1) {
-            glUniformMatrix4fv(projLoc, 1, GL_FALSE, projection);
+        if (m_projectionLoc != -1) {
+            glUniformMatrix4fv(m_projectionLoc, 1, GL_FALSE, projection);
         }
     }
-    
-    RenderPanel();
-    RenderButtons();
-    RenderDebugInfo();
-    
-    // Restore OpenGL state
-    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
 }
 
-void UIComponent::RenderPanel() {
-    std::cout << "Rendering panel: " << m_panelWidth << "x" << m_windowHeight << std::endl;
+void UIComponent::AppendRect(float x0, float y0, float x1, float y1, const glm::vec3& color) {
+    m_triangleVertices.insert(m_triangleVertices.end(), {
+        x0, y0, color.x, color.y, color.z,
+        x1, y0, color.x, color.y, color.z,
+        x1, y1, color.x, color.y, color.z,
+        x0, y0, color.x, color.y, color.z,
+        x1, y1, color.x, color.y, color.z,
+        x0, y1, color.x, color.y, color.z
+    });
+}
+
+void UIComponent::AppendRectOutline(float x0, float y0, float x1, float y1, const glm::vec3& color) {
+    AppendLine(x0, y0, x1, y0, color);
+    AppendLine(x1, y0, x1, y1, color);
+    AppendLine(x1, y1, x0, y1, color);
+    AppendLine(x0, y1, x0, y0, color);
+}
+
+void UIComponent::AppendLine(float x0, float y0, float x1, float y1, const glm::vec3& color) {
+    m_lineVertices.insert(m_lineVertices.end(), {
+        x0, y0, color.x, color.y, color.z,
+        x1, y1, color.x, color.y, color.z
+    });
+}
+
+void UIComponent::AppendPanel() {
+    float panelWidth = static_cast<float>(m_panelWidth);
+    float windowHeight = static_cast<float>(m_windowHeight);
     
     // White panel background
-    float panelVertices[] = {
-        // Position (x, y)    // Color (r, g, b)
-        0.0f, 0.0f,          0.95f, 0.95f, 0.95f,
-        static_cast<float>(m_panelWidth), 0.0f,  0.95f, 0.95f, 0.95f,
-        static_cast<float>(m_panelWidth), static_cast<float>(m_windowHeight), 0.95f, 0.95f, 0.95f,
-        0.0f, static_cast<float>(m_windowHeight), 0.95f, 0.95f, 0.95f
-    };
-    
-    glBindVertexArray(m_uiVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_uiVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(panelVertices), panelVertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    // Panel border - make it thicker and more visible
-    float borderVertices[] = {
-        // Position (x, y)    // Color (r, g, b)
-        0.0f, 0.0f,          0.7f, 0.7f, 0.7f,
-        static_cast<float>(m_panelWidth), 0.0f,  0.7f, 0.7f, 0.7f,
-        static_cast<float>(m_panelWidth), static_cast<float>(m_windowHeight), 0.7f, 0.7f, 0.7f,
-        0.0f, static_cast<float>(m_windowHeight), 0.7f, 0.7f, 0.7f
-    };
+    AppendRect(0.0f, 0.0f, panelWidth, windowHeight, glm::vec3(0.95f));
     
-    glBufferData(GL_ARRAY_BUFFER, sizeof(borderVertices), borderVertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+    // Panel border
+    AppendRectOutline(0.0f, 0.0f, panelWidth, windowHeight, glm::vec3(0.7f));
     
     // Title bar
-    float titleVertices[] = {
-        // Position (x, y)    // Color (r, g, b)
-        0.0f, static_cast<float>(m_windowHeight - 30), 0.8f, 0.8f, 0.8f,
-        static_cast<float>(m_panelWidth), static_cast<float>(m_windowHeight - 30), 0.8f, 0.8f, 0.8f,
-        static_cast<float>(m_panelWidth), static_cast<float>(m_windowHeight), 0.8f, 0.8f, 0.8f,
-        0.0f, static_cast<float>(m_windowHeight), 0.8f, 0.8f, 0.8f
-    };
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(titleVertices), titleVertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    AppendRect(0.0f, windowHeight - 30.0f, panelWidth, windowHeight, glm::vec3(0.8f));
     
     // Title border
-    float titleBorderVertices[] = {
-        // Position (x, y)    // Color (r, g, b)
-        0.0f, static_cast<float>(m_windowHeight - 30), 0.5f, 0.5f, 0.5f,
-        static_cast<float>(m_panelWidth), static_cast<float>(m_windowHeight - 30), 0.5f, 0.5f, 0.5f
-    };
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(titleBorderVertices), titleBorderVertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_LINES, 0, 2);
-    
-    glBindVertexArray(0);
+    AppendLine(0.0f, windowHeight - 30.0f, panelWidth, windowHeight - 30.0f, glm::vec3(0.5f));
 }
 
-void UIComponent::RenderButtons() {
-    std::cout << "Rendering " << m_buttons.size() << " buttons" << std::endl;
-    
+void UIComponent::AppendButtons() {
     for (const auto& button : m_buttons) {
-        std::cout << "Button: " << button.text << " at (" << button.position.x << ", " << button.position.y 
-                  << ") size (" << button.size.x << ", " << button.size.y << ")" << std::endl;
+        float x0 = button.position.x;
+        float y0 = button.position.y;
+        float x1 = button.position.x + button.size.x;
+        float y1 = button.position.y + button.size.y;
         
-        // Button background - make it much more visible
-        float r, g, b;
-        if (button.isSelected) {
-            r = 0.1f; g = 0.7f; b = 1.0f; // Bright blue when selected
-        } else {
-            r = 0.3f; g = 0.3f; b = 0.8f; // Purple/blue for better visibility
-        }
-        
-        float buttonVertices[] = {
-            // Position (x, y)    // Color (r, g, b)
-            button.position.x, button.position.y, r, g, b,
-            button.position.x + button.size.x, button.position.y, r, g, b,
-            button.position.x + button.size.x, button.position.y + button.size.y, r, g, b,
-            button.position.x, button.position.y + button.size.y, r, g, b
-        };
-        
-        glBindVertexArray(m_uiVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_uiVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(buttonVertices), buttonVertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-        
-        // Button border - make it dark and visible
-        float borderVertices[] = {
-            // Position (x, y)    // Color (r, g, b)
-            button.position.x, button.position.y, 0.0f, 0.0f, 0.0f,  // Black border
-            button.position.x + button.size.x, button.position.y, 0.0f, 0.0f, 0.0f,
-            button.position.x + button.size.x, button.position.y + button.size.y, 0.0f, 0.0f, 0.0f,
-            button.position.x, button.position.y + button.size.y, 0.0f, 0.0f, 0.0f
-        };
-        
-        glBufferData(GL_ARRAY_BUFFER, sizeof(borderVertices), borderVertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_LINE_LOOP, 0, 4);
-        
-        // Button text (simplified - just draw colored rectangles for letters)
-        if (button.text == "Point") {
-            // Draw "P" as a simple rectangle
-            float pVertices[] = {
-                button.position.x + 10, button.position.y + 10, 0.0f, 0.0f, 0.0f,
-                button.position.x + 20, button.position.y + 10, 0.0f, 0.0f, 0.0f,
-                button.position.x + 20, button.position.y + 20, 0.0f, 0.0f, 0.0f,
-                button.position.x + 10, button.position.y + 20, 0.0f, 0.0f, 0.0f
-            };
-            glBufferData(GL_ARRAY_BUFFER, sizeof(pVertices), pVertices, GL_DYNAMIC_DRAW);
-            glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-        } else if (button.text == "Line") {
-            // Draw "L" as a simple rectangle
-            float lVertices[] = {
-                button.position.x + 10, button.position.y + 10, 0.0f, 0.0f, 0.0f,
-                button.position.x + 20, button.position.y + 10, 0.0f, 0.0f, 0.0f,
-                button.position.x + 20, button.position.y + 20, 0.0f, 0.0f, 0.0f,
-                button.position.x + 10, button.position.y + 20, 0.0f, 0.0f, 0.0f
-            };
-            glBufferData(GL_ARRAY_BUFFER, sizeof(lVertices), lVertices, GL_DYNAMIC_DRAW);
-            glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-        }
-        
-        glBindVertexArray(0);
-    }
-}
-
-void UIComponent::RenderText(const std::string& text, float x, float y, float scale) {
-    std::cout << "Rendering text: " << text << " at (" << x << ", " << y << ")" << std::endl;
-    
-    // Simple text rendering using colored rectangles
-    std::vector<float> charVertices;
-    
-    for (size_t i = 0; i < text.length(); ++i) {
-        char c = text[i];
-        float charX = x + i * 10 * scale;
-        float charY = y;
-        
-        // Create a simple rectangle for each character
-        float charWidth = 8 * scale;
-        float charHeight = 12 * scale;
+        // Button background
+        glm::vec3 color = button.isSelected
+            ? glm::vec3(0.1f, 0.7f, 1.0f)   // Bright blue when selected
+            : glm::vec3(0.3f, 0.3f, 0.8f);  // Purple/blue for better visibility
+        AppendRect(x0, y0, x1, y1, color);
         
-        // Rectangle vertices (position + color)
-        charVertices.insert(charVertices.end(), {
-            charX, charY, 0.0f, 0.0f, 0.0f,
-            charX + charWidth, charY, 0.0f, 0.0f, 0.0f,
-            charX + charWidth, charY + charHeight, 0.0f, 0.0f, 0.0f,
-            charX, charY + charHeight, 0.0f, 0.0f, 0.0f
-        });
-    }
-    
-    if (!charVertices.empty()) {
-        glBindVertexArray(m_uiVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_uiVBO);
-        glBufferData(GL_ARRAY_BUFFER, charVertices.size() * sizeof(float), charVertices.data(), GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, charVertices.size() / 5);
-        glBindVertexArray(0);
+        // Button border
+        AppendRectOutline(x0, y0, x1, y1, glm::vec3(0.0f));
     }
 }
 
@@ -300,6 +256,7 @@ void UIComponent::SetCurrentTool(Tool tool) {
     for (auto& button : m_buttons) {
         button.isSelected = (button.tool == tool);
     }
+    m_geometryDirty = true;
 }
 
 bool UIComponent::IsPointInsidePanel(float x, float y) const {
@@ -327,87 +284,65 @@ bool UIComponent::HandleMouseClick(float x, float y) {
 void UIComponent::UpdateWindowSize(int width, int height) {
     m_windowWidth = width;
     m_windowHeight = height;
+    m_geometryDirty = true;
 }
 
-void UIComponent::RenderDebugInfo() {
-    // Render some simple text using colored rectangles
+void UIComponent::AppendDebugInfo() {
+    float windowHeight = static_cast<float>(m_windowHeight);
     
-    // Title text "MESH ENGINE" at the top
-    float titleY = m_windowHeight - 20;
+    // Colored rectangles as "buttons" to make sure something is visible
+    AppendRect(10.0f, windowHeight - 80, 130.0f, windowHeight - 50, glm::vec3(1.0f, 0.0f, 0.0f));
+    AppendRect(10.0f, windowHeight - 130, 130.0f, windowHeight - 100, glm::vec3(0.0f, 1.0f, 0.0f));
+    AppendRect(10.0f, windowHeight - 180, 130.0f, windowHeight - 150, glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+void UIComponent::SetProgress(float fraction, const std::string& label) {
+    int pixels = fraction < 0.0f ? -1 : static_cast<int>(std::min(fraction, 1.0f) * (m_panelWidth - 20));
+    if (pixels != m_progressPixels || label != m_progressLabel) {
+        m_geometryDirty = true;
+    }
+    m_progress = fraction;
+    m_progressPixels = pixels;
+    m_progressLabel = label;
+}
+
+void UIComponent::AppendProgress() {
+    if (m_progress < 0.0f) {
+        return;
+    }
     
-    // Letter "M" 
-    float letterM[] = {
-        // Position (x, y)    // Color (r, g, b) - black text
-        20.0f, titleY - 15, 0.0f, 0.0f, 0.0f,
-        25.0f, titleY - 15, 0.0f, 0.0f, 0.0f,
-        25.0f, titleY, 0.0f, 0.0f, 0.0f,
-        20.0f, titleY, 0.0f, 0.0f, 0.0f
-    };
+    float x0 = 10.0f;
+    float x1 = static_cast<float>(m_panelWidth) - 10.0f;
+    AppendRect(x0, 10.0f, x1, 24.0f, glm::vec3(0.85f));
+    AppendRect(x0, 10.0f, x0 + static_cast<float>(m_progressPixels), 24.0f, glm::vec3(0.3f, 0.6f, 0.9f));
+    AppendRectOutline(x0, 10.0f, x1, 24.0f, glm::vec3(0.5f));
+}
+
+void UIComponent::RenderLabels() {
+    if (!m_overlay) {
+        return;
+    }
     
-    glBindVertexArray(m_uiVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_uiVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(letterM), letterM, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    // Letter "E"
-    float letterE[] = {
-        30.0f, titleY - 15, 0.0f, 0.0f, 0.0f,
-        35.0f, titleY - 15, 0.0f, 0.0f, 0.0f,
-        35.0f, titleY, 0.0f, 0.0f, 0.0f,
-        30.0f, titleY, 0.0f, 0.0f, 0.0f
-    };
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(letterE), letterE, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    // Add some colored rectangles as "buttons" to make sure something is visible
-    
-    // Red rectangle button
-    float redButton[] = {
-        10.0f, m_windowHeight - 80, 1.0f, 0.0f, 0.0f,  // Red
-        130.0f, m_windowHeight - 80, 1.0f, 0.0f, 0.0f,
-        130.0f, m_windowHeight - 50, 1.0f, 0.0f, 0.0f,
-        10.0f, m_windowHeight - 50, 1.0f, 0.0f, 0.0f
-    };
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(redButton), redButton, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    // Green rectangle button  
-    float greenButton[] = {
-        10.0f, m_windowHeight - 130, 0.0f, 1.0f, 0.0f,  // Green
-        130.0f, m_windowHeight - 130, 0.0f, 1.0f, 0.0f,
-        130.0f, m_windowHeight - 100, 0.0f, 1.0f, 0.0f,
-        10.0f, m_windowHeight - 100, 0.0f, 1.0f, 0.0f
-    };
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(greenButton), greenButton, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    // Blue rectangle button
-    float blueButton[] = {
-        10.0f, m_windowHeight - 180, 0.0f, 0.0f, 1.0f,  // Blue
-        130.0f, m_windowHeight - 180, 0.0f, 0.0f, 1.0f,
-        130.0f, m_windowHeight - 150, 0.0f, 0.0f, 1.0f,
-        10.0f, m_windowHeight - 150, 0.0f, 0.0f, 1.0f
-    };
-    
-    glBufferData(GL_ARRAY_BUFFER, sizeof(blueButton), blueButton, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    
-    // Add some simple "text" using rectangles
-    // "POINT" label on red button
-    for (int i = 0; i < 5; i++) {
-        float textPixel[] = {
-            20.0f + i * 8, m_windowHeight - 75, 1.0f, 1.0f, 1.0f,  // White text
-            22.0f + i * 8, m_windowHeight - 75, 1.0f, 1.0f, 1.0f,
-            22.0f + i * 8, m_windowHeight - 70, 1.0f, 1.0f, 1.0f,
-            20.0f + i * 8, m_windowHeight - 70, 1.0f, 1.0f, 1.0f
-        };
-        
-        glBufferData(GL_ARRAY_BUFFER, sizeof(textPixel), textPixel, GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    // Title text at the top of the panel
+    RenderText("MESH ENGINE", 10.0f, m_windowHeight - 22.0f, 2.0f);
+    
+    // Button captions, vertically centred
+    const float scale = 2.0f;
+    for (const auto& button : m_buttons) {
+        glm::vec2 textSize = m_overlay->MeasureText(button.text, scale);
+        float textX = button.position.x + 10.0f;
+        float textY = button.position.y + (button.size.y - textSize.y) * 0.5f;
+        RenderText(button.text, textX, textY, scale);
     }
     
-    glBindVertexArray(0);
-} 
\ No newline at end of file
+    if (m_progress >= 0.0f) {
+        RenderText(m_progressLabel, 10.0f, 30.0f, 1.0f);
+    }
+}
+
+void UIComponent::RenderText(const std::string& text, float x, float y, float scale) {
+    // Queued into the overlay batch; drawn with the rest of the frame's text
+    if (m_overlay) {
+        m_overlay->AddText(text, x, y, scale, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+}
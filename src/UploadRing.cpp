@@ -0,0 +1,220 @@
+#include "UploadRing.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// Staging offsets are kept aligned for the memcpy into mapped memory
+constexpr size_t UploadAlignment = 16;
+
+size_t AlignUp(size_t value) {
+    return (value + UploadAlignment - 1) & ~(UploadAlignment - 1);
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool HasBufferStorage() {
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 4)) {
+        return true;
+    }
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; ++i) {
+        const GLubyte* name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+        if (name && std::strcmp(reinterpret_cast<const char*>(name), "GL_ARB_buffer_storage") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+UploadRing& UploadRing::Instance() {
+    static UploadRing instance;
+    return instance;
+}
+
+UploadRing::UploadRing()
+    : m_buffer(0)
+    , m_mapped(nullptr)
+    , m_persistent(false)
+    , m_initialized(false)
+    , m_failed(false)
+    , m_enabled(true)
+    , m_requestedRegionSize(DefaultRegionSize)
+    , m_regionSize(0)
+    , m_region(0)
+    , m_head(0)
+    , m_fences() {}
+
+bool UploadRing::Initialize() {
+    if (m_failed) {
+        return false;
+    }
+    m_regionSize = AlignUp(m_requestedRegionSize);
+    size_t totalSize = m_regionSize * FrameCount;
+
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+    if (HasBufferStorage()) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_READ_BUFFER, totalSize, nullptr, flags);
+        m_mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, totalSize, flags));
+        if (!m_mapped) {
+            // Immutable storage cannot be respecified; start over with a plain buffer
+            LOG_WARN("Persistent mapping failed; streaming uploads through glMapBufferRange");
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+        }
+    }
+    m_persistent = m_mapped != nullptr;
+    if (!m_persistent) {
+        glBufferData(GL_COPY_READ_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    m_region = 0;
+    m_head = 0;
+    m_initialized = true;
+    LOG_INFO("Upload ring: %d x %.1f MB, %s", FrameCount, m_regionSize / (1024.0 * 1024.0),
+             m_persistent ? "persistently mapped" : "mapped per upload");
+    return true;
+}
+
+void UploadRing::Upload(GLuint buffer, GLintptr offset, const void* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    PROFILE_SCOPE("UploadRing::Upload");
+    auto start = std::chrono::steady_clock::now();
+    double stalled = m_stats.stallSeconds;
+
+    bool staged = m_enabled && !m_failed && (m_initialized || Initialize()) && size <= m_regionSize - m_head;
+    if (staged && m_head == 0 && !WaitForRegion(m_region)) {
+        staged = false;
+    }
+    if (staged) {
+        size_t stagingOffset = m_region * m_regionSize + m_head;
+        glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+        if (m_persistent) {
+            std::memcpy(m_mapped + stagingOffset, data, size);
+        } else {
+            // The region is fenced, so nothing the GPU still reads is touched
+            GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+            void* mapped = glMapBufferRange(GL_COPY_READ_BUFFER, stagingOffset, size, access);
+            if (mapped) {
+                std::memcpy(mapped, data, size);
+                glUnmapBuffer(GL_COPY_READ_BUFFER);
+            } else {
+                LOG_WARN("Mapping the upload ring failed; falling back to glBufferSubData");
+                m_failed = true;
+                staged = false;
+            }
+        }
+        if (staged) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagingOffset, offset, size);
+            m_head += AlignUp(size);
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    if (!staged) {
+        UploadDirect(buffer, offset, data, size);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    ++m_stats.uploads;
+    m_stats.bytes += size;
+    m_stats.uploadSeconds += SecondsSince(start) - (m_stats.stallSeconds - stalled);
+}
+
+void UploadRing::UploadDirect(GLuint buffer, GLintptr offset, const void* data, size_t size) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    ++m_stats.directUploads;
+}
+
+bool UploadRing::WaitForRegion(int region) {
+    GLsync fence = m_fences[region];
+    if (!fence) {
+        return true;
+    }
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        if (!m_persistent) {
+            // Fresh storage is cheaper than waiting; the driver frees the old
+            // storage once the GPU is done with it
+            Orphan();
+            return true;
+        }
+        PROFILE_SCOPE("UploadRing::Stall");
+        auto start = std::chrono::steady_clock::now();
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        ++m_stats.stalls;
+        m_stats.stallSeconds += SecondsSince(start);
+    }
+    glDeleteSync(fence);
+    m_fences[region] = nullptr;
+    return status != GL_WAIT_FAILED;
+}
+
+void UploadRing::Orphan() {
+    glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+    glBufferData(GL_COPY_READ_BUFFER, m_regionSize * FrameCount, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    ++m_stats.orphans;
+}
+
+void UploadRing::EndFrame() {
+    ++m_stats.frames;
+    if (!m_initialized || m_head == 0) {
+        return;
+    }
+
+    // Copies from this region are queued; the fence marks when they are done
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_region = (m_region + 1) % FrameCount;
+    m_head = 0;
+}
+
+void UploadRing::Release() {
+    if (!m_initialized) {
+        m_failed = false;
+        return;
+    }
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_persistent) {
+        glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &m_buffer);
+    m_buffer = 0;
+    m_mapped = nullptr;
+    m_persistent = false;
+    m_initialized = false;
+    m_failed = false;
+}
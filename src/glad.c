@@ -51,6 +51,57 @@ typedef void (APIENTRYP PFNGLENABLEVERTEXATTRIBARRAYPROC) (GLuint index);
 typedef void (APIENTRYP PFNGLDRAWARRAYSPROC) (GLenum mode, GLint first, GLsizei count);
 typedef void (APIENTRYP PFNGLDELETEVERTEXARRAYSPROC) (GLsizei n, const GLuint* arrays);
 typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC) (GLsizei n, const GLuint* buffers);
+typedef void (APIENTRYP PFNGLBUFFERSUBDATAPROC) (GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+typedef void (APIENTRYP PFNGLDRAWARRAYSINSTANCEDPROC) (GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBDIVISORPROC) (GLuint index, GLuint divisor);
+typedef void (APIENTRYP PFNGLDRAWELEMENTSINSTANCEDPROC) (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+typedef void (APIENTRYP PFNGLGETACTIVEUNIFORMPROC) (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+typedef GLuint (APIENTRYP PFNGLGETUNIFORMBLOCKINDEXPROC) (GLuint program, const GLchar* uniformBlockName);
+typedef void (APIENTRYP PFNGLUNIFORMBLOCKBINDINGPROC) (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+typedef void (APIENTRYP PFNGLBINDBUFFERBASEPROC) (GLenum target, GLuint index, GLuint buffer);
+typedef void (APIENTRYP PFNGLGENTEXTURESPROC) (GLsizei n, GLuint* textures);
+typedef void (APIENTRYP PFNGLDELETETEXTURESPROC) (GLsizei n, const GLuint* textures);
+typedef void (APIENTRYP PFNGLBINDTEXTUREPROC) (GLenum target, GLuint texture);
+typedef void (APIENTRYP PFNGLACTIVETEXTUREPROC) (GLenum texture);
+typedef void (APIENTRYP PFNGLTEXIMAGE2DPROC) (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+typedef void (APIENTRYP PFNGLTEXPARAMETERIPROC) (GLenum target, GLenum pname, GLint param);
+typedef void (APIENTRYP PFNGLPIXELSTOREIPROC) (GLenum pname, GLint param);
+typedef void (APIENTRYP PFNGLGENFRAMEBUFFERSPROC) (GLsizei n, GLuint* framebuffers);
+typedef void (APIENTRYP PFNGLDELETEFRAMEBUFFERSPROC) (GLsizei n, const GLuint* framebuffers);
+typedef void (APIENTRYP PFNGLBINDFRAMEBUFFERPROC) (GLenum target, GLuint framebuffer);
+typedef void (APIENTRYP PFNGLFRAMEBUFFERTEXTURE2DPROC) (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+typedef void (APIENTRYP PFNGLFRAMEBUFFERRENDERBUFFERPROC) (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+typedef GLenum (APIENTRYP PFNGLCHECKFRAMEBUFFERSTATUSPROC) (GLenum target);
+typedef void (APIENTRYP PFNGLGENRENDERBUFFERSPROC) (GLsizei n, GLuint* renderbuffers);
+typedef void (APIENTRYP PFNGLDELETERENDERBUFFERSPROC) (GLsizei n, const GLuint* renderbuffers);
+typedef void (APIENTRYP PFNGLBINDRENDERBUFFERPROC) (GLenum target, GLuint renderbuffer);
+typedef void (APIENTRYP PFNGLRENDERBUFFERSTORAGEPROC) (GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRYP PFNGLCLEARBUFFERUIVPROC) (GLenum buffer, GLint drawbuffer, const GLuint* value);
+typedef void (APIENTRYP PFNGLCLEARBUFFERFVPROC) (GLenum buffer, GLint drawbuffer, const GLfloat* value);
+typedef void (APIENTRYP PFNGLREADPIXELSPROC) (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+typedef void (APIENTRYP PFNGLSCISSORPROC) (GLint x, GLint y, GLsizei width, GLsizei height);
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC) (GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC) (GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRYP PFNGLDELETESYNCPROC) (GLsync sync);
+typedef void (APIENTRYP PFNGLGETBUFFERSUBDATAPROC) (GLenum target, GLintptr offset, GLsizeiptr size, void* data);
+typedef void (APIENTRYP PFNGLFLUSHPROC) (void);
+typedef void (APIENTRYP PFNGLFINISHPROC) (void);
+typedef const GLubyte* (APIENTRYP PFNGLGETSTRINGPROC) (GLenum name);
+typedef void (APIENTRYP PFNGLGENQUERIESPROC) (GLsizei n, GLuint* ids);
+typedef void (APIENTRYP PFNGLDELETEQUERIESPROC) (GLsizei n, const GLuint* ids);
+typedef void (APIENTRYP PFNGLQUERYCOUNTERPROC) (GLuint id, GLenum target);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTIVPROC) (GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTUI64VPROC) (GLuint id, GLenum pname, GLuint64* params);
+typedef void (APIENTRYP PFNGLGETINTEGER64VPROC) (GLenum pname, GLint64* data);
+typedef void (APIENTRYP PFNGLDRAWELEMENTSPROC) (GLenum mode, GLsizei count, GLenum type, const void* indices);
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+typedef void* (APIENTRYP PFNGLMAPBUFFERRANGEPROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRYP PFNGLUNMAPBUFFERPROC) (GLenum target);
+typedef void (APIENTRYP PFNGLCOPYBUFFERSUBDATAPROC) (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+typedef const GLubyte* (APIENTRYP PFNGLGETSTRINGIPROC) (GLenum name, GLuint index);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSPROC) (GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBIPOINTERPROC) (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer);
+typedef GLboolean (APIENTRYP PFNGLISENABLEDPROC) (GLenum cap);
 
 /* GLAD function pointers */
 static void* (*glad_glGetProcAddress)(const char* name) = NULL;
@@ -94,6 +145,76 @@ static PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray = NULL;
 static PFNGLDRAWARRAYSPROC glad_glDrawArrays = NULL;
 static PFNGLDELETEVERTEXARRAYSPROC glad_glDeleteVertexArrays = NULL;
 static PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers = NULL;
+static PFNGLBUFFERSUBDATAPROC glad_glBufferSubData = NULL;
+static PFNGLDRAWARRAYSINSTANCEDPROC glad_glDrawArraysInstanced = NULL;
+static PFNGLVERTEXATTRIBDIVISORPROC glad_glVertexAttribDivisor = NULL;
+static PFNGLDRAWELEMENTSINSTANCEDPROC glad_glDrawElementsInstanced = NULL;
+static PFNGLGETACTIVEUNIFORMPROC glad_glGetActiveUniform = NULL;
+static PFNGLGETUNIFORMBLOCKINDEXPROC glad_glGetUniformBlockIndex = NULL;
+static PFNGLUNIFORMBLOCKBINDINGPROC glad_glUniformBlockBinding = NULL;
+static PFNGLBINDBUFFERBASEPROC glad_glBindBufferBase = NULL;
+static PFNGLGENTEXTURESPROC glad_glGenTextures = NULL;
+static PFNGLDELETETEXTURESPROC glad_glDeleteTextures = NULL;
+static PFNGLBINDTEXTUREPROC glad_glBindTexture = NULL;
+static PFNGLACTIVETEXTUREPROC glad_glActiveTexture = NULL;
+static PFNGLTEXIMAGE2DPROC glad_glTexImage2D = NULL;
+static PFNGLTEXPARAMETERIPROC glad_glTexParameteri = NULL;
+static PFNGLPIXELSTOREIPROC glad_glPixelStorei = NULL;
+static PFNGLGENFRAMEBUFFERSPROC glad_glGenFramebuffers = NULL;
+static PFNGLDELETEFRAMEBUFFERSPROC glad_glDeleteFramebuffers = NULL;
+static PFNGLBINDFRAMEBUFFERPROC glad_glBindFramebuffer = NULL;
+static PFNGLFRAMEBUFFERTEXTURE2DPROC glad_glFramebufferTexture2D = NULL;
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC glad_glFramebufferRenderbuffer = NULL;
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC glad_glCheckFramebufferStatus = NULL;
+static PFNGLGENRENDERBUFFERSPROC glad_glGenRenderbuffers = NULL;
+static PFNGLDELETERENDERBUFFERSPROC glad_glDeleteRenderbuffers = NULL;
+static PFNGLBINDRENDERBUFFERPROC glad_glBindRenderbuffer = NULL;
+static PFNGLRENDERBUFFERSTORAGEPROC glad_glRenderbufferStorage = NULL;
+static PFNGLCLEARBUFFERUIVPROC glad_glClearBufferuiv = NULL;
+static PFNGLCLEARBUFFERFVPROC glad_glClearBufferfv = NULL;
+static PFNGLREADPIXELSPROC glad_glReadPixels = NULL;
+static PFNGLSCISSORPROC glad_glScissor = NULL;
+static PFNGLFENCESYNCPROC glad_glFenceSync = NULL;
+static PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync = NULL;
+static PFNGLDELETESYNCPROC glad_glDeleteSync = NULL;
+static PFNGLGETBUFFERSUBDATAPROC glad_glGetBufferSubData = NULL;
+static PFNGLFLUSHPROC glad_glFlush = NULL;
+static PFNGLFINISHPROC glad_glFinish = NULL;
+static PFNGLGETSTRINGPROC glad_glGetString = NULL;
+static PFNGLGENQUERIESPROC glad_glGenQueries = NULL;
+static PFNGLDELETEQUERIESPROC glad_glDeleteQueries = NULL;
+static PFNGLQUERYCOUNTERPROC glad_glQueryCounter = NULL;
+static PFNGLGETQUERYOBJECTIVPROC glad_glGetQueryObjectiv = NULL;
+static PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v = NULL;
+static PFNGLGETINTEGER64VPROC glad_glGetInteger64v = NULL;
+static PFNGLDRAWELEMENTSPROC glad_glDrawElements = NULL;
+static PFNGLBUFFERSTORAGEPROC glad_glBufferStorage = NULL;
+static PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange = NULL;
+static PFNGLUNMAPBUFFERPROC glad_glUnmapBuffer = NULL;
+static PFNGLCOPYBUFFERSUBDATAPROC glad_glCopyBufferSubData = NULL;
+static PFNGLGETSTRINGIPROC glad_glGetStringi = NULL;
+static PFNGLMULTIDRAWELEMENTSPROC glad_glMultiDrawElements = NULL;
+static PFNGLVERTEXATTRIBIPOINTERPROC glad_glVertexAttribIPointer = NULL;
+static PFNGLISENABLEDPROC glad_glIsEnabled = NULL;
+
+/* Call counters, bumped by every wrapper; only compiled into builds that
+   define MESHENGINE_GL_CALL_COUNTS (bench_scene), so shipping wrappers
+   stay plain forwarders */
+#ifdef MESHENGINE_GL_CALL_COUNTS
+static GladCallCounts glad_call_counts;
+#define GLAD_COUNT(counter) (++glad_call_counts.counter)
+
+GladCallCounts gladGetCallCounts(void) {
+    return glad_call_counts;
+}
+
+void gladResetCallCounts(void) {
+    GladCallCounts empty = {0, 0, 0, 0};
+    glad_call_counts = empty;
+}
+#else
+#define GLAD_COUNT(counter) ((void)0)
+#endif
 
 /* GLAD loader function */
 int gladLoadGL(void* (*load)(const char*)) {
@@ -138,36 +259,94 @@ int gladLoadGL(void* (*load)(const char*)) {
     glad_glDrawArrays = (PFNGLDRAWARRAYSPROC)load("glDrawArrays");
     glad_glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)load("glDeleteVertexArrays");
     glad_glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)load("glDeleteBuffers");
+    glad_glBufferSubData = (PFNGLBUFFERSUBDATAPROC)load("glBufferSubData");
+    glad_glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)load("glDrawArraysInstanced");
+    glad_glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)load("glVertexAttribDivisor");
+    glad_glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)load("glDrawElementsInstanced");
+    glad_glGetActiveUniform = (PFNGLGETACTIVEUNIFORMPROC)load("glGetActiveUniform");
+    glad_glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)load("glGetUniformBlockIndex");
+    glad_glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)load("glUniformBlockBinding");
+    glad_glBindBufferBase = (PFNGLBINDBUFFERBASEPROC)load("glBindBufferBase");
+    glad_glGenTextures = (PFNGLGENTEXTURESPROC)load("glGenTextures");
+    glad_glDeleteTextures = (PFNGLDELETETEXTURESPROC)load("glDeleteTextures");
+    glad_glBindTexture = (PFNGLBINDTEXTUREPROC)load("glBindTexture");
+    glad_glActiveTexture = (PFNGLACTIVETEXTUREPROC)load("glActiveTexture");
+    glad_glTexImage2D = (PFNGLTEXIMAGE2DPROC)load("glTexImage2D");
+    glad_glTexParameteri = (PFNGLTEXPARAMETERIPROC)load("glTexParameteri");
+    glad_glPixelStorei = (PFNGLPIXELSTOREIPROC)load("glPixelStorei");
+    glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)load("glGenFramebuffers");
+    glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)load("glDeleteFramebuffers");
+    glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)load("glBindFramebuffer");
+    glad_glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)load("glFramebufferTexture2D");
+    glad_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)load("glFramebufferRenderbuffer");
+    glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)load("glCheckFramebufferStatus");
+    glad_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)load("glGenRenderbuffers");
+    glad_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)load("glDeleteRenderbuffers");
+    glad_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)load("glBindRenderbuffer");
+    glad_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)load("glRenderbufferStorage");
+    glad_glClearBufferuiv = (PFNGLCLEARBUFFERUIVPROC)load("glClearBufferuiv");
+    glad_glClearBufferfv = (PFNGLCLEARBUFFERFVPROC)load("glClearBufferfv");
+    glad_glReadPixels = (PFNGLREADPIXELSPROC)load("glReadPixels");
+    glad_glScissor = (PFNGLSCISSORPROC)load("glScissor");
+    glad_glFenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+    glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+    glad_glDeleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+    glad_glGetBufferSubData = (PFNGLGETBUFFERSUBDATAPROC)load("glGetBufferSubData");
+    glad_glFlush = (PFNGLFLUSHPROC)load("glFlush");
+    glad_glFinish = (PFNGLFINISHPROC)load("glFinish");
+    glad_glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
+    glad_glGenQueries = (PFNGLGENQUERIESPROC)load("glGenQueries");
+    glad_glDeleteQueries = (PFNGLDELETEQUERIESPROC)load("glDeleteQueries");
+    glad_glQueryCounter = (PFNGLQUERYCOUNTERPROC)load("glQueryCounter");
+    glad_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load("glGetQueryObjectiv");
+    glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
+    glad_glGetInteger64v = (PFNGLGETINTEGER64VPROC)load("glGetInteger64v");
+    glad_glDrawElements = (PFNGLDRAWELEMENTSPROC)load("glDrawElements");
+    glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+    glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+    glad_glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)load("glUnmapBuffer");
+    glad_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)load("glCopyBufferSubData");
+    glad_glGetStringi = (PFNGLGETSTRINGIPROC)load("glGetStringi");
+    glad_glMultiDrawElements = (PFNGLMULTIDRAWELEMENTSPROC)load("glMultiDrawElements");
+    glad_glVertexAttribIPointer = (PFNGLVERTEXATTRIBIPOINTERPROC)load("glVertexAttribIPointer");
+    glad_glIsEnabled = (PFNGLISENABLEDPROC)load("glIsEnabled");
     
     return 1; // Success
 }
 
 /* OpenGL function implementations */
 void glClear(GLbitfield mask) {
+    GLAD_COUNT(total);
     if (glad_glClear) glad_glClear(mask);
 }
 
 void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    GLAD_COUNT(total);
     if (glad_glClearColor) glad_glClearColor(red, green, blue, alpha);
 }
 
 void glEnable(GLenum cap) {
+    GLAD_COUNT(total);
     if (glad_glEnable) glad_glEnable(cap);
 }
 
 void glDisable(GLenum cap) {
+    GLAD_COUNT(total);
     if (glad_glDisable) glad_glDisable(cap);
 }
 
 void glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    GLAD_COUNT(total);
     if (glad_glBlendFunc) glad_glBlendFunc(sfactor, dfactor);
 }
 
 void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    GLAD_COUNT(total);
     if (glad_glViewport) glad_glViewport(x, y, width, height);
 }
 
 void glGetIntegerv(GLenum pname, GLint* params) {
+    GLAD_COUNT(total);
     if (glad_glGetIntegerv) glad_glGetIntegerv(pname, params);
 }
 
@@ -175,124 +354,430 @@ void glGetIntegerv(GLenum pname, GLint* params) {
 // These functions are not needed for modern OpenGL 3.3 rendering
 
 GLuint glCreateShader(GLenum type) {
+    GLAD_COUNT(total);
     if (glad_glCreateShader) return glad_glCreateShader(type);
     return 0;
 }
 
 void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+    GLAD_COUNT(total);
     if (glad_glShaderSource) glad_glShaderSource(shader, count, string, length);
 }
 
 void glCompileShader(GLuint shader) {
+    GLAD_COUNT(total);
     if (glad_glCompileShader) glad_glCompileShader(shader);
 }
 
 void glGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    GLAD_COUNT(total);
     if (glad_glGetShaderiv) glad_glGetShaderiv(shader, pname, params);
 }
 
 void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    GLAD_COUNT(total);
     if (glad_glGetShaderInfoLog) glad_glGetShaderInfoLog(shader, bufSize, length, infoLog);
 }
 
 void glDeleteShader(GLuint shader) {
+    GLAD_COUNT(total);
     if (glad_glDeleteShader) glad_glDeleteShader(shader);
 }
 
 GLuint glCreateProgram(void) {
+    GLAD_COUNT(total);
     if (glad_glCreateProgram) return glad_glCreateProgram();
     return 0;
 }
 
 void glAttachShader(GLuint program, GLuint shader) {
+    GLAD_COUNT(total);
     if (glad_glAttachShader) glad_glAttachShader(program, shader);
 }
 
 void glLinkProgram(GLuint program) {
+    GLAD_COUNT(total);
     if (glad_glLinkProgram) glad_glLinkProgram(program);
 }
 
 void glGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+    GLAD_COUNT(total);
     if (glad_glGetProgramiv) glad_glGetProgramiv(program, pname, params);
 }
 
 void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    GLAD_COUNT(total);
     if (glad_glGetProgramInfoLog) glad_glGetProgramInfoLog(program, bufSize, length, infoLog);
 }
 
 void glDeleteProgram(GLuint program) {
+    GLAD_COUNT(total);
     if (glad_glDeleteProgram) glad_glDeleteProgram(program);
 }
 
 void glUseProgram(GLuint program) {
+    GLAD_COUNT(total);
     if (glad_glUseProgram) glad_glUseProgram(program);
 }
 
 GLint glGetUniformLocation(GLuint program, const GLchar* name) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformLookups);
     if (glad_glGetUniformLocation) return glad_glGetUniformLocation(program, name);
     return -1;
 }
 
 void glUniform1i(GLint location, GLint v0) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformSets);
     if (glad_glUniform1i) glad_glUniform1i(location, v0);
 }
 
 void glUniform1f(GLint location, GLfloat v0) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformSets);
     if (glad_glUniform1f) glad_glUniform1f(location, v0);
 }
 
 void glUniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformSets);
     if (glad_glUniform2fv) glad_glUniform2fv(location, count, value);
 }
 
 void glUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformSets);
     if (glad_glUniform3fv) glad_glUniform3fv(location, count, value);
 }
 
 void glUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformSets);
     if (glad_glUniform4fv) glad_glUniform4fv(location, count, value);
 }
 
 void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(uniformSets);
     if (glad_glUniformMatrix4fv) glad_glUniformMatrix4fv(location, count, transpose, value);
 }
 
 void glGenVertexArrays(GLsizei n, GLuint* arrays) {
+    GLAD_COUNT(total);
     if (glad_glGenVertexArrays) glad_glGenVertexArrays(n, arrays);
 }
 
 void glBindVertexArray(GLuint array) {
+    GLAD_COUNT(total);
     if (glad_glBindVertexArray) glad_glBindVertexArray(array);
 }
 
 void glGenBuffers(GLsizei n, GLuint* buffers) {
+    GLAD_COUNT(total);
     if (glad_glGenBuffers) glad_glGenBuffers(n, buffers);
 }
 
 void glBindBuffer(GLenum target, GLuint buffer) {
+    GLAD_COUNT(total);
     if (glad_glBindBuffer) glad_glBindBuffer(target, buffer);
 }
 
 void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    GLAD_COUNT(total);
     if (glad_glBufferData) glad_glBufferData(target, size, data, usage);
 }
 
 void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+    GLAD_COUNT(total);
     if (glad_glVertexAttribPointer) glad_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
 }
 
 void glEnableVertexAttribArray(GLuint index) {
+    GLAD_COUNT(total);
     if (glad_glEnableVertexAttribArray) glad_glEnableVertexAttribArray(index);
 }
 
 void glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(draws);
     if (glad_glDrawArrays) glad_glDrawArrays(mode, first, count);
 }
 
 void glDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    GLAD_COUNT(total);
     if (glad_glDeleteVertexArrays) glad_glDeleteVertexArrays(n, arrays);
 }
 
 void glDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    GLAD_COUNT(total);
     if (glad_glDeleteBuffers) glad_glDeleteBuffers(n, buffers);
-} 
\ No newline at end of file
+} 
+
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    GLAD_COUNT(total);
+    if (glad_glBufferSubData) glad_glBufferSubData(target, offset, size, data);
+}
+
+void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(draws);
+    if (glad_glDrawArraysInstanced) glad_glDrawArraysInstanced(mode, first, count, instancecount);
+}
+
+void glVertexAttribDivisor(GLuint index, GLuint divisor) {
+    GLAD_COUNT(total);
+    if (glad_glVertexAttribDivisor) glad_glVertexAttribDivisor(index, divisor);
+}
+
+void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(draws);
+    if (glad_glDrawElementsInstanced) glad_glDrawElementsInstanced(mode, count, type, indices, instancecount);
+}
+
+void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+    GLAD_COUNT(total);
+    if (glad_glGetActiveUniform) glad_glGetActiveUniform(program, index, bufSize, length, size, type, name);
+}
+
+GLuint glGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName) {
+    GLAD_COUNT(total);
+    if (glad_glGetUniformBlockIndex) return glad_glGetUniformBlockIndex(program, uniformBlockName);
+    return GL_INVALID_INDEX;
+}
+
+void glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) {
+    GLAD_COUNT(total);
+    if (glad_glUniformBlockBinding) glad_glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+}
+
+void glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    GLAD_COUNT(total);
+    if (glad_glBindBufferBase) glad_glBindBufferBase(target, index, buffer);
+}
+
+void glGenTextures(GLsizei n, GLuint* textures) {
+    GLAD_COUNT(total);
+    if (glad_glGenTextures) glad_glGenTextures(n, textures);
+}
+
+void glDeleteTextures(GLsizei n, const GLuint* textures) {
+    GLAD_COUNT(total);
+    if (glad_glDeleteTextures) glad_glDeleteTextures(n, textures);
+}
+
+void glBindTexture(GLenum target, GLuint texture) {
+    GLAD_COUNT(total);
+    if (glad_glBindTexture) glad_glBindTexture(target, texture);
+}
+
+void glActiveTexture(GLenum texture) {
+    GLAD_COUNT(total);
+    if (glad_glActiveTexture) glad_glActiveTexture(texture);
+}
+
+void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+    GLAD_COUNT(total);
+    if (glad_glTexImage2D) glad_glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+void glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    GLAD_COUNT(total);
+    if (glad_glTexParameteri) glad_glTexParameteri(target, pname, param);
+}
+
+void glPixelStorei(GLenum pname, GLint param) {
+    GLAD_COUNT(total);
+    if (glad_glPixelStorei) glad_glPixelStorei(pname, param);
+}
+
+void glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    GLAD_COUNT(total);
+    if (glad_glGenFramebuffers) glad_glGenFramebuffers(n, framebuffers);
+}
+
+void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    GLAD_COUNT(total);
+    if (glad_glDeleteFramebuffers) glad_glDeleteFramebuffers(n, framebuffers);
+}
+
+void glBindFramebuffer(GLenum target, GLuint framebuffer) {
+    GLAD_COUNT(total);
+    if (glad_glBindFramebuffer) glad_glBindFramebuffer(target, framebuffer);
+}
+
+void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+    GLAD_COUNT(total);
+    if (glad_glFramebufferTexture2D) glad_glFramebufferTexture2D(target, attachment, textarget, texture, level);
+}
+
+void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+    GLAD_COUNT(total);
+    if (glad_glFramebufferRenderbuffer) glad_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+
+GLenum glCheckFramebufferStatus(GLenum target) {
+    GLAD_COUNT(total);
+    if (glad_glCheckFramebufferStatus) return glad_glCheckFramebufferStatus(target);
+    return 0;
+}
+
+void glGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+    GLAD_COUNT(total);
+    if (glad_glGenRenderbuffers) glad_glGenRenderbuffers(n, renderbuffers);
+}
+
+void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+    GLAD_COUNT(total);
+    if (glad_glDeleteRenderbuffers) glad_glDeleteRenderbuffers(n, renderbuffers);
+}
+
+void glBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    GLAD_COUNT(total);
+    if (glad_glBindRenderbuffer) glad_glBindRenderbuffer(target, renderbuffer);
+}
+
+void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+    GLAD_COUNT(total);
+    if (glad_glRenderbufferStorage) glad_glRenderbufferStorage(target, internalformat, width, height);
+}
+
+void glClearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint* value) {
+    GLAD_COUNT(total);
+    if (glad_glClearBufferuiv) glad_glClearBufferuiv(buffer, drawbuffer, value);
+}
+
+void glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* value) {
+    GLAD_COUNT(total);
+    if (glad_glClearBufferfv) glad_glClearBufferfv(buffer, drawbuffer, value);
+}
+
+void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels) {
+    GLAD_COUNT(total);
+    if (glad_glReadPixels) glad_glReadPixels(x, y, width, height, format, type, pixels);
+}
+
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    GLAD_COUNT(total);
+    if (glad_glScissor) glad_glScissor(x, y, width, height);
+}
+
+GLsync glFenceSync(GLenum condition, GLbitfield flags) {
+    GLAD_COUNT(total);
+    if (glad_glFenceSync) return glad_glFenceSync(condition, flags);
+    return NULL;
+}
+
+GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+    GLAD_COUNT(total);
+    if (glad_glClientWaitSync) return glad_glClientWaitSync(sync, flags, timeout);
+    return GL_WAIT_FAILED;
+}
+
+void glDeleteSync(GLsync sync) {
+    GLAD_COUNT(total);
+    if (glad_glDeleteSync) glad_glDeleteSync(sync);
+}
+
+void glGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void* data) {
+    GLAD_COUNT(total);
+    if (glad_glGetBufferSubData) glad_glGetBufferSubData(target, offset, size, data);
+}
+
+void glFlush(void) {
+    GLAD_COUNT(total);
+    if (glad_glFlush) glad_glFlush();
+}
+
+void glFinish(void) {
+    GLAD_COUNT(total);
+    if (glad_glFinish) glad_glFinish();
+}
+
+const GLubyte* glGetString(GLenum name) {
+    GLAD_COUNT(total);
+    if (glad_glGetString) return glad_glGetString(name);
+    return 0;
+}
+
+void glGenQueries(GLsizei n, GLuint* ids) {
+    GLAD_COUNT(total);
+    if (glad_glGenQueries) glad_glGenQueries(n, ids);
+}
+
+void glDeleteQueries(GLsizei n, const GLuint* ids) {
+    GLAD_COUNT(total);
+    if (glad_glDeleteQueries) glad_glDeleteQueries(n, ids);
+}
+
+void glQueryCounter(GLuint id, GLenum target) {
+    GLAD_COUNT(total);
+    if (glad_glQueryCounter) glad_glQueryCounter(id, target);
+}
+
+void glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
+    GLAD_COUNT(total);
+    if (glad_glGetQueryObjectiv) glad_glGetQueryObjectiv(id, pname, params);
+}
+
+void glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+    GLAD_COUNT(total);
+    if (glad_glGetQueryObjectui64v) glad_glGetQueryObjectui64v(id, pname, params);
+}
+
+void glGetInteger64v(GLenum pname, GLint64* data) {
+    GLAD_COUNT(total);
+    if (glad_glGetInteger64v) glad_glGetInteger64v(pname, data);
+}
+
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(draws);
+    if (glad_glDrawElements) glad_glDrawElements(mode, count, type, indices);
+}
+
+void glBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+    GLAD_COUNT(total);
+    if (glad_glBufferStorage) glad_glBufferStorage(target, size, data, flags);
+}
+
+void* glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    GLAD_COUNT(total);
+    if (glad_glMapBufferRange) return glad_glMapBufferRange(target, offset, length, access);
+    return NULL;
+}
+
+GLboolean glUnmapBuffer(GLenum target) {
+    GLAD_COUNT(total);
+    if (glad_glUnmapBuffer) return glad_glUnmapBuffer(target);
+    return GL_FALSE;
+}
+
+void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) {
+    GLAD_COUNT(total);
+    if (glad_glCopyBufferSubData) glad_glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+}
+
+const GLubyte* glGetStringi(GLenum name, GLuint index) {
+    GLAD_COUNT(total);
+    if (glad_glGetStringi) return glad_glGetStringi(name, index);
+    return 0;
+}
+
+void glMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount) {
+    GLAD_COUNT(total);
+    GLAD_COUNT(draws);
+    if (glad_glMultiDrawElements) glad_glMultiDrawElements(mode, count, type, indices, drawcount);
+}
+
+void glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer) {
+    GLAD_COUNT(total);
+    if (glad_glVertexAttribIPointer) glad_glVertexAttribIPointer(index, size, type, stride, pointer);
+}
+
+GLboolean glIsEnabled(GLenum cap) {
+    GLAD_COUNT(total);
+    if (glad_glIsEnabled) return glad_glIsEnabled(cap);
+    return GL_FALSE;
+}
\ No newline at end of file
@@ -1,11 +1,141 @@
 #include "Application.h"
-#include <iostream>
+#include "HeadlessRenderer.h"
+#include "Log.h"
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
 
-int main() {
+// Usage goes straight to the stream rather than through the logger, so it
+// has no level prefix and still prints when logging is compiled out
+static void PrintUsage(FILE* out, const char* program) {
+    std::fprintf(out, "Usage: %s [--vsync | --fps <n> | --on-demand] [--gpu-picking]\n", program);
+    std::fprintf(out, "  --vsync      render continuously, paced by the display\n");
+    std::fprintf(out, "  --fps <n>    render continuously at a fixed target frame rate\n");
+    std::fprintf(out, "  --on-demand  render only when the scene, camera or UI changes (default)\n");
+    std::fprintf(out, "  --gpu-picking  find the hovered point or line with an ID-buffer pass\n");
+    std::fprintf(out, "  --trace <file>  write a Chrome trace of profiled frames on exit (F3 shows the frame graph)\n");
+    std::fprintf(out, "  --scene <file>  open a scene file, or create it on the first Ctrl+S\n");
+    std::fprintf(out, "  --import <file>  load a .ply, .obj or .xyz file in the background (Escape cancels)\n");
+    std::fprintf(out, "Headless benchmark: %s --headless [options]\n", program);
+    std::fprintf(out, "  --frames <n>      measured frames along one camera orbit (default 600)\n");
+    std::fprintf(out, "  --warmup <n>      unmeasured frames rendered first (default 30)\n");
+    std::fprintf(out, "  --size <w>x<h>    offscreen framebuffer size (default 1280x720)\n");
+    std::fprintf(out, "  --points <n>      synthetic points (default 10000)\n");
+    std::fprintf(out, "  --lines <n>       synthetic lines between random point pairs (default 10000)\n");
+    std::fprintf(out, "  --triangles <n>   synthetic terrain mesh of about n triangles (default 0)\n");
+    std::fprintf(out, "  --scene <file>    render a scene file instead of the synthetic scene\n");
+    std::fprintf(out, "  --import <file>   render a .ply, .obj or .xyz file (added to --scene if given)\n");
+    std::fprintf(out, "  --churn <n>       move n points every measured frame (default 0)\n");
+    std::fprintf(out, "  --upload <path>   ring (default) or direct: how dynamic buffers are updated\n");
+    std::fprintf(out, "  --point-lod <m>   on (default) or off: level-of-detail point rendering\n");
+    std::fprintf(out, "  --pick-check      hover known points and lines through GPU picking; exit 1 on a miss\n");
+    std::fprintf(out, "  --stats <file>    write frame-time statistics as JSON\n");
+    std::fprintf(out, "  --png-dir <dir>   dump frames as PNG into an existing directory\n");
+    std::fprintf(out, "  --png-every <n>   dump every nth measured frame (default 60)\n");
+    std::fprintf(out, "  --trace <file>    also write a Chrome trace of the measured frames\n");
+}
+
+static int RunHeadless(const HeadlessOptions& options) {
+    HeadlessRenderer renderer(options);
+    if (!renderer.Initialize()) {
+        LOG_ERROR("Failed to initialize headless renderer");
+        return -1;
+    }
+    
+    bool ok = renderer.Run();
+    renderer.Shutdown();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    FramePacing pacing = FramePacing::OnDemand;
+    int targetFps = 60;
+    HoverPicking hoverPicking = HoverPicking::Cpu;
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+    std::string tracePath;
+    std::string scenePath;
+    std::string importPath;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--vsync") == 0) {
+            pacing = FramePacing::VSync;
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            pacing = FramePacing::FixedFps;
+            targetFps = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--on-demand") == 0) {
+            pacing = FramePacing::OnDemand;
+        } else if (std::strcmp(argv[i], "--gpu-picking") == 0) {
+            hoverPicking = HoverPicking::Gpu;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            scenePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--import") == 0 && i + 1 < argc) {
+            importPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headlessOptions.frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            headlessOptions.warmupFrames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc &&
+                   std::sscanf(argv[i + 1], "%dx%d", &headlessOptions.width, &headlessOptions.height) == 2) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+            headlessOptions.pointCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--lines") == 0 && i + 1 < argc) {
+            headlessOptions.lineCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--triangles") == 0 && i + 1 < argc) {
+            headlessOptions.triangleCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--churn") == 0 && i + 1 < argc) {
+            headlessOptions.churnPoints = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--upload") == 0 && i + 1 < argc &&
+                   (std::strcmp(argv[i + 1], "ring") == 0 || std::strcmp(argv[i + 1], "direct") == 0)) {
+            headlessOptions.uploadRing = std::strcmp(argv[++i], "ring") == 0;
+        } else if (std::strcmp(argv[i], "--point-lod") == 0 && i + 1 < argc &&
+                   (std::strcmp(argv[i + 1], "on") == 0 || std::strcmp(argv[i + 1], "off") == 0)) {
+            headlessOptions.pointLod = std::strcmp(argv[++i], "on") == 0;
+        } else if (std::strcmp(argv[i], "--pick-check") == 0) {
+            headlessOptions.pickCheck = true;
+        } else if (std::strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+            headlessOptions.statsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--png-dir") == 0 && i + 1 < argc) {
+            headlessOptions.pngDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--png-every") == 0 && i + 1 < argc) {
+            headlessOptions.pngInterval = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            PrintUsage(stdout, argv[0]);
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            PrintUsage(stderr, argv[0]);
+            return -1;
+        }
+    }
+    
+    if (headless) {
+        headlessOptions.tracePath = tracePath;
+        headlessOptions.scenePath = scenePath;
+        headlessOptions.importPath = importPath;
+        return RunHeadless(headlessOptions);
+    }
+    
     Application app(1200, 800, "MeshEngine - 3D Point & Line Editor");
+    app.SetFramePacing(pacing, targetFps);
+    app.SetHoverPicking(hoverPicking);
+    if (!tracePath.empty()) {
+        app.SetTraceOutput(tracePath);
+    }
+    if (!scenePath.empty()) {
+        app.SetScenePath(scenePath);
+    }
+    if (!importPath.empty()) {
+        app.SetImportPath(importPath);
+    }
     
     if (!app.Initialize()) {
-        std::cerr << "Failed to initialize application" << std::endl;
+        LOG_ERROR("Failed to initialize application");
         return -1;
     }
     
@@ -13,4 +143,4 @@ int main() {
     app.Shutdown();
     
     return 0;
-} 
\ No newline at end of file
+} 